@@ -6,7 +6,16 @@
  *
  *   This module implements a simple register map and a state machine to process
  *   incoming IC bytes. The first byte received is interpreted as the register
- *   index, and the following byte is written to that register.
+ *   index, and the following byte is written to that register; the writes of
+ *   one transaction are staged and committed together on STOP. Access rights,
+ *   reset values, accepted ranges and side effects of every register come from
+ *   a constant descriptor table indexed by the register number. Master reads are
+ *   served from the current index, which auto-increments after every byte, as
+ *   one block transmitted by eDMA.
+ *   Optional SMBus packet error checking (CRC-8) guards both directions.
+ *   Acquired values are double-buffered: the main loop publishes a complete
+ *   frame after each acquisition cycle and every IC read transaction is served
+ *   from one coherent frame, without masking interrupts.
  *
  *   This software is provided free of charge.
  *
@@ -21,137 +30,1269 @@
 /*==============================================================================
                         LOCAL SYMBOLIC CONSTANTS
 ==============================================================================*/
-// (None required for this module)
+/** \brief Number of published register frames (double buffer). */
+#define NUM_FRAMES 2U
+
+/** \brief Capacity of the GPIO edge queue, in records (power of two). */
+#define EDGE_QUEUE_LEN 64U
+
+/** \brief Largest number of register writes staged by one IC transaction. */
+#define WRITE_STAGE_LEN 16U
+
+/** \brief Largest number of edge records returned by one read transaction. */
+#define EDGE_BLOCK_RECORDS 16U
+
+/**
+ * \brief Compiler barrier: memory accesses are not moved across it.
+ *
+ * \details g_commitCount is volatile but g_registers is not, so this keeps the
+ *          register accesses between the commit count accesses. The IC ISR
+ *          and the main loop run on the same core, so no hardware barrier is
+ *          needed.
+ */
+#define REG_COMPILER_BARRIER()   __asm volatile ("" ::: "memory")
+
+/** \brief Largest block served by one read transaction, before the PEC byte. */
+#define READ_BLOCK_MAX NUM_REGISTERS
+
+#if ((EDGE_BLOCK_RECORDS * REG_EDGE_RECORD_LEN) > READ_BLOCK_MAX) || (REG_STATUS_LEN > READ_BLOCK_MAX)
+#error "READ_BLOCK_MAX must cover every block served to the master"
+#endif
 
 /*==============================================================================
                            LOCAL TYPES (typedef, enum, struct)
 ==============================================================================*/
-// (No additional local types required)
+/**
+ * \brief Master access rights of a register.
+ */
+typedef enum
+{
+    REG_ACCESS_RO = 0,   /**< Read-only, master writes are ignored (default). */
+    REG_ACCESS_RW,       /**< Read/write, values outside the accepted range are ignored. */
+    REG_ACCESS_W1C,      /**< Read, write 1 to clear (handled by the write hook). */
+    REG_ACCESS_WO        /**< Write-only alias, reads 0 (handled by the write hook). */
+} register_access_t;
+
+/**
+ * \brief Read hook: returns the live value of a register.
+ */
+typedef uint8_t (*register_read_hook_t)(uint8_t regIndex);
+
+/**
+ * \brief Write hook: applies a master write accepted by the descriptor.
+ */
+typedef void (*register_write_hook_t)(uint8_t regIndex, uint8_t value);
+
+/**
+ * \brief Descriptor of one 8-bit register.
+ *
+ * \details A register with a read hook is read live, both by registers_read()
+ *          and when a read frame is latched; otherwise RW registers are read from
+ *          the live map (where WO registers stay 0) and RO registers from the
+ *          published frame. A written
+ *          value in [minValue, maxValue] is passed to the write hook if there is
+ *          one, else stored in the live map and the write counter, if any, is
+ *          incremented. With PEC, a read starting at the register has the
+ *          fixed length readLength (SMBus Read Byte, Read Word or block read).
+ */
+typedef struct
+{
+    register_access_t access;          /**< Master access rights. */
+    uint8_t resetValue;                /**< Value set by registers_init(). */
+    uint8_t minValue;                  /**< Smallest value accepted on write. */
+    uint8_t maxValue;                  /**< Largest value accepted on write. */
+    volatile uint32_t *writes;         /**< Counter incremented on write, or NULL. */
+    register_read_hook_t onRead;       /**< Live value, or NULL. */
+    register_write_hook_t onWrite;     /**< Write handler, or NULL. */
+    uint8_t readLength;                /**< Bytes of a read with PEC starting here. */
+} register_desc_t;
+
+/**
+ * \brief GPIO edge record as queued by the PORT interrupt.
+ */
+typedef struct
+{
+    uint32_t timestamp;   /**< Time of the edge, in timebase ticks. */
+    uint8_t info;         /**< REG_EDGE_RISING | input number. */
+} edge_record_t;
+
+/*==============================================================================
+                          LOCAL VARIABLE DECLARATIONS
+==============================================================================*/
+/**
+ * \brief Array of registers (each register is 1 byte).
+ * \details Live map: acquired values are staged here by the main loop and the
+ *          configuration register is written here by the IC ISR.
+ */
+static uint8_t g_registers[NUM_REGISTERS] = {0};
+
+/**
+ * \brief Published register frames.
+ * \details Only the main loop writes, and only to the frame that is not front.
+ *          Declared volatile so the frame copy cannot be reordered past the
+ *          store to g_frontFrame that publishes it.
+ */
+static volatile uint8_t g_frames[NUM_FRAMES][NUM_REGISTERS] = {{0}};
+
+/**
+ * \brief Index of the last published (front) frame.
+ */
+static volatile uint8_t g_frontFrame = 0U;
+
+/**
+ * \brief Frame latched by the IC ISR for the read transaction in progress.
+ */
+static uint8_t g_readFrame[NUM_REGISTERS] = {0};
+
+/**
+ * \brief Number of writes to the SPI configuration registers (modulo 2^32).
+ * \details Change indications are counters rather than flags: the IC ISR
+ *          only increments them and the main loop only writes its own copy of
+ *          the count it has handled, so no change can be lost or seen twice.
+ */
+static volatile uint32_t g_configWrites = 0U;
+
+/**
+ * \brief Number of SPI configuration updates (modulo 2^32).
+ * \details One per committed IC transaction that wrote the SPI configuration,
+ *          however many of its registers it wrote, and one per
+ *          registers_setConfig().
+ */
+static volatile uint32_t g_configUpdates = 0U;
+
+/** \brief Number of writes to the ADC mode register. */
+static volatile uint32_t g_adcModeWrites = 0U;
+
+/** \brief g_adcModeWrites when the main loop last cleared the change. */
+static uint32_t g_adcModeHandled = 0U;
+
+/** \brief Number of writes to the IC mode register. */
+static volatile uint32_t g_i2cModeWrites = 0U;
+
+/** \brief g_i2cModeWrites when the main loop last cleared the change. */
+static uint32_t g_i2cModeHandled = 0U;
+
+/** \brief Number of writes to the alarm configuration registers. */
+static volatile uint32_t g_alarmConfigWrites = 0U;
+
+/** \brief g_alarmConfigWrites when the main loop last cleared the change. */
+static uint32_t g_alarmConfigHandled = 0U;
+
+/**
+ * \brief Latched alarm of each channel (REG_ALARM bit n).
+ * \details One byte per channel: set from the eDMA ISR and cleared from the IC
+ *          ISR with plain stores, so neither needs a read-modify-write of the
+ *          other's data.
+ */
+static volatile bool g_alarmLatched[REG_ALARM_CHANNELS] = {false};
+
+/**
+ * \brief GPIO edge queue.
+ * \details Lock-free single-producer/single-consumer ring: only the PORT ISR
+ *          writes records and g_edgeHead, only the IC ISR reads records and
+ *          writes g_edgeTail. The indexes run freely and are masked on access.
+ *          Declared volatile so record accesses are not reordered past the index
+ *          stores that hand them over.
+ */
+static volatile edge_record_t g_edgeQueue[EDGE_QUEUE_LEN];
+
+/** \brief Number of records ever queued (written by the producer only). */
+static volatile uint32_t g_edgeHead = 0U;
+
+/** \brief Number of records ever drained (written by the consumer only). */
+static volatile uint32_t g_edgeTail = 0U;
+
+/** \brief Number of records dropped on overflow, modulo 256 (producer only). */
+static volatile uint8_t g_edgeLost = 0U;
+
+/** \brief Edge records of the read transaction in progress, oldest first. */
+static uint8_t g_edgeBlock[EDGE_BLOCK_RECORDS * REG_EDGE_RECORD_LEN] = {0};
+
+/** \brief Number of queued records copied to g_edgeBlock (not yet drained). */
+static uint8_t g_edgeBlockRecords = 0U;
+
+/** \brief true if the current read transaction started at REG_EDGE_FIFO. */
+static bool g_edgeStreaming = false;
+
+/** \brief Number of writes to the debounce configuration registers. */
+static volatile uint32_t g_debounceConfigWrites = 0U;
+
+/** \brief g_debounceConfigWrites when the main loop last cleared the change. */
+static uint32_t g_debounceConfigHandled = 0U;
+
+/** \brief Debounced GPIO state (written by the debounce tick only). */
+static volatile uint8_t g_debounced = 0U;
+
+/** \brief Debounced transitions of each GPIO pin, modulo 256 (debounce tick only). */
+static volatile uint8_t g_transitions[REG_TRANS_COUNT] = {0};
+
+/**
+ * \brief Registers read from REG_BANK_STATUS, in order.
+ */
+static const uint8_t g_statusBank[REG_STATUS_LEN] = {
+    REG_DEBOUNCED, REG_GPIO, REG_ALARM, REG_EDGE_COUNT,
+    REG_ADC0_H, REG_ADC0_L, REG_ADC1_H, REG_ADC1_L
+};
+
+/** \brief Bank addressed by the current IC transaction. */
+static uint8_t g_bank = REG_BANK_MAP;
+
+/** \brief Status bytes of the read transaction in progress. */
+static uint8_t g_statusFrame[REG_STATUS_LEN] = {0};
+
+/**
+ * \brief Current register index received from IC.
+ */
+static uint8_t g_currentRegIndex = 0U;
+
+/**
+ * \brief State flag for the IC state machine.
+ * \details false: waiting for register index; true: waiting for data.
+ */
+static bool g_waitingForData = false;
+
+/** \brief Register indexes of the writes staged by the current transaction. */
+static uint8_t g_stagedIndex[WRITE_STAGE_LEN] = {0};
+
+/** \brief Values of the writes staged by the current transaction. */
+static uint8_t g_stagedValue[WRITE_STAGE_LEN] = {0};
+
+/** \brief Number of writes staged by the current transaction. */
+static uint8_t g_stagedCount = 0U;
+
+/** \brief true if the current transaction carries PEC bytes (REG_PEC at its start). */
+static bool g_pecActive = false;
+
+/** \brief PEC of the bytes of the current transaction already passed to the state machine. */
+static uint8_t g_pecCrc = 0U;
+
+/** \brief Last byte of the current write, not yet known to be data or its PEC. */
+static uint8_t g_pecHeld = 0U;
+
+/** \brief true if g_pecHeld holds a byte. */
+static bool g_pecHolding = false;
+
+/**
+ * \brief true if the current read continues a write ended by a repeated START.
+ * \details The read PEC then also covers the address byte and index written
+ *          before it, as for an SMBus Read Byte/Word.
+ */
+static bool g_pecChained = false;
+
+/** \brief Register index at the start of the current transaction, restored on a PEC error. */
+static uint8_t g_pecRegIndex = 0U;
+
+/** \brief Number of writes rejected on a PEC mismatch, modulo 256 (IC ISR only). */
+static uint8_t g_pecErrors = 0U;
+
+/** \brief Data bytes of the block served by the current read, before the PEC. */
+static uint32_t g_readLength = 0U;
+
+/** \brief Read block followed by its PEC byte. */
+static uint8_t g_pecBlock[READ_BLOCK_MAX + 1U] = {0};
+
+/**
+ * \brief SMBus PEC table: CRC-8, polynomial x^8 + x^2 + x + 1, of every byte value.
+ * \details The S32K144 CRC module only computes 16- and 32-bit CRCs, so the
+ *          PEC is table-driven: one lookup and one XOR per byte.
+ */
+static const uint8_t g_crc8Table[256] = {
+    0x00U, 0x07U, 0x0EU, 0x09U, 0x1CU, 0x1BU, 0x12U, 0x15U,
+    0x38U, 0x3FU, 0x36U, 0x31U, 0x24U, 0x23U, 0x2AU, 0x2DU,
+    0x70U, 0x77U, 0x7EU, 0x79U, 0x6CU, 0x6BU, 0x62U, 0x65U,
+    0x48U, 0x4FU, 0x46U, 0x41U, 0x54U, 0x53U, 0x5AU, 0x5DU,
+    0xE0U, 0xE7U, 0xEEU, 0xE9U, 0xFCU, 0xFBU, 0xF2U, 0xF5U,
+    0xD8U, 0xDFU, 0xD6U, 0xD1U, 0xC4U, 0xC3U, 0xCAU, 0xCDU,
+    0x90U, 0x97U, 0x9EU, 0x99U, 0x8CU, 0x8BU, 0x82U, 0x85U,
+    0xA8U, 0xAFU, 0xA6U, 0xA1U, 0xB4U, 0xB3U, 0xBAU, 0xBDU,
+    0xC7U, 0xC0U, 0xC9U, 0xCEU, 0xDBU, 0xDCU, 0xD5U, 0xD2U,
+    0xFFU, 0xF8U, 0xF1U, 0xF6U, 0xE3U, 0xE4U, 0xEDU, 0xEAU,
+    0xB7U, 0xB0U, 0xB9U, 0xBEU, 0xABU, 0xACU, 0xA5U, 0xA2U,
+    0x8FU, 0x88U, 0x81U, 0x86U, 0x93U, 0x94U, 0x9DU, 0x9AU,
+    0x27U, 0x20U, 0x29U, 0x2EU, 0x3BU, 0x3CU, 0x35U, 0x32U,
+    0x1FU, 0x18U, 0x11U, 0x16U, 0x03U, 0x04U, 0x0DU, 0x0AU,
+    0x57U, 0x50U, 0x59U, 0x5EU, 0x4BU, 0x4CU, 0x45U, 0x42U,
+    0x6FU, 0x68U, 0x61U, 0x66U, 0x73U, 0x74U, 0x7DU, 0x7AU,
+    0x89U, 0x8EU, 0x87U, 0x80U, 0x95U, 0x92U, 0x9BU, 0x9CU,
+    0xB1U, 0xB6U, 0xBFU, 0xB8U, 0xADU, 0xAAU, 0xA3U, 0xA4U,
+    0xF9U, 0xFEU, 0xF7U, 0xF0U, 0xE5U, 0xE2U, 0xEBU, 0xECU,
+    0xC1U, 0xC6U, 0xCFU, 0xC8U, 0xDDU, 0xDAU, 0xD3U, 0xD4U,
+    0x69U, 0x6EU, 0x67U, 0x60U, 0x75U, 0x72U, 0x7BU, 0x7CU,
+    0x51U, 0x56U, 0x5FU, 0x58U, 0x4DU, 0x4AU, 0x43U, 0x44U,
+    0x19U, 0x1EU, 0x17U, 0x10U, 0x05U, 0x02U, 0x0BU, 0x0CU,
+    0x21U, 0x26U, 0x2FU, 0x28U, 0x3DU, 0x3AU, 0x33U, 0x34U,
+    0x4EU, 0x49U, 0x40U, 0x47U, 0x52U, 0x55U, 0x5CU, 0x5BU,
+    0x76U, 0x71U, 0x78U, 0x7FU, 0x6AU, 0x6DU, 0x64U, 0x63U,
+    0x3EU, 0x39U, 0x30U, 0x37U, 0x22U, 0x25U, 0x2CU, 0x2BU,
+    0x06U, 0x01U, 0x08U, 0x0FU, 0x1AU, 0x1DU, 0x14U, 0x13U,
+    0xAEU, 0xA9U, 0xA0U, 0xA7U, 0xB2U, 0xB5U, 0xBCU, 0xBBU,
+    0x96U, 0x91U, 0x98U, 0x9FU, 0x8AU, 0x8DU, 0x84U, 0x83U,
+    0xDEU, 0xD9U, 0xD0U, 0xD7U, 0xC2U, 0xC5U, 0xCCU, 0xCBU,
+    0xE6U, 0xE1U, 0xE8U, 0xEFU, 0xFAU, 0xFDU, 0xF4U, 0xF3U
+};
+
+/**
+ * \brief Number of write transactions committed.
+ * \details Incremented by the IC ISR after each commit, so the main loop can
+ *          detect a commit that interleaved with a multi-register read.
+ */
+static volatile uint32_t g_commitCount = 0U;
+
+/*==============================================================================
+                         LOCAL FUNCTION PROTOTYPES
+==============================================================================*/
+static void registers_latchReadFrame(void);
+static uint8_t registers_readAlarm(uint8_t regIndex);
+static void registers_clearAlarm(uint8_t regIndex, uint8_t value);
+static uint8_t registers_readEdgeCount(uint8_t regIndex);
+static uint8_t registers_readEdgeLost(uint8_t regIndex);
+static uint8_t registers_readDebounced(uint8_t regIndex);
+static uint8_t registers_readTransitions(uint8_t regIndex);
+static void registers_modifyConfig(uint8_t regIndex, uint8_t value);
+static void registers_peekEdges(void);
+static uint8_t registers_readPecErrors(uint8_t regIndex);
+static void registers_parseByte(uint8_t byteReceived);
+static uint32_t registers_pecReadLength(uint8_t regIndex);
+static uint32_t registers_addPec(const uint8_t *data, uint32_t length, uint8_t **block);
+
+/*==============================================================================
+                          REGISTER DESCRIPTOR TABLE
+==============================================================================*/
+/** \brief Read-only register, published with the acquisition frames. */
+#define REG_DESC_RO                  { REG_ACCESS_RO, 0U, 0U, 0U, NULL, NULL, NULL, 1U }
+/** \brief Read-only register starting a fixed-length read of len bytes. */
+#define REG_DESC_RO_BLOCK(len)       { REG_ACCESS_RO, 0U, 0U, 0U, NULL, NULL, NULL, (len) }
+/** \brief Read-only register read live through a hook. */
+#define REG_DESC_LIVE(read)          { REG_ACCESS_RO, 0U, 0U, 0U, NULL, (read), NULL, 1U }
+/** \brief Read/write register accepting [min, max], counting its writes. */
+#define REG_DESC_RW(reset, min, max, writes) \
+                                     { REG_ACCESS_RW, (reset), (min), (max), (writes), NULL, NULL, 1U }
+/** \brief Read/write high byte of a 16-bit value, read as an SMBus word. */
+#define REG_DESC_RW_WORD(reset, min, max, writes) \
+                                     { REG_ACCESS_RW, (reset), (min), (max), (writes), NULL, NULL, 2U }
+/** \brief Write-1-to-clear register read live through a hook. */
+#define REG_DESC_W1C(read, clear)    { REG_ACCESS_W1C, 0U, 0U, 0xFFU, NULL, (read), (clear), 1U }
+/** \brief Write-only alias register applied by a hook. */
+#define REG_DESC_WO(write)           { REG_ACCESS_WO, 0U, 0U, 0xFFU, NULL, NULL, (write), 1U }
+
+/**
+ * \brief Descriptor of every register, indexed by register number.
+ *
+ * \details Registers without an entry are read-only with a read length of 0,
+ *          served as 1, like the rest of the timing diagnostics window.
+ */
+static const register_desc_t g_registerMap[NUM_REGISTERS] = {
+    [REG_GPIO]        = REG_DESC_RO,
+    [REG_ADC0]        = REG_DESC_RO,
+    [REG_ADC1]        = REG_DESC_RO,
+    [REG_SPICFG]      = REG_DESC_RW(0U, 0U, 0xFFU, &g_configWrites),
+    [REG_ADC0_H]      = REG_DESC_RO_BLOCK(2U),
+    [REG_ADC0_L]      = REG_DESC_RO,
+    [REG_ADC1_H]      = REG_DESC_RO_BLOCK(2U),
+    [REG_ADC1_L]      = REG_DESC_RO,
+    [REG_ADCMODE]     = REG_DESC_RW(REG_ADCMODE_SINGLE, 0U, REG_ADCMODE_OVERSAMPLE, &g_adcModeWrites),
+    [REG_ALARMCFG]    = REG_DESC_RW(0U, 0U, 0xFFU, &g_alarmConfigWrites),
+    [REG_ADC0_LOW_H]  = REG_DESC_RW_WORD(0U, 0U, 0xFFU, &g_alarmConfigWrites),
+    [REG_ADC0_LOW_L]  = REG_DESC_RW(0U, 0U, 0xFFU, &g_alarmConfigWrites),
+    [REG_ADC0_HIGH_H] = REG_DESC_RW_WORD(0U, 0U, 0xFFU, &g_alarmConfigWrites),
+    [REG_ADC0_HIGH_L] = REG_DESC_RW(0U, 0U, 0xFFU, &g_alarmConfigWrites),
+    [REG_ADC1_LOW_H]  = REG_DESC_RW_WORD(0U, 0U, 0xFFU, &g_alarmConfigWrites),
+    [REG_ADC1_LOW_L]  = REG_DESC_RW(0U, 0U, 0xFFU, &g_alarmConfigWrites),
+    [REG_ADC1_HIGH_H] = REG_DESC_RW_WORD(0U, 0U, 0xFFU, &g_alarmConfigWrites),
+    [REG_ADC1_HIGH_L] = REG_DESC_RW(0U, 0U, 0xFFU, &g_alarmConfigWrites),
+    [REG_ALARM]       = REG_DESC_W1C(registers_readAlarm, registers_clearAlarm),
+    [REG_EDGE_COUNT]  = REG_DESC_LIVE(registers_readEdgeCount),
+    [REG_EDGE_LOST]   = REG_DESC_LIVE(registers_readEdgeLost),
+    [REG_EDGE_FIFO]   = REG_DESC_RO,
+    [REG_DEBOUNCED]   = REG_DESC_LIVE(registers_readDebounced),
+    [REG_DEBOUNCE_N]  = REG_DESC_RW(REG_DEBOUNCE_N_DEFAULT, 1U, 0xFFU, &g_debounceConfigWrites),
+    [REG_DIGFILTER]   = REG_DESC_RW(0U, 0U, REG_DIGFILTER_MAX, &g_debounceConfigWrites),
+    [REG_TRANS0]      = REG_DESC_LIVE(registers_readTransitions),
+    [REG_TRANS0 + 1]  = REG_DESC_LIVE(registers_readTransitions),
+    [REG_TRANS0 + 2]  = REG_DESC_LIVE(registers_readTransitions),
+    [REG_TRANS0 + 3]  = REG_DESC_LIVE(registers_readTransitions),
+    [REG_TRANS0 + 4]  = REG_DESC_LIVE(registers_readTransitions),
+    [REG_TRANS0 + 5]  = REG_DESC_LIVE(registers_readTransitions),
+    [REG_TRANS0 + 6]  = REG_DESC_LIVE(registers_readTransitions),
+    [REG_TRANS7]      = REG_DESC_LIVE(registers_readTransitions),
+    [REG_OVERRUNS]    = REG_DESC_RO,
+    [REG_SPICFG1]     = REG_DESC_RW(0U, 0U, 0xFFU, &g_configWrites),
+    [REG_SPICFG1 + 1] = REG_DESC_RW(0U, 0U, 0xFFU, &g_configWrites),
+    [REG_SPICFG1 + 2] = REG_DESC_RW(0U, 0U, 0xFFU, &g_configWrites),
+    [REG_SPICFG1 + 3] = REG_DESC_RW(0U, 0U, 0xFFU, &g_configWrites),
+    [REG_SPICFG1 + 4] = REG_DESC_RW(0U, 0U, 0xFFU, &g_configWrites),
+    [REG_SPICFG1 + 5] = REG_DESC_RW(0U, 0U, 0xFFU, &g_configWrites),
+    [REG_SPICFG7]     = REG_DESC_RW(0U, 0U, 0xFFU, &g_configWrites),
+    [REG_SPICHAIN]    = REG_DESC_RW(REG_SPICHAIN_DEFAULT, 1U, REG_SPICHAIN_MAX, &g_configWrites),
+    [REG_SPIKHZ_H]    = REG_DESC_RO_BLOCK(2U),
+    [REG_SPIKHZ_L]    = REG_DESC_RO,
+    [REG_I2CKHZ_H]    = REG_DESC_RO_BLOCK(2U),
+    [REG_I2CKHZ_L]    = REG_DESC_RO,
+    [REG_I2CMODE]     = REG_DESC_RW(REG_I2CMODE_FAST, 0U, REG_I2CMODE_FAST_PLUS, &g_i2cModeWrites),
+    [REG_SPICFG_SET]  = REG_DESC_WO(registers_modifyConfig),
+    [REG_SPICFG_CLR]  = REG_DESC_WO(registers_modifyConfig),
+    [REG_SPICFG_TGL]  = REG_DESC_WO(registers_modifyConfig),
+    [REG_SPI_SENT]    = REG_DESC_RO,
+    [REG_SPI_COALESCED] = REG_DESC_RO,
+    [REG_SPI_SKIPPED] = REG_DESC_RO,
+    [REG_PEC]         = REG_DESC_RW(REG_PEC_OFF, REG_PEC_OFF, REG_PEC_ON, NULL),
+    [REG_PEC_ERRORS]  = REG_DESC_LIVE(registers_readPecErrors),
+    [REG_PROF_STAGE]  = REG_DESC_RW(0U, 0U, REG_PROF_STAGES - 1U, NULL),
+    [REG_PROF_WINDOW] = REG_DESC_RO_BLOCK(REG_PROF_WINDOW_LEN)
+};
+
+/*==============================================================================
+                            LOCAL FUNCTION DEFINITIONS
+==============================================================================*/
+
+/**
+ * \brief Returns the REG_ALARM value built from the latched alarms.
+ *
+ * \param[in] regIndex Unused.
+ *
+ * \return Bit n set if channel n has a latched alarm.
+ */
+static uint8_t registers_readAlarm(uint8_t regIndex)
+{
+    uint8_t status = 0U;
+    uint8_t channel;
+
+    (void)regIndex;
+
+    for (channel = 0U; channel < REG_ALARM_CHANNELS; channel++)
+    {
+        if (g_alarmLatched[channel])
+        {
+            status |= (uint8_t)(1U << channel);
+        }
+    }
+    return status;
+}
+
+/**
+ * \brief Clears the latched alarms written as 1 to REG_ALARM.
+ *
+ * \param[in] regIndex Unused.
+ * \param[in] value    Bit n set to clear the alarm of channel n.
+ *
+ * \return void.
+ */
+static void registers_clearAlarm(uint8_t regIndex, uint8_t value)
+{
+    uint8_t channel;
+
+    (void)regIndex;
+
+    for (channel = 0U; channel < REG_ALARM_CHANNELS; channel++)
+    {
+        if ((value & (1U << channel)) != 0U)
+        {
+            g_alarmLatched[channel] = false;
+        }
+    }
+}
+
+/**
+ * \brief Returns the REG_EDGE_COUNT value.
+ *
+ * \param[in] regIndex Unused.
+ *
+ * \return Number of queued edge records, saturated to 255.
+ */
+static uint8_t registers_readEdgeCount(uint8_t regIndex)
+{
+    uint32_t count = g_edgeHead - g_edgeTail;
+
+    (void)regIndex;
+
+    return (count > 0xFFU) ? 0xFFU : (uint8_t)count;
+}
+
+/**
+ * \brief Returns the REG_EDGE_LOST value.
+ *
+ * \param[in] regIndex Unused.
+ *
+ * \return Number of edge records dropped on overflow, modulo 256.
+ */
+static uint8_t registers_readEdgeLost(uint8_t regIndex)
+{
+    (void)regIndex;
+
+    return g_edgeLost;
+}
+
+/**
+ * \brief Returns the REG_DEBOUNCED value.
+ *
+ * \param[in] regIndex Unused.
+ *
+ * \return Debounced state of the 8 GPIO pins.
+ */
+static uint8_t registers_readDebounced(uint8_t regIndex)
+{
+    (void)regIndex;
+
+    return g_debounced;
+}
+
+/**
+ * \brief Returns the value of a REG_TRANSn register.
+ *
+ * \param[in] regIndex REG_TRANS0..REG_TRANS7.
+ *
+ * \return Debounced transitions of GPIO pin n, modulo 256.
+ */
+static uint8_t registers_readTransitions(uint8_t regIndex)
+{
+    return g_transitions[regIndex - REG_TRANS0];
+}
+
+/**
+ * \brief Applies a write to a REG_SPICFG alias register.
+ *
+ * \details Runs in the IC ISR, so the read-modify-write of REG_SPICFG cannot
+ *          interleave with another write.
+ *
+ * \param[in] regIndex REG_SPICFG_SET, REG_SPICFG_CLR or REG_SPICFG_TGL.
+ * \param[in] value    Mask of the bits to set, clear or toggle.
+ *
+ * \return void.
+ */
+static void registers_modifyConfig(uint8_t regIndex, uint8_t value)
+{
+    uint8_t config = g_registers[REG_SPICFG];
+
+    switch (regIndex)
+    {
+        case REG_SPICFG_SET:
+            config |= value;
+            break;
+
+        case REG_SPICFG_CLR:
+            config &= (uint8_t)~value;
+            break;
+
+        default:
+            config ^= value;
+            break;
+    }
+
+    g_registers[REG_SPICFG] = config;
+    g_configWrites++;
+}
+
+/**
+ * \brief Returns the REG_PEC_ERRORS value.
+ *
+ * \param[in] regIndex Unused.
+ *
+ * \return Number of writes rejected on a PEC mismatch, modulo 256.
+ */
+static uint8_t registers_readPecErrors(uint8_t regIndex)
+{
+    (void)regIndex;
+
+    return g_pecErrors;
+}
+
+/**
+ * \brief Runs one written byte through the index/data state machine.
+ *
+ * \details The first byte is stored as the register index, the next one is
+ *          staged as data for that register, and so on; writes past
+ *          WRITE_STAGE_LEN in one transaction are dropped.
+ *
+ * \param[in] byteReceived Data byte written by the master.
+ *
+ * \return void.
+ */
+static void registers_parseByte(uint8_t byteReceived)
+{
+    if (!g_waitingForData)
+    {
+        /* First byte: treat it as the register index */
+        g_currentRegIndex = byteReceived;
+        g_waitingForData = true;
+    }
+    else
+    {
+        /* Second byte: stage it as data to write into the register */
+        if (g_stagedCount < WRITE_STAGE_LEN)
+        {
+            g_stagedIndex[g_stagedCount] = g_currentRegIndex;
+            g_stagedValue[g_stagedCount] = byteReceived;
+            g_stagedCount++;
+        }
+        g_waitingForData = false;
+    }
+}
+
+/**
+ * \brief Returns the length of a read with PEC starting at a register.
+ *
+ * \details SMBus reads have a fixed length, since the master acknowledges the
+ *          last data byte before reading the PEC and the slave cannot tell
+ *          where it stops: one byte, a word from the high byte of a 16-bit
+ *          value, or the timing diagnostics window.
+ *
+ * \param[in] regIndex Register the read starts at (below NUM_REGISTERS).
+ *
+ * \return Number of data bytes, capped at the end of the map.
+ */
+static uint32_t registers_pecReadLength(uint8_t regIndex)
+{
+    uint32_t length = g_registerMap[regIndex].readLength;
+
+    if (length == 0U)
+    {
+        length = 1U;
+    }
+    if (length > ((uint32_t)NUM_REGISTERS - regIndex))
+    {
+        length = (uint32_t)NUM_REGISTERS - regIndex;
+    }
+    return length;
+}
+
+/**
+ * \brief Builds the read block followed by its PEC.
+ *
+ * \details The PEC covers the read address byte and the data bytes. After a
+ *          write ended by a repeated START it continues the PEC of that write
+ *          (write address byte and register index), as for an SMBus Read
+ *          Byte/Word; otherwise it starts from the read address byte.
+ *
+ * \param[in]  data   Bytes to serve.
+ * \param[in]  length Number of bytes to serve (at most READ_BLOCK_MAX).
+ * \param[out] block  First byte of the block with the PEC.
+ *
+ * \return The length of the block, in bytes.
+ */
+static uint32_t registers_addPec(const uint8_t *data, uint32_t length, uint8_t **block)
+{
+    uint8_t crc = g_pecChained ? g_pecCrc : 0U;
+    uint8_t address = (g_bank == REG_BANK_STATUS) ? REG_BANK_STATUS_ADDRESS : REG_BANK_MAP_ADDRESS;
+    uint32_t i;
+
+    crc = g_crc8Table[crc ^ (uint8_t)((address << 1U) | 1U)];
+    for (i = 0U; i < length; i++)
+    {
+        crc = g_crc8Table[crc ^ data[i]];
+        g_pecBlock[i] = data[i];
+    }
+    g_pecBlock[length] = crc;
+
+    *block = g_pecBlock;
+    return length + 1U;
+}
+
+/**
+ * \brief Copies the oldest edge records into g_edgeBlock.
+ *
+ * \details Runs in the IC ISR (single consumer). g_edgeTail is not advanced
+ *          here, so the producer cannot overwrite the records copied; they are
+ *          drained in registers_endTransaction() once the master has read them.
+ *          The slots past the queued records hold records with REG_EDGE_VALID
+ *          clear.
+ *
+ * \return void.
+ */
+static void registers_peekEdges(void)
+{
+    uint32_t tail = g_edgeTail;
+    uint32_t count = g_edgeHead - tail;
+    uint8_t *bytes = g_edgeBlock;
+    uint32_t i;
+
+    if (count > EDGE_BLOCK_RECORDS)
+    {
+        count = EDGE_BLOCK_RECORDS;
+    }
+
+    memset(g_edgeBlock, 0, sizeof(g_edgeBlock));
+    for (i = 0U; i < count; i++)
+    {
+        const volatile edge_record_t *record = &g_edgeQueue[(tail + i) & (EDGE_QUEUE_LEN - 1U)];
+        bytes[0] = (uint8_t)(REG_EDGE_VALID | record->info);
+        bytes[1] = (uint8_t)(record->timestamp >> 24U);
+        bytes[2] = (uint8_t)(record->timestamp >> 16U);
+        bytes[3] = (uint8_t)(record->timestamp >> 8U);
+        bytes[4] = (uint8_t)record->timestamp;
+        bytes += REG_EDGE_RECORD_LEN;
+    }
+    g_edgeBlockRecords = (uint8_t)count;
+}
+
+/**
+ * \brief Latches the front frame for the current read transaction.
+ *
+ * \details Runs in the IC ISR, so the copy cannot be interrupted by the main
+ *          loop, and the main loop never writes to the front frame. The RW
+ *          registers are taken from the live map so that a value just written by
+ *          the master reads back immediately, and the registers with a read hook
+ *          (alarm, edge queue, debounce) reflect their state at this point. The
+ *          status bank and edge records served instead of the map are prepared
+ *          here as well.
+ *
+ * \return void.
+ */
+static void registers_latchReadFrame(void)
+{
+    uint8_t frontFrame = g_frontFrame;
+    uint8_t i;
+
+    for (i = 0U; i < NUM_REGISTERS; i++)
+    {
+        const register_desc_t *desc = &g_registerMap[i];
+
+        if (desc->onRead != NULL)
+        {
+            g_readFrame[i] = desc->onRead(i);
+        }
+        else if (desc->access != REG_ACCESS_RO)
+        {
+            g_readFrame[i] = g_registers[i];
+        }
+        else
+        {
+            g_readFrame[i] = g_frames[frontFrame][i];
+        }
+    }
+    for (i = 0U; i < REG_STATUS_LEN; i++)
+    {
+        g_statusFrame[i] = g_readFrame[g_statusBank[i]];
+    }
+    g_edgeStreaming = (g_bank == REG_BANK_MAP) && (g_currentRegIndex == REG_EDGE_FIFO);
+    if (g_edgeStreaming)
+    {
+        registers_peekEdges();
+    }
+}
+
+/*==============================================================================
+                            GLOBAL FUNCTION DEFINITIONS
+==============================================================================*/
+
+/**
+ * \brief Initializes the registers module.
+ *
+ * \details This function initializes all registers to their reset value and
+ *          resets the state machine used for processing incoming IC bytes.
+ *
+ * \return void.
+ */
+void registers_init(void)
+{
+    uint8_t i;
+
+    /* Initialize all registers to 0 */
+    memset(g_registers, 0, sizeof(g_registers));
+    memset((void *)g_frames, 0, sizeof(g_frames));
+    memset(g_readFrame, 0, sizeof(g_readFrame));
+    g_frontFrame = 0U;
+    /* Reset state machine variables */
+    g_currentRegIndex = 0U;
+    g_waitingForData = false;
+    g_stagedCount = 0U;
+    g_commitCount = 0U;
+    g_bank = REG_BANK_MAP;
+    g_pecActive = false;
+    g_pecHolding = false;
+    g_pecChained = false;
+    g_pecErrors = 0U;
+    g_readLength = 0U;
+    g_configWrites = 0U;
+    g_configUpdates = 0U;
+    g_adcModeWrites = 0U;
+    g_adcModeHandled = 0U;
+    g_alarmConfigWrites = 0U;
+    g_alarmConfigHandled = 0U;
+    g_i2cModeWrites = 0U;
+    g_i2cModeHandled = 0U;
+    memset((void *)g_alarmLatched, 0, sizeof(g_alarmLatched));
+    g_edgeHead = 0U;
+    g_edgeTail = 0U;
+    g_edgeLost = 0U;
+    g_edgeBlockRecords = 0U;
+    g_edgeStreaming = false;
+    g_debounceConfigWrites = 0U;
+    g_debounceConfigHandled = 0U;
+    g_debounced = 0U;
+    memset((void *)g_transitions, 0, sizeof(g_transitions));
+    for (i = 0U; i < NUM_REGISTERS; i++)
+    {
+        g_registers[i] = g_registerMap[i].resetValue;
+    }
+}
+
+/**
+ * \brief Updates the GPIO register with the current 8-bit value.
+ *
+ * \param[in] gpioVal  8-bit value read from the GPIO pins.
+ *
+ * \return void.
+ */
+void registers_updateGPIO(uint8_t gpioVal)
+{
+    g_registers[REG_GPIO] = gpioVal;
+}
+
+/**
+ * \brief Updates the ADC registers for the specified channel.
+ *
+ * \details Stores the full-resolution value big-endian in REG_ADCx_H/REG_ADCx_L, so
+ *          a burst read returns it most significant byte first, and keeps the 8
+ *          most significant bits in the legacy REG_ADCx register.
+ *
+ * \param[in] channel        ADC channel number (0 or 1).
+ * \param[in] adcVal         Value from the ADC conversion.
+ * \param[in] resolutionBits Resolution of adcVal, in bits (at least 8).
+ *
+ * \return void.
+ */
+void registers_updateADC(uint8_t channel, uint16_t adcVal, uint8_t resolutionBits)
+{
+    uint8_t msb8 = (uint8_t)(adcVal >> (resolutionBits - 8U));
+
+    if (channel == 0U)
+    {
+        g_registers[REG_ADC0] = msb8;
+        g_registers[REG_ADC0_H] = (uint8_t)(adcVal >> 8U);
+        g_registers[REG_ADC0_L] = (uint8_t)adcVal;
+    }
+    else if (channel == 1U)
+    {
+        g_registers[REG_ADC1] = msb8;
+        g_registers[REG_ADC1_H] = (uint8_t)(adcVal >> 8U);
+        g_registers[REG_ADC1_L] = (uint8_t)adcVal;
+    }
+}
+
+/**
+ * \brief Updates the scheduler overrun counter register.
+ *
+ * \param[in] overruns Number of deadline overruns, modulo 256.
+ *
+ * \return void.
+ */
+void registers_updateOverruns(uint8_t overruns)
+{
+    g_registers[REG_OVERRUNS] = overruns;
+}
+
+/**
+ * \brief Updates the SPI output update counter registers.
+ *
+ * \param[in] sent      Frames transmitted, modulo 256.
+ * \param[in] coalesced Configuration writes superseded before transmission, modulo 256.
+ * \param[in] skipped   Updates identical to the last frame sent, modulo 256.
+ *
+ * \return void.
+ */
+void registers_updateSpiStats(uint8_t sent, uint8_t coalesced, uint8_t skipped)
+{
+    g_registers[REG_SPI_SENT] = sent;
+    g_registers[REG_SPI_COALESCED] = coalesced;
+    g_registers[REG_SPI_SKIPPED] = skipped;
+}
+
+/**
+ * \brief Updates the bus rate status registers.
+ *
+ * \details Both rates are stored big-endian in kHz, rounded down.
+ *
+ * \param[in] spiHz SPI SCK frequency achieved, in Hz.
+ * \param[in] i2cHz Fastest IC SCL frequency supported by the slave, in Hz.
+ *
+ * \return void.
+ */
+void registers_updateBusRates(uint32_t spiHz, uint32_t i2cHz)
+{
+    uint16_t spiKHz = (uint16_t)(spiHz / 1000U);
+    uint16_t i2cKHz = (uint16_t)(i2cHz / 1000U);
+
+    g_registers[REG_SPIKHZ_H] = (uint8_t)(spiKHz >> 8U);
+    g_registers[REG_SPIKHZ_L] = (uint8_t)spiKHz;
+    g_registers[REG_I2CKHZ_H] = (uint8_t)(i2cKHz >> 8U);
+    g_registers[REG_I2CKHZ_L] = (uint8_t)i2cKHz;
+}
+
+/**
+ * \brief Updates the timing diagnostics window.
+ *
+ * \details All values are stored big-endian. Published with the next frame.
+ *
+ * \param[in] count      Number of durations recorded.
+ * \param[in] minCycles  Shortest duration, in core clock cycles.
+ * \param[in] maxCycles  Longest duration, in core clock cycles.
+ * \param[in] meanCycles Mean duration, in core clock cycles.
+ * \param[in] histogram  REG_PROF_HIST_BINS duration counts.
+ *
+ * \return void.
+ */
+void registers_updateProfile(uint32_t count, uint32_t minCycles, uint32_t maxCycles,
+                             uint32_t meanCycles, const uint16_t *histogram)
+{
+    /* In the order of REG_PROF_COUNT, REG_PROF_MIN, REG_PROF_MAX and REG_PROF_MEAN */
+    const uint32_t values[] = { count, minCycles, maxCycles, meanCycles };
+    uint8_t *window = &g_registers[REG_PROF_WINDOW];
+    uint8_t i;
+
+    for (i = 0U; i < (sizeof(values) / sizeof(values[0])); i++)
+    {
+        window[(4U * i)]      = (uint8_t)(values[i] >> 24U);
+        window[(4U * i) + 1U] = (uint8_t)(values[i] >> 16U);
+        window[(4U * i) + 2U] = (uint8_t)(values[i] >> 8U);
+        window[(4U * i) + 3U] = (uint8_t)values[i];
+    }
+    for (i = 0U; i < REG_PROF_HIST_BINS; i++)
+    {
+        window[REG_PROF_HIST + (2U * i)]      = (uint8_t)(histogram[i] >> 8U);
+        window[REG_PROF_HIST + (2U * i) + 1U] = (uint8_t)histogram[i];
+    }
+}
+
+/**
+ * \brief Publishes the values acquired in the current cycle as a new frame.
+ *
+ * \details Copies the live map into the back frame and then makes it the front
+ *          frame with a single byte store. IC read transactions that start
+ *          afterwards are served from the new frame.
+ *
+ * \return void.
+ */
+void registers_publish(void)
+{
+    uint8_t backFrame = (uint8_t)(g_frontFrame ^ 1U);
+    uint8_t i;
+
+    for (i = 0U; i < NUM_REGISTERS; i++)
+    {
+        g_frames[backFrame][i] = g_registers[i];
+    }
+    g_frontFrame = backFrame;
+}
 
-/*==============================================================================
-                          LOCAL VARIABLE DECLARATIONS
-==============================================================================*/
 /**
- * \brief Array of registers (each register is 1 byte).
+ * \brief Returns the current SPI configuration register value.
+ *
+ * \return The value stored in the SPI configuration register.
  */
-static uint8_t g_registers[NUM_REGISTERS] = {0};
+uint8_t registers_getConfig(void)
+{
+    return g_registers[REG_SPICFG];
+}
 
 /**
- * \brief Flag indicating if the SPI configuration register was modified.
+ * \brief Retrieves the SPI configuration of the whole chain of ISO1H816G devices.
+ *
+ * \details The copy is retried if an IC write transaction was committed while
+ *          it was taken, so it never mixes values of two transactions.
+ *
+ * \param[out] config Configuration of each device, device 0 first. Must hold
+ *                    REG_SPICHAIN_MAX bytes.
+ *
+ * \return The number of chained devices (REG_SPICHAIN).
  */
-static bool g_configChanged = false;
+uint8_t registers_getChainConfig(uint8_t *config)
+{
+    uint32_t commitCount;
+    uint8_t devices;
+    uint8_t device;
+
+    do
+    {
+        commitCount = g_commitCount;
+        REG_COMPILER_BARRIER();
+        devices = g_registers[REG_SPICHAIN];
+        config[0] = g_registers[REG_SPICFG];
+        for (device = 1U; device < devices; device++)
+        {
+            config[device] = g_registers[REG_SPICFG1 + device - 1U];
+        }
+        REG_COMPILER_BARRIER();
+    } while (commitCount != g_commitCount);
+
+    return devices;
+}
 
 /**
- * \brief Current register index received from IC.
+ * \brief Writes a new value to the SPI configuration register and marks a change.
+ *
+ * \param[in] newConfig  New configuration value.
+ *
+ * \return void.
  */
-static uint8_t g_currentRegIndex = 0U;
+void registers_setConfig(uint8_t newConfig)
+{
+    g_registers[REG_SPICFG] = newConfig;
+    g_configWrites++;
+    g_configUpdates++;
+}
 
 /**
- * \brief State flag for the IC state machine.
- * \details false: waiting for register index; true: waiting for data.
+ * \brief Returns the number of writes to the SPI configuration registers.
+ *
+ * \return The write count, modulo 2^32.
  */
-static bool g_waitingForData = false;
+uint32_t registers_getConfigWrites(void)
+{
+    return g_configWrites;
+}
 
-/*==============================================================================
-                         LOCAL FUNCTION PROTOTYPES
-==============================================================================*/
-// (No additional local functions)
+/**
+ * \brief Returns the number of SPI configuration updates.
+ *
+ * \return The update count, modulo 2^32.
+ */
+uint32_t registers_getConfigUpdates(void)
+{
+    return g_configUpdates;
+}
 
-/*==============================================================================
-                            GLOBAL FUNCTION DEFINITIONS
-==============================================================================*/
+/**
+ * \brief Returns the current ADC mode register value.
+ *
+ * \return The value stored in REG_ADCMODE.
+ */
+uint8_t registers_getADCMode(void)
+{
+    return g_registers[REG_ADCMODE];
+}
 
 /**
- * \brief Initializes the registers module.
+ * \brief Clears the ADC mode change flag.
+ *
+ * \return void.
+ */
+void registers_clearADCModeFlag(void)
+{
+    g_adcModeHandled = g_adcModeWrites;
+}
+
+/**
+ * \brief Indicates whether the ADC mode register has been modified.
+ *
+ * \return true if REG_ADCMODE was written; false otherwise.
+ */
+bool registers_adcModeChanged(void)
+{
+    return g_adcModeWrites != g_adcModeHandled;
+}
+
+/**
+ * \brief Returns the current IC mode register value.
+ *
+ * \return The value stored in REG_I2CMODE.
+ */
+uint8_t registers_getI2CMode(void)
+{
+    return g_registers[REG_I2CMODE];
+}
+
+/**
+ * \brief Stores the IC bus mode in effect, without marking a change.
  *
- * \details This function initializes all registers to zero and resets the state
- *          machine used for processing incoming IC bytes.
+ * \param[in] mode One of REG_I2CMODE_x.
  *
  * \return void.
  */
-void registers_init(void)
+void registers_setI2CMode(uint8_t mode)
 {
-    /* Initialize all registers to 0 */
-    memset(g_registers, 0, sizeof(g_registers));
-    /* Reset state machine variables */
-    g_currentRegIndex = 0U;
-    g_waitingForData = false;
-    g_configChanged = false;
+    g_registers[REG_I2CMODE] = mode;
 }
 
 /**
- * \brief Updates the GPIO register with the current 8-bit value.
+ * \brief Clears the IC mode change flag.
  *
- * \param[in] gpioVal  8-bit value read from the GPIO pins.
+ * \return void.
+ */
+void registers_clearI2CModeFlag(void)
+{
+    g_i2cModeHandled = g_i2cModeWrites;
+}
+
+/**
+ * \brief Indicates whether the IC mode register has been modified.
+ *
+ * \return true if REG_I2CMODE was written; false otherwise.
+ */
+bool registers_i2cModeChanged(void)
+{
+    return g_i2cModeWrites != g_i2cModeHandled;
+}
+
+/**
+ * \brief Retrieves the threshold alarm settings of an ADC channel.
+ *
+ * \details Thresholds are stored big-endian in REG_ADCx_LOW_H/L and
+ *          REG_ADCx_HIGH_H/L.
+ *
+ * \param[in]  channel ADC channel number (0 or 1).
+ * \param[out] low     Low threshold, in codes.
+ * \param[out] high    High threshold, in codes.
+ *
+ * \return The alarm condition of the channel, or REG_ALARMCFG_OFF for an invalid
+ *         channel.
+ */
+uint8_t registers_getADCAlarm(uint8_t channel, uint16_t *low, uint16_t *high)
+{
+    uint8_t base;
+
+    if (channel >= REG_ALARM_CHANNELS)
+    {
+        *low = 0U;
+        *high = 0U;
+        return REG_ALARMCFG_OFF;
+    }
+
+    base = (uint8_t)(REG_ADC0_LOW_H + (channel * (REG_ADC1_LOW_H - REG_ADC0_LOW_H)));
+    *low = (uint16_t)(((uint16_t)g_registers[base] << 8U) | g_registers[base + 1U]);
+    *high = (uint16_t)(((uint16_t)g_registers[base + 2U] << 8U) | g_registers[base + 3U]);
+
+    return (uint8_t)((g_registers[REG_ALARMCFG] >> REG_ALARMCFG_SHIFT(channel)) & REG_ALARMCFG_MASK);
+}
+
+/**
+ * \brief Clears the alarm configuration change flag.
  *
  * \return void.
  */
-void registers_updateGPIO(uint8_t gpioVal)
+void registers_clearAlarmConfigFlag(void)
 {
-    g_registers[REG_GPIO] = gpioVal;
+    g_alarmConfigHandled = g_alarmConfigWrites;
+}
+
+/**
+ * \brief Indicates whether the alarm configuration has been modified.
+ *
+ * \return true if REG_ALARMCFG or a threshold register was written; false otherwise.
+ */
+bool registers_alarmConfigChanged(void)
+{
+    return g_alarmConfigWrites != g_alarmConfigHandled;
 }
 
 /**
- * \brief Updates the ADC register for the specified channel.
+ * \brief Latches the alarm bits of the channels that tripped their thresholds.
  *
- * \param[in] channel  ADC channel number (0 or 1).
- * \param[in] adcVal   8-bit value from the ADC conversion.
+ * \param[in] channelMask Bit n set if channel n tripped its alarm.
  *
  * \return void.
  */
-void registers_updateADC(uint8_t channel, uint8_t adcVal)
+void registers_latchAlarm(uint8_t channelMask)
 {
-    if (channel == 0U)
+    uint8_t channel;
+
+    for (channel = 0U; channel < REG_ALARM_CHANNELS; channel++)
     {
-        g_registers[REG_ADC0] = adcVal;
+        if ((channelMask & (1U << channel)) != 0U)
+        {
+            g_alarmLatched[channel] = true;
+        }
     }
-    else if (channel == 1U)
+}
+
+/**
+ * \brief Queues a GPIO edge record.
+ *
+ * \details Runs in the PORT ISR (single producer). The record is written before
+ *          g_edgeHead is advanced, so the consumer never sees a partial record.
+ *
+ * \param[in] input     Input number (bit of REG_GPIO).
+ * \param[in] rising    true for a rising edge, false for a falling edge.
+ * \param[in] timestamp Time of the edge, in timebase ticks.
+ *
+ * \return void.
+ */
+void registers_pushEdge(uint8_t input, bool rising, uint32_t timestamp)
+{
+    uint32_t head = g_edgeHead;
+    volatile edge_record_t *record;
+
+    if ((head - g_edgeTail) >= EDGE_QUEUE_LEN)
     {
-        g_registers[REG_ADC1] = adcVal;
+        g_edgeLost++;
+        return;
     }
+
+    record = &g_edgeQueue[head & (EDGE_QUEUE_LEN - 1U)];
+    record->timestamp = timestamp;
+    record->info = (uint8_t)((input & REG_EDGE_INPUT_MASK) | (rising ? REG_EDGE_RISING : 0U));
+    g_edgeHead = head + 1U;
 }
 
 /**
- * \brief Returns the current SPI configuration register value.
+ * \brief Publishes the debounced GPIO state and counts its transitions.
  *
- * \return The value stored in the SPI configuration register.
+ * \param[in] state   Debounced state of the 8 GPIO pins.
+ * \param[in] changed Bit n set if pin n changed since the previous call.
+ *
+ * \return void.
  */
-uint8_t registers_getConfig(void)
+void registers_updateDebounced(uint8_t state, uint8_t changed)
 {
-    return g_registers[REG_SPICFG];
+    uint8_t pin;
+
+    for (pin = 0U; pin < REG_TRANS_COUNT; pin++)
+    {
+        if ((changed & (1U << pin)) != 0U)
+        {
+            g_transitions[pin]++;
+        }
+    }
+    g_debounced = state;
 }
 
 /**
- * \brief Writes a new value to the SPI configuration register and marks a change.
+ * \brief Returns the debounce length.
  *
- * \param[in] newConfig  New configuration value.
+ * \return The value stored in REG_DEBOUNCE_N.
+ */
+uint8_t registers_getDebounceSamples(void)
+{
+    return g_registers[REG_DEBOUNCE_N];
+}
+
+/**
+ * \brief Returns the PORT digital filter width.
  *
- * \return void.
+ * \return The value stored in REG_DIGFILTER.
  */
-void registers_setConfig(uint8_t newConfig)
+uint8_t registers_getDigitalFilter(void)
 {
-    g_registers[REG_SPICFG] = newConfig;
-    g_configChanged = true;
+    return g_registers[REG_DIGFILTER];
+}
+
+/**
+ * \brief Returns the stage selected for the timing diagnostics window.
+ *
+ * \return The value stored in REG_PROF_STAGE.
+ */
+uint8_t registers_getProfileStage(void)
+{
+    return g_registers[REG_PROF_STAGE];
 }
 
 /**
- * \brief Clears the configuration change flag.
+ * \brief Clears the debounce configuration change flag.
  *
  * \return void.
  */
-void registers_clearConfigFlag(void)
+void registers_clearDebounceConfigFlag(void)
 {
-    g_configChanged = false;
+    g_debounceConfigHandled = g_debounceConfigWrites;
 }
 
 /**
- * \brief Indicates whether the SPI configuration register has been modified.
+ * \brief Indicates whether the debounce configuration has been modified.
  *
- * \return true if the configuration register was changed; false otherwise.
+ * \return true if REG_DEBOUNCE_N or REG_DIGFILTER was written; false otherwise.
  */
-bool registers_configChanged(void)
+bool registers_debounceConfigChanged(void)
 {
-    return g_configChanged;
+    return g_debounceConfigWrites != g_debounceConfigHandled;
 }
 
 /**
@@ -163,16 +1304,26 @@ bool registers_configChanged(void)
  */
 uint8_t registers_read(uint8_t regIndex)
 {
-    if (regIndex < NUM_REGISTERS)
+    if (regIndex >= NUM_REGISTERS)
+    {
+        return 0U;
+    }
+    if (g_registerMap[regIndex].onRead != NULL)
     {
-        return g_registers[regIndex];
+        return g_registerMap[regIndex].onRead(regIndex);
     }
-    return 0U;
+    return g_registers[regIndex];
 }
 
 /**
  * \brief Writes a value to a register.
  *
+ * \details One lookup in g_registerMap decides the outcome: writes to RO
+ *          registers and values outside the accepted range are ignored, a write
+ *          hook (REG_ALARM write-1-to-clear, REG_SPICFG aliases) handles the
+ *          value itself, and any other value is stored and counted in the write
+ *          counter of the register.
+ *
  * \param[in] regIndex  The index of the register to write to.
  * \param[in] value     The value to write.
  *
@@ -180,13 +1331,28 @@ uint8_t registers_read(uint8_t regIndex)
  */
 void registers_write(uint8_t regIndex, uint8_t value)
 {
-    if (regIndex < NUM_REGISTERS)
+    const register_desc_t *desc;
+
+    if (regIndex >= NUM_REGISTERS)
     {
-        g_registers[regIndex] = value;
-        if (regIndex == REG_SPICFG)
-        {
-            g_configChanged = true;
-        }
+        return;
+    }
+
+    desc = &g_registerMap[regIndex];
+    if ((desc->access == REG_ACCESS_RO) || (value < desc->minValue) || (value > desc->maxValue))
+    {
+        return;
+    }
+    if (desc->onWrite != NULL)
+    {
+        desc->onWrite(regIndex, value);
+        return;
+    }
+
+    g_registers[regIndex] = value;
+    if (desc->writes != NULL)
+    {
+        (*desc->writes)++;
     }
 }
 
@@ -195,8 +1361,14 @@ void registers_write(uint8_t regIndex, uint8_t value)
  *
  * \details This function implements a simple state machine:
  *          - If waiting for the register index, the received byte is stored as the index.
- *          - Otherwise, the received byte is written to the previously stored register,
- *            and the state machine resets.
+ *          - Otherwise, the write of the received byte to the previously stored
+ *            register is staged, and the state machine resets. The staged writes
+ *            are committed by registers_endTransaction(); writes past
+ *            WRITE_STAGE_LEN in one transaction are dropped.
+ *          With PEC, every byte is held back until the next one arrives: only
+ *          then is it known to be data. The byte still held on STOP is the
+ *          PEC; on a repeated START it is data, since the write phase of a
+ *          combined read carries no PEC.
  *
  * \param[in] byteReceived  The byte received via IC.
  *
@@ -204,18 +1376,199 @@ void registers_write(uint8_t regIndex, uint8_t value)
  */
 void registers_processByte(uint8_t byteReceived)
 {
-    if (!g_waitingForData)
+    if (g_bank == REG_BANK_STATUS)
     {
-        /* First byte: treat it as the register index */
-        g_currentRegIndex = byteReceived;
-        g_waitingForData = true;
+        /* The status bank is read-only */
+        return;
+    }
+
+    if (!g_pecActive)
+    {
+        registers_parseByte(byteReceived);
+        return;
+    }
+
+    if (g_pecHolding)
+    {
+        g_pecCrc = g_crc8Table[g_pecCrc ^ g_pecHeld];
+        registers_parseByte(g_pecHeld);
     }
     else
     {
-        /* Second byte: treat it as data to write into the register */
-        registers_write(g_currentRegIndex, byteReceived);
-        g_waitingForData = false;
+        g_pecCrc = g_crc8Table[REG_BANK_MAP_ADDRESS << 1U];
+        g_pecHolding = true;
+    }
+    g_pecHeld = byteReceived;
+}
+
+/**
+ * \brief Returns the block transmitted for an IC read.
+ *
+ * \details Called from the IC slave ISR on a read address match. The front
+ *          frame is latched and the block starts at the current index, so the
+ *          whole read is served from one frame by eDMA. The block ends with the
+ *          map, and the bytes read past it are 0. With PEC, the block has the
+ *          fixed read length of its first register and is followed by one PEC
+ *          byte. A read that starts at
+ *          REG_EDGE_FIFO returns up to EDGE_BLOCK_RECORDS edge records instead;
+ *          REG_EDGE_FIFO only reached by auto-increment reads 0, so a whole-map
+ *          burst never drains the queue. On REG_BANK_STATUS the block is the
+ *          status bytes.
+ *
+ * \param[out] block First byte of the block.
+ *
+ * \return The length of the block, in bytes.
+ */
+uint32_t registers_readBlock(const uint8_t **block)
+{
+    const uint8_t *data = NULL;
+    uint32_t length = 0U;
+    uint8_t *pecBlock;
+
+    registers_latchReadFrame();
+
+    if (g_bank == REG_BANK_STATUS)
+    {
+        data = g_statusFrame;
+        length = REG_STATUS_LEN;
+    }
+    else if (g_edgeStreaming)
+    {
+        data = g_edgeBlock;
+        length = sizeof(g_edgeBlock);
+    }
+    else if (g_currentRegIndex < NUM_REGISTERS)
+    {
+        data = &g_readFrame[g_currentRegIndex];
+        length = g_pecActive ? registers_pecReadLength(g_currentRegIndex)
+                             : ((uint32_t)NUM_REGISTERS - g_currentRegIndex);
+    }
+    g_readLength = length;
+
+    if (g_pecActive && (length > 0U))
+    {
+        length = registers_addPec(data, length, &pecBlock);
+        data = pecBlock;
+    }
+    *block = data;
+    return length;
+}
+
+/**
+ * \brief Starts an IC transaction on one of the register banks.
+ *
+ * \details Called from the IC slave ISR on address match, before the first
+ *          byte. A status bank read always starts at its first byte. REG_PEC
+ *          is sampled here, so a write to it applies from the next transaction.
+ *
+ * \param[in] bank REG_BANK_MAP or REG_BANK_STATUS.
+ *
+ * \return void.
+ */
+void registers_startTransaction(uint8_t bank)
+{
+    g_bank = (bank == REG_BANK_STATUS) ? REG_BANK_STATUS : REG_BANK_MAP;
+    g_pecActive = (g_registers[REG_PEC] != REG_PEC_OFF);
+    g_pecHolding = false;
+    g_pecRegIndex = g_currentRegIndex;
+}
+
+/**
+ * \brief Ends the current IC transaction.
+ *
+ * \details Called on STOP or repeated START. A transaction that only carried the
+ *          register index keeps g_currentRegIndex but returns the state machine to
+ *          waiting for a new index. The writes staged by the transaction are
+ *          committed in order, so the main loop sees all of them or none. A map read advances
+ *          the index by the bytes read, stopping at the end of the map. The edge
+ *          records an edge read reached are drained, including one left
+ *          partially read; the others stay queued for the next read.
+ *          With PEC, a write ended by STOP is only committed if its last byte
+ *          matches the PEC of the address byte and the bytes before it;
+ *          otherwise its writes are dropped, the register index is restored
+ *          and the error counted. A write ended by a repeated START carries no
+ *          PEC: its register index is kept and its PEC carried into the read,
+ *          but its data writes cannot be checked and are rejected. The PEC
+ *          byte of a read is not counted in the bytes read.
+ *
+ * \param[in] bytesRead     Number of bytes of the block fetched for the master.
+ * \param[in] repeatedStart true if the transaction ended with a repeated START.
+ *
+ * \return void.
+ */
+void registers_endTransaction(uint32_t bytesRead, bool repeatedStart)
+{
+    uint32_t records;
+    uint32_t configWrites;
+    uint8_t i;
+    bool chained = false;
+
+    if (g_pecHolding && repeatedStart)
+    {
+        /* Write phase of a combined read: the held byte is data */
+        g_pecCrc = g_crc8Table[g_pecCrc ^ g_pecHeld];
+        registers_parseByte(g_pecHeld);
+        if (g_stagedCount > 0U)
+        {
+            g_stagedCount = 0U;
+            g_pecErrors++;
+        }
+        chained = true;
+    }
+    else if (g_pecHolding && (g_pecCrc != g_pecHeld))
+    {
+        g_stagedCount = 0U;
+        g_currentRegIndex = g_pecRegIndex;
+        g_pecErrors++;
+    }
+    if (bytesRead > g_readLength)
+    {
+        bytesRead = g_readLength;
+    }
+
+    if (g_stagedCount > 0U)
+    {
+        configWrites = g_configWrites;
+        for (i = 0U; i < g_stagedCount; i++)
+        {
+            registers_write(g_stagedIndex[i], g_stagedValue[i]);
+        }
+        if (g_configWrites != configWrites)
+        {
+            g_configUpdates++;
+        }
+        g_stagedCount = 0U;
+        REG_COMPILER_BARRIER();
+        g_commitCount++;
+    }
+
+    if (g_edgeStreaming)
+    {
+        records = (bytesRead + REG_EDGE_RECORD_LEN - 1U) / REG_EDGE_RECORD_LEN;
+        if (records > g_edgeBlockRecords)
+        {
+            records = g_edgeBlockRecords;
+        }
+        g_edgeTail = g_edgeTail + records;
     }
+    else if ((g_bank == REG_BANK_MAP) && (bytesRead > 0U))
+    {
+        if (bytesRead >= ((uint32_t)NUM_REGISTERS - g_currentRegIndex))
+        {
+            g_currentRegIndex = NUM_REGISTERS;
+        }
+        else
+        {
+            g_currentRegIndex = (uint8_t)(g_currentRegIndex + bytesRead);
+        }
+    }
+
+    g_waitingForData = false;
+    g_edgeStreaming = false;
+    g_edgeBlockRecords = 0U;
+    g_readLength = 0U;
+    g_pecHolding = false;
+    g_pecChained = chained;
 }
 
 /*******************************************************************************
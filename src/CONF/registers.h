@@ -7,7 +7,9 @@
  *   This module provides a simple register map to store configuration and data
  *   accessible via IC. It also includes a state machine to process incoming
  *   IC bytes: the first byte sets the register index, and the second is used to
- *   write data to that register.
+ *   write data to that register. Reads return the register at the current index
+ *   and auto-increment it, so the whole map can be fetched in one burst. Each
+ *   read transaction is served from one coherent, published frame.
  *
  *   This software is provided free of charge.
  *
@@ -24,14 +26,188 @@
 /******************************************************************************/
 /** \brief Register for reading 8 GPIO pins */
 #define REG_GPIO   0
-/** \brief Register for reading ADC channel 0 */
+/** \brief Register for reading ADC channel 0 (8 most significant bits) */
 #define REG_ADC0   1
-/** \brief Register for reading ADC channel 1 */
+/** \brief Register for reading ADC channel 1 (8 most significant bits) */
 #define REG_ADC1   2
 /** \brief Register for SPI configuration to be sent via SPI */
 #define REG_SPICFG 3
+/** \brief Register for reading ADC channel 0, full resolution, high byte */
+#define REG_ADC0_H 4
+/** \brief Register for reading ADC channel 0, full resolution, low byte */
+#define REG_ADC0_L 5
+/** \brief Register for reading ADC channel 1, full resolution, high byte */
+#define REG_ADC1_H 6
+/** \brief Register for reading ADC channel 1, full resolution, low byte */
+#define REG_ADC1_L 7
+/** \brief Register selecting the ADC noise reduction mode (REG_ADCMODE_x) */
+#define REG_ADCMODE 8
+/** \brief Register enabling the ADC threshold alarms (2 bits per channel, REG_ALARMCFG_x) */
+#define REG_ALARMCFG 9
+/** \brief Register for ADC channel 0 low threshold, high byte */
+#define REG_ADC0_LOW_H 10
+/** \brief Register for ADC channel 0 low threshold, low byte */
+#define REG_ADC0_LOW_L 11
+/** \brief Register for ADC channel 0 high threshold, high byte */
+#define REG_ADC0_HIGH_H 12
+/** \brief Register for ADC channel 0 high threshold, low byte */
+#define REG_ADC0_HIGH_L 13
+/** \brief Register for ADC channel 1 low threshold, high byte */
+#define REG_ADC1_LOW_H 14
+/** \brief Register for ADC channel 1 low threshold, low byte */
+#define REG_ADC1_LOW_L 15
+/** \brief Register for ADC channel 1 high threshold, high byte */
+#define REG_ADC1_HIGH_H 16
+/** \brief Register for ADC channel 1 high threshold, low byte */
+#define REG_ADC1_HIGH_L 17
+/** \brief Register of latched ADC alarms (bit n = channel n), write 1 to clear */
+#define REG_ALARM 18
+/** \brief Register for reading the number of queued GPIO edge records (saturates at 255) */
+#define REG_EDGE_COUNT 19
+/** \brief Register for reading the number of GPIO edge records lost on overflow (modulo 256) */
+#define REG_EDGE_LOST 20
+/** \brief Register for draining the GPIO edge queue, REG_EDGE_RECORD_LEN bytes per record */
+#define REG_EDGE_FIFO 21
+/** \brief Register for reading the debounced state of the 8 GPIO pins */
+#define REG_DEBOUNCED 22
+/** \brief Register for the debounce length, in 1 ms ticks (1..255) */
+#define REG_DEBOUNCE_N 23
+/** \brief Register for the PORT digital filter width, in LPO cycles (0 = off, 1..31) */
+#define REG_DIGFILTER 24
+/** \brief Register for reading the debounced transition counter of GPIO pin 0 (modulo 256) */
+#define REG_TRANS0 25
+/** \brief Register for reading the debounced transition counter of GPIO pin 7 (modulo 256) */
+#define REG_TRANS7 32
+/** \brief Register for reading the number of scheduler deadline overruns (modulo 256) */
+#define REG_OVERRUNS 33
+/** \brief Register for SPI configuration of chained ISO1H816G device 1 */
+#define REG_SPICFG1 34
+/** \brief Register for SPI configuration of chained ISO1H816G device 7 */
+#define REG_SPICFG7 40
+/** \brief Register for the number of chained ISO1H816G devices (1..REG_SPICHAIN_MAX) */
+#define REG_SPICHAIN 41
+/** \brief Register for reading the SPI SCK frequency in kHz, high byte */
+#define REG_SPIKHZ_H 42
+/** \brief Register for reading the SPI SCK frequency in kHz, low byte */
+#define REG_SPIKHZ_L 43
+/** \brief Register for reading the fastest supported IC SCL frequency in kHz, high byte */
+#define REG_I2CKHZ_H 44
+/** \brief Register for reading the fastest supported IC SCL frequency in kHz, low byte */
+#define REG_I2CKHZ_L 45
+/** \brief Register selecting the IC bus mode of the slave timing (REG_I2CMODE_x) */
+#define REG_I2CMODE 46
+/** \brief Write-only alias: bits written as 1 are set in REG_SPICFG (reads 0) */
+#define REG_SPICFG_SET 47
+/** \brief Write-only alias: bits written as 1 are cleared in REG_SPICFG (reads 0) */
+#define REG_SPICFG_CLR 48
+/** \brief Write-only alias: bits written as 1 are toggled in REG_SPICFG (reads 0) */
+#define REG_SPICFG_TGL 49
+/** \brief Register for reading the number of SPI configuration frames sent (modulo 256) */
+#define REG_SPI_SENT 50
+/** \brief Register for reading the number of configuration updates superseded by a later one before being sent (modulo 256) */
+#define REG_SPI_COALESCED 51
+/** \brief Register for reading the number of SPI updates skipped as identical to the last frame (modulo 256) */
+#define REG_SPI_SKIPPED 52
+/** \brief Register enabling SMBus packet error checking on the IC transactions (REG_PEC_x) */
+#define REG_PEC 53
+/** \brief Register for reading the number of writes rejected on a PEC mismatch (modulo 256) */
+#define REG_PEC_ERRORS 54
+/** \brief Register selecting the stage shown in the timing diagnostics window (0..REG_PROF_STAGES-1) */
+#define REG_PROF_STAGE 55
+/** \brief First register of the timing diagnostics window (REG_PROF_WINDOW_LEN bytes, REG_PROF_x offsets) */
+#define REG_PROF_WINDOW 56
 /** \brief Total number of registers available */
-#define NUM_REGISTERS 4
+#define NUM_REGISTERS 104
+
+/** \brief REG_ADCMODE: one conversion per sample (default) */
+#define REG_ADCMODE_SINGLE     0U
+/** \brief REG_ADCMODE: hardware average of 4 conversions */
+#define REG_ADCMODE_HW_AVG_4   1U
+/** \brief REG_ADCMODE: hardware average of 8 conversions */
+#define REG_ADCMODE_HW_AVG_8   2U
+/** \brief REG_ADCMODE: hardware average of 16 conversions */
+#define REG_ADCMODE_HW_AVG_16  3U
+/** \brief REG_ADCMODE: hardware average of 32 conversions */
+#define REG_ADCMODE_HW_AVG_32  4U
+/** \brief REG_ADCMODE: software oversample and decimate, 14-bit values */
+#define REG_ADCMODE_OVERSAMPLE 5U
+
+/** \brief REG_ALARMCFG field of a channel: alarm disabled */
+#define REG_ALARMCFG_OFF     0U
+/** \brief REG_ALARMCFG field of a channel: alarm above the high threshold */
+#define REG_ALARMCFG_HIGH    1U
+/** \brief REG_ALARMCFG field of a channel: alarm below the low threshold */
+#define REG_ALARMCFG_LOW     2U
+/** \brief REG_ALARMCFG field of a channel: alarm outside [low, high] */
+#define REG_ALARMCFG_WINDOW  3U
+/** \brief Width mask of a REG_ALARMCFG field */
+#define REG_ALARMCFG_MASK    3U
+/** \brief Bit position of the REG_ALARMCFG field of a channel */
+#define REG_ALARMCFG_SHIFT(channel) ((channel) * 2U)
+
+/** \brief Number of ADC channels with a threshold alarm */
+#define REG_ALARM_CHANNELS 2U
+
+/** \brief Length of a GPIO edge record read from REG_EDGE_FIFO, in bytes */
+#define REG_EDGE_RECORD_LEN 5U
+/** \brief Edge record byte 0: record valid (0 when the queue was empty) */
+#define REG_EDGE_VALID   0x80U
+/** \brief Edge record byte 0: rising edge (falling when clear) */
+#define REG_EDGE_RISING  0x40U
+/** \brief Edge record byte 0: input number (bit of REG_GPIO) */
+#define REG_EDGE_INPUT_MASK 0x07U
+
+/** \brief Number of GPIO pins with a transition counter */
+#define REG_TRANS_COUNT 8U
+/** \brief Reset value of REG_DEBOUNCE_N (5 ms) */
+#define REG_DEBOUNCE_N_DEFAULT 5U
+/** \brief Largest value accepted by REG_DIGFILTER */
+#define REG_DIGFILTER_MAX 31U
+
+/** \brief REG_I2CMODE: Standard-mode timing (100 kHz) */
+#define REG_I2CMODE_STANDARD  0U
+/** \brief REG_I2CMODE: Fast-mode timing (400 kHz, default) */
+#define REG_I2CMODE_FAST      1U
+/** \brief REG_I2CMODE: Fast-mode Plus timing (1 MHz, refused where the LPI2C lacks it) */
+#define REG_I2CMODE_FAST_PLUS 2U
+
+/** \brief Largest number of chained ISO1H816G devices (REG_SPICFG, REG_SPICFG1..7) */
+#define REG_SPICHAIN_MAX 8U
+/** \brief Reset value of REG_SPICHAIN (single device) */
+#define REG_SPICHAIN_DEFAULT 1U
+
+/** \brief REG_PEC: transactions without packet error checking (default) */
+#define REG_PEC_OFF 0U
+/** \brief REG_PEC: SMBus PEC, writes end with one PEC byte and fixed-length reads are followed by one */
+#define REG_PEC_ON  1U
+
+/** \brief Number of stages with timing statistics (REG_PROF_STAGE) */
+#define REG_PROF_STAGES     5U
+/** \brief Number of log2 histogram bins of the timing diagnostics window */
+#define REG_PROF_HIST_BINS  16U
+/** \brief Window offset: number of durations recorded (32 bits, most significant byte first) */
+#define REG_PROF_COUNT      0U
+/** \brief Window offset: shortest duration, in core clock cycles (32 bits) */
+#define REG_PROF_MIN        4U
+/** \brief Window offset: longest duration, in core clock cycles (32 bits) */
+#define REG_PROF_MAX        8U
+/** \brief Window offset: mean duration, in core clock cycles (32 bits) */
+#define REG_PROF_MEAN       12U
+/** \brief Window offset: histogram, REG_PROF_HIST_BINS counts of 16 bits */
+#define REG_PROF_HIST       16U
+/** \brief Length of the timing diagnostics window, in bytes */
+#define REG_PROF_WINDOW_LEN (REG_PROF_HIST + (2U * REG_PROF_HIST_BINS))
+
+/** \brief Register bank served at the primary IC address (register map) */
+#define REG_BANK_MAP    0U
+/** \brief Register bank served at the secondary IC address (status bytes) */
+#define REG_BANK_STATUS 1U
+/** \brief Number of bytes read from the status bank, in the order of the registers below */
+#define REG_STATUS_LEN  8U
+/** \brief 7-bit IC address of REG_BANK_MAP, covered by the PEC */
+#define REG_BANK_MAP_ADDRESS    0x3AU
+/** \brief 7-bit IC address of REG_BANK_STATUS, covered by the PEC */
+#define REG_BANK_STATUS_ADDRESS 0x3BU
 
 /******************************************************************************/
 /*         Declaration of exported function prototypes                      */
@@ -57,14 +233,80 @@ void registers_init(void);
 void registers_updateGPIO(uint8_t gpioVal);
 
 /**
- * \brief Updates the ADC register corresponding to the specified channel.
+ * \brief Updates the ADC registers corresponding to the specified channel.
+ *
+ * \details The full-resolution value is stored big-endian in REG_ADCx_H/REG_ADCx_L
+ *          and its 8 most significant bits in REG_ADCx.
+ *
+ * \param[in] channel        ADC channel number (0 or 1).
+ * \param[in] adcVal         Value from the ADC conversion.
+ * \param[in] resolutionBits Resolution of adcVal, in bits (12, or 14 when oversampling).
+ *
+ * \return void.
+ */
+void registers_updateADC(uint8_t channel, uint16_t adcVal, uint8_t resolutionBits);
+
+/**
+ * \brief Updates the scheduler overrun counter register.
+ *
+ * \param[in] overruns Number of deadline overruns, modulo 256.
+ *
+ * \return void.
+ */
+void registers_updateOverruns(uint8_t overruns);
+
+/**
+ * \brief Updates the SPI output update counter registers.
+ *
+ * \param[in] sent      Frames transmitted, modulo 256.
+ * \param[in] coalesced Configuration updates superseded before transmission, modulo 256.
+ * \param[in] skipped   Updates identical to the last frame sent, modulo 256.
+ *
+ * \return void.
+ */
+void registers_updateSpiStats(uint8_t sent, uint8_t coalesced, uint8_t skipped);
+
+/**
+ * \brief Updates the bus rate status registers.
+ *
+ * \param[in] spiHz SPI SCK frequency achieved, in Hz.
+ * \param[in] i2cHz Fastest IC SCL frequency supported by the slave, in Hz.
+ *
+ * \return void.
+ */
+void registers_updateBusRates(uint32_t spiHz, uint32_t i2cHz);
+
+/**
+ * \brief Updates the timing diagnostics window.
  *
- * \param[in] channel  ADC channel number (0 or 1).
- * \param[in] adcVal   8-bit value derived from the ADC conversion.
+ * \param[in] count      Number of durations recorded.
+ * \param[in] minCycles  Shortest duration, in core clock cycles.
+ * \param[in] maxCycles  Longest duration, in core clock cycles.
+ * \param[in] meanCycles Mean duration, in core clock cycles.
+ * \param[in] histogram  REG_PROF_HIST_BINS duration counts.
  *
  * \return void.
  */
-void registers_updateADC(uint8_t channel, uint8_t adcVal);
+void registers_updateProfile(uint32_t count, uint32_t minCycles, uint32_t maxCycles,
+                             uint32_t meanCycles, const uint16_t *histogram);
+
+/**
+ * \brief Retrieves the stage selected for the timing diagnostics window.
+ *
+ * \return The value stored in REG_PROF_STAGE.
+ */
+uint8_t registers_getProfileStage(void);
+
+/**
+ * \brief Publishes the values acquired in the current cycle.
+ *
+ * \details Must be called by the main loop once all GPIO/ADC registers of an
+ *          acquisition cycle have been updated. IC reads only ever see complete
+ *          published frames, never a partially updated one.
+ *
+ * \return void.
+ */
+void registers_publish(void);
 
 /**
  * \brief Retrieves the current configuration for the SPI.
@@ -74,7 +316,19 @@ void registers_updateADC(uint8_t channel, uint8_t adcVal);
 uint8_t registers_getConfig(void);
 
 /**
- * \brief Writes a new value to the SPI configuration register and marks the configuration as changed.
+ * \brief Retrieves the SPI configuration of the whole chain of ISO1H816G devices.
+ *
+ * \details Device 0 is configured by REG_SPICFG and device n by REG_SPICFGn.
+ *
+ * \param[out] config Configuration of each device, device 0 first. Must hold
+ *                    REG_SPICHAIN_MAX bytes.
+ *
+ * \return The number of chained devices (REG_SPICHAIN).
+ */
+uint8_t registers_getChainConfig(uint8_t *config);
+
+/**
+ * \brief Writes a new value to the SPI configuration register and counts it as a configuration write.
  *
  * \param[in] newConfig  New configuration value.
  *
@@ -83,18 +337,172 @@ uint8_t registers_getConfig(void);
 void registers_setConfig(uint8_t newConfig);
 
 /**
- * \brief Clears the configuration change flag.
+ * \brief Returns the number of writes to the SPI configuration.
+ *
+ * \details Counts the writes to a SPI configuration register, one of its alias
+ *          registers or REG_SPICHAIN. The count is only ever incremented, so
+ *          the caller detects changes by comparing it with the count it has
+ *          already handled; the difference is the number of writes since.
+ *
+ * \return The write count, modulo 2^32.
+ */
+uint32_t registers_getConfigWrites(void);
+
+/**
+ * \brief Returns the number of SPI configuration updates.
+ *
+ * \details Counts the committed IC write transactions that wrote the SPI
+ *          configuration, once each however many configuration registers
+ *          they wrote, and the calls to registers_setConfig(). Updates beyond
+ *          the first one since the last frame are superseded before being sent.
+ *
+ * \return The update count, modulo 2^32.
+ */
+uint32_t registers_getConfigUpdates(void);
+
+/**
+ * \brief Retrieves the selected ADC noise reduction mode.
+ *
+ * \return The value stored in REG_ADCMODE (one of REG_ADCMODE_x).
+ */
+uint8_t registers_getADCMode(void);
+
+/**
+ * \brief Clears the ADC mode change flag.
+ *
+ * \return void.
+ */
+void registers_clearADCModeFlag(void);
+
+/**
+ * \brief Returns whether the ADC mode has been modified.
+ *
+ * \return true if REG_ADCMODE was written; false otherwise.
+ */
+bool registers_adcModeChanged(void);
+
+/**
+ * \brief Retrieves the selected IC bus mode.
+ *
+ * \return The value stored in REG_I2CMODE (one of REG_I2CMODE_x).
+ */
+uint8_t registers_getI2CMode(void);
+
+/**
+ * \brief Stores the IC bus mode in effect, without marking a change.
+ *
+ * \details Used to report the mode actually applied when a request is refused.
+ *
+ * \param[in] mode One of REG_I2CMODE_x.
+ *
+ * \return void.
+ */
+void registers_setI2CMode(uint8_t mode);
+
+/**
+ * \brief Clears the IC mode change flag.
+ *
+ * \return void.
+ */
+void registers_clearI2CModeFlag(void);
+
+/**
+ * \brief Returns whether the IC bus mode has been modified.
+ *
+ * \return true if REG_I2CMODE was written; false otherwise.
+ */
+bool registers_i2cModeChanged(void);
+
+/**
+ * \brief Retrieves the threshold alarm settings of an ADC channel.
+ *
+ * \param[in]  channel ADC channel number (0 or 1).
+ * \param[out] low     Low threshold, in codes.
+ * \param[out] high    High threshold, in codes.
+ *
+ * \return The alarm condition of the channel (one of REG_ALARMCFG_x).
+ */
+uint8_t registers_getADCAlarm(uint8_t channel, uint16_t *low, uint16_t *high);
+
+/**
+ * \brief Clears the alarm configuration change flag.
  *
  * \return void.
  */
-void registers_clearConfigFlag(void);
+void registers_clearAlarmConfigFlag(void);
 
 /**
- * \brief Returns whether the configuration has been modified.
+ * \brief Returns whether the alarm configuration has been modified.
  *
- * \return true if the configuration register was changed; false otherwise.
+ * \return true if REG_ALARMCFG or a threshold register was written; false otherwise.
  */
-bool registers_configChanged(void);
+bool registers_alarmConfigChanged(void);
+
+/**
+ * \brief Latches the alarm bits of the channels that tripped their thresholds.
+ *
+ * \details Called from interrupt context. The bits stay set in REG_ALARM until the
+ *          master clears them by writing 1.
+ *
+ * \param[in] channelMask Bit n set if channel n tripped its alarm.
+ *
+ * \return void.
+ */
+void registers_latchAlarm(uint8_t channelMask);
+
+/**
+ * \brief Queues a GPIO edge record.
+ *
+ * \details Called from the PORT interrupt (single producer). The record is
+ *          dropped, and REG_EDGE_LOST incremented, if the queue is full.
+ *
+ * \param[in] input     Input number (bit of REG_GPIO).
+ * \param[in] rising    true for a rising edge, false for a falling edge.
+ * \param[in] timestamp Time of the edge, in timebase ticks.
+ *
+ * \return void.
+ */
+void registers_pushEdge(uint8_t input, bool rising, uint32_t timestamp);
+
+/**
+ * \brief Publishes the debounced GPIO state and counts its transitions.
+ *
+ * \details Called from the debounce tick interrupt (single writer).
+ *
+ * \param[in] state   Debounced state of the 8 GPIO pins.
+ * \param[in] changed Bit n set if pin n changed since the previous call.
+ *
+ * \return void.
+ */
+void registers_updateDebounced(uint8_t state, uint8_t changed);
+
+/**
+ * \brief Retrieves the debounce length.
+ *
+ * \return The value stored in REG_DEBOUNCE_N, in ticks.
+ */
+uint8_t registers_getDebounceSamples(void);
+
+/**
+ * \brief Retrieves the PORT digital filter width.
+ *
+ * \return The value stored in REG_DIGFILTER, in LPO cycles.
+ */
+uint8_t registers_getDigitalFilter(void);
+
+/**
+ * \brief Clears the debounce configuration change flag.
+ *
+ * \return void.
+ */
+void registers_clearDebounceConfigFlag(void);
+
+/**
+ * \brief Returns whether the debounce configuration has been modified.
+ *
+ * \return true if REG_DEBOUNCE_N or REG_DIGFILTER was written; false otherwise.
+ */
+bool registers_debounceConfigChanged(void);
 
 /**
  * \brief Reads the value stored in the specified register.
@@ -108,6 +516,10 @@ uint8_t registers_read(uint8_t regIndex);
 /**
  * \brief Writes a value to the specified register.
  *
+ * \details Applies the access rights of the register: writes to read-only
+ *          registers (acquired values, counters, bus rates) and values outside
+ *          the range accepted by the register are ignored.
+ *
  * \param[in] regIndex  The index of the register to write to.
  * \param[in] value     The value to write.
  *
@@ -120,7 +532,10 @@ void registers_write(uint8_t regIndex, uint8_t value);
  *
  * \details Implements a simple state machine:
  *          - If no register index has been received, the received byte is treated as the register index.
- *          - Otherwise, the received byte is written into that register and the state is reset.
+ *          - Otherwise, the write of the received byte into that register is staged and the state is reset.
+ *          Several index/data pairs may follow in one transaction; their writes are
+ *          committed together by registers_endTransaction(). With REG_PEC set,
+ *          the last byte of a write ended by STOP is its PEC, not data.
  *
  * \param[in] byteReceived  The byte received via IC.
  *
@@ -128,4 +543,57 @@ void registers_write(uint8_t regIndex, uint8_t value);
  */
 void registers_processByte(uint8_t byteReceived);
 
+/**
+ * \brief Returns the block transmitted for an IC read.
+ *
+ * \details Used for the combined format: the master writes the register index,
+ *          issues a repeated START and then reads N bytes, which are taken from
+ *          consecutive registers of one published frame. Indexes past the end of
+ *          the map read as 0. A read starting at REG_EDGE_FIFO does not increment
+ *          and returns edge records. With REG_PEC set, the block has the fixed
+ *          SMBus length of the register it starts at (1 byte, a 16-bit word
+ *          from a high byte, the timing diagnostics window) and is followed by
+ *          one PEC byte, which also covers the index written before the repeated
+ *          START. The block stays valid until
+ *          registers_endTransaction().
+ *
+ * \param[out] block First byte of the block.
+ *
+ * \return The length of the block, in bytes.
+ */
+uint32_t registers_readBlock(const uint8_t **block);
+
+/**
+ * \brief Starts an IC transaction on one of the register banks.
+ *
+ * \details Called on address match. Transactions on REG_BANK_STATUS need no
+ *          register index: every read returns REG_DEBOUNCED, REG_GPIO, REG_ALARM,
+ *          REG_EDGE_COUNT, REG_ADC0_H, REG_ADC0_L, REG_ADC1_H and REG_ADC1_L, in
+ *          that order, and bytes written to it are ignored.
+ *
+ * \param[in] bank REG_BANK_MAP or REG_BANK_STATUS.
+ *
+ * \return void.
+ */
+void registers_startTransaction(uint8_t bank);
+
+/**
+ * \brief Ends the current IC transaction.
+ *
+ * \details Called on STOP or repeated START. Resets the state machine so that the
+ *          next byte written by the master is again treated as a register index,
+ *          commits the staged writes, advances the register index past the bytes
+ *          read and drains the edge records read. With REG_PEC set, a write ended
+ *          by STOP whose last byte is not its PEC is rejected as a whole and
+ *          counted in REG_PEC_ERRORS; a write ended by a repeated START has no
+ *          PEC, so only its register index is kept.
+ *
+ * \param[in] bytesRead     Number of bytes of the block fetched for the master
+ *                          (0 for a write).
+ * \param[in] repeatedStart true if the transaction ended with a repeated START.
+ *
+ * \return void.
+ */
+void registers_endTransaction(uint32_t bytesRead, bool repeatedStart);
+
 #endif /* MID_REG_REGISTERS_H_ */
@@ -7,16 +7,102 @@
 /*                                                                            */
 /*   This module provides functions for initializing the ADC, reading a     */
 /*   specified ADC channel, and converting the raw ADC value to the actual    */
-/*   input voltage. The ADC is configured for 8-bit resolution and software   */
+/*   input voltage. The ADC is configured for 12-bit resolution and software  */
 /*   triggering. The conversion accounts for an external voltage divider      */
 /*   scaling a 520 V signal to an acceptable ADC input range.                */
+/*   A scan mode is also provided: PDB0 periodically hardware-triggers both  */
+/*   channels back to back and eDMA moves every result into a ring buffer,    */
+/*   without any CPU involvement per sample.                                  */
+/*   Noise on the inputs is reduced either by the hardware averaging unit     */
+/*   (4 to 32 conversions per sample) or by oversampling and decimating the   */
+/*   ring buffer in software, which also gives two extra bits of resolution.  */
+/*   Per-channel threshold alarms are checked on every half of the ring from  */
+/*   the eDMA interrupt.                                                      */
 /*                                                                            */
 /*   This software is provided free of charge.                                                      */
 /*                                                                            */
 /******************************************************************************/
 
 #include <HAL_adc.h>
+#include <HAL_adc_conv.h>
+#include <HAL_dma.h>
 #include "adc_driver.h"
+#include "edma_driver.h"
+#include "clock_manager.h"
+#include "peripherals_adc_config_1.h"  /* adc_config_1_ConvConfig0 */
+#include "S32K144.h"
+
+/******************************************************************************/
+/*                   Definition of local symbolic constants                 */
+/******************************************************************************/
+/** \brief ADC instance used by this module. */
+#define ADC_INSTANCE          0U
+
+/** \brief Number of entries of the scan ring buffer (channels interleaved). */
+#define ADC_SCAN_BUFFER_LEN   (HAL_ADC_SCAN_DEPTH * HAL_ADC_NUM_CHANNELS)
+
+/** \brief Stride between consecutive ADC result registers R[n], in bytes. */
+#define ADC_RESULT_STRIDE     ((int16_t)sizeof(ADC0->R[0]))
+
+/** \brief PDB0 software trigger input selection (TRGSEL = 15). */
+#define PDB_TRGSEL_SOFTWARE   0xFU
+
+/** \brief Full-scale code at 8-bit resolution. */
+#define ADC_FULL_SCALE_8BIT   255U
+
+/** \brief Full-scale code at 10-bit resolution. */
+#define ADC_FULL_SCALE_10BIT  1023U
+
+/** \brief Full-scale code at 12-bit resolution. */
+#define ADC_FULL_SCALE_12BIT  4095U
+
+/** \brief ADC reference voltage, in millivolts. */
+#define ADC_VREF_MV           3300U
+
+/** \brief Fixed-point unity gain (Q16). */
+#define ADC_GAIN_Q16_ONE      65536U
+
+/** \brief PDB0 largest prescaler setting (divide by 2^7). */
+#define PDB_PRESCALER_MAX     7U
+
+/** \brief Number of entries checked by each alarm pass (half of the ring). */
+#define ADC_SCAN_HALF_LEN     (ADC_SCAN_BUFFER_LEN / 2U)
+
+/******************************************************************************/
+/*                   Definition of local types                                */
+/******************************************************************************/
+/**
+ * \brief Calibration constants of one ADC channel.
+ *
+ * \details The divider ratio is the fraction of the input voltage seen by the ADC
+ *          (dividerNum / dividerDen, 15/100 on this board).
+ */
+typedef struct
+{
+    uint32_t gainQ16;      /**< Gain correction, Q16 (65536 = 1.0). */
+    int16_t  offsetCodes;  /**< Offset subtracted from the raw code. */
+    uint16_t dividerNum;   /**< Divider ratio numerator. */
+    uint16_t dividerDen;   /**< Divider ratio denominator. */
+} adc_channel_calibration_t;
+
+/**
+ * \brief Threshold alarm settings of one channel.
+ */
+typedef struct
+{
+    volatile HAL_ADC_AlarmMode_t mode;  /**< Alarm condition, read by the eDMA ISR. */
+    volatile uint16_t low;              /**< Low threshold, in codes. */
+    volatile uint16_t high;             /**< High threshold, in codes. */
+} adc_channel_alarm_t;
+
+/******************************************************************************/
+/*                   Definition of local constants                            */
+/******************************************************************************/
+/** \brief Calibration of channels 0 and 1 (adjust per board if trimmed). */
+static const adc_channel_calibration_t s_adcCalibration[HAL_ADC_NUM_CHANNELS] = {
+    { .gainQ16 = ADC_GAIN_Q16_ONE, .offsetCodes = 0, .dividerNum = 15U, .dividerDen = 100U },
+    { .gainQ16 = ADC_GAIN_Q16_ONE, .offsetCodes = 0, .dividerNum = 15U, .dividerDen = 100U }
+};
 
 /******************************************************************************/
 /*                   Definition of local variables                            */
@@ -24,6 +110,267 @@
 /** \brief Global variable to store the ADC converter configuration. */
 static adc_converter_config_t s_adcConfig;
 
+/** \brief State of the eDMA channel used by the scan. */
+static edma_chn_state_t s_scanDmaState;
+
+/** \brief Loop configuration of the scan eDMA channel. */
+static edma_loop_transfer_config_t s_scanLoopConfig;
+
+/**
+ * \brief Scan ring buffer written by eDMA.
+ * \details Even entries hold channel 0 samples and odd entries channel 1.
+ */
+static volatile uint16_t s_scanBuffer[ADC_SCAN_BUFFER_LEN];
+
+/** \brief true while the DMA scan is running. */
+static bool s_scanRunning = false;
+
+/** \brief Selected noise reduction mode. */
+static HAL_ADC_Mode_t s_adcMode = HAL_ADC_MODE_SINGLE;
+
+/** \brief Threshold alarm settings of channels 0 and 1. */
+static adc_channel_alarm_t s_alarm[HAL_ADC_NUM_CHANNELS];
+
+/** \brief Function notified of tripped alarms, from the eDMA ISR. */
+static volatile HAL_ADC_AlarmCallback_t s_alarmCallback = NULL;
+
+/**
+ * \brief Per-channel conversion factor from ADC code to millivolts, Q16.
+ * \details Computed once in HAL_ADC_Init() for the configured resolution.
+ */
+static uint32_t s_scaleQ16[HAL_ADC_NUM_CHANNELS];
+
+/******************************************************************************/
+/*                   Definition of local functions                            */
+/******************************************************************************/
+
+/**
+ * \brief Computes the Q16 millivolts-per-code factor of every channel.
+ *
+ * \details See HAL_ADC_ComputeScaleQ16() for the formula.
+ *
+ * \return void.
+ */
+static void HAL_ADC_ComputeScales(void)
+{
+    uint8_t channel;
+
+    for (channel = 0U; channel < HAL_ADC_NUM_CHANNELS; channel++)
+    {
+        s_scaleQ16[channel] = HAL_ADC_ComputeScaleQ16(s_adcCalibration[channel].gainQ16,
+                                                      s_adcCalibration[channel].dividerNum,
+                                                      s_adcCalibration[channel].dividerDen,
+                                                      ADC_VREF_MV, HAL_ADC_GetFullScale());
+    }
+}
+
+/**
+ * \brief Oversamples and decimates the scan ring buffer of a channel.
+ *
+ * \details Sums the HAL_ADC_SCAN_DEPTH (4^2) most recent samples of the channel
+ *          and shifts the sum right by 2, which gives a 14-bit result. The samples
+ *          are read while eDMA keeps writing, so the window may mix the newest and
+ *          the oldest sample of one entry; it is a moving average either way.
+ *
+ * \param[in] channel ADC channel number (0 or 1).
+ *
+ * \return The decimated sample, with HAL_ADC_OVERSAMPLE_EXTRA_BITS extra bits.
+ */
+static uint16_t HAL_ADC_Decimate(uint8_t channel)
+{
+    uint32_t sum = 0U;
+    uint32_t index;
+
+    for (index = channel; index < ADC_SCAN_BUFFER_LEN; index += HAL_ADC_NUM_CHANNELS)
+    {
+        sum += s_scanBuffer[index];
+    }
+    return (uint16_t)(sum >> HAL_ADC_OVERSAMPLE_EXTRA_BITS);
+}
+
+/**
+ * \brief Returns whether a sample trips the alarm of its channel.
+ *
+ * \param[in] alarm  Alarm settings of the channel.
+ * \param[in] sample Raw ADC conversion result.
+ *
+ * \return true if the alarm condition is met.
+ */
+static inline bool HAL_ADC_AlarmTripped(const adc_channel_alarm_t *alarm, uint16_t sample)
+{
+    bool tripped;
+
+    switch (alarm->mode)
+    {
+        case HAL_ADC_ALARM_HIGH:
+            tripped = (sample > alarm->high);
+            break;
+        case HAL_ADC_ALARM_LOW:
+            tripped = (sample < alarm->low);
+            break;
+        case HAL_ADC_ALARM_WINDOW:
+            tripped = (sample < alarm->low) || (sample > alarm->high);
+            break;
+        default:
+            tripped = false;
+            break;
+    }
+    return tripped;
+}
+
+/**
+ * \brief eDMA callback of the scan channel, checks the alarms.
+ *
+ * \details Called on the half and complete major loop interrupts. The half of the
+ *          ring that eDMA has just finished is checked against the thresholds of
+ *          both channels while the other half is being filled, so an out-of-range
+ *          input is reported at most ADC_SCAN_HALF_LEN conversions after it
+ *          happens (4 ms at the default scan rate).
+ *
+ * \param[in] parameter Unused.
+ * \param[in] status    Channel status reported by the eDMA driver.
+ *
+ * \return void.
+ */
+static void HAL_ADC_ScanDmaCallback(void *parameter, edma_chn_status_t status)
+{
+    HAL_ADC_AlarmCallback_t callback = s_alarmCallback;
+    uint32_t remaining;
+    uint32_t first;
+    uint32_t index;
+    uint8_t tripped = 0U;
+
+    (void)parameter;
+
+    if ((status != EDMA_CHN_NORMAL) || (callback == NULL))
+    {
+        return;
+    }
+
+    /* eDMA is writing the half that contains the next entry, check the other one */
+    remaining = EDMA_DRV_GetRemainingMajorIterationsCount(HAL_DMA_CH_ADC_SCAN);
+    first = (remaining > ADC_SCAN_HALF_LEN) ? ADC_SCAN_HALF_LEN : 0U;
+
+    for (index = first; index < (first + ADC_SCAN_HALF_LEN); index++)
+    {
+        uint8_t channel = (uint8_t)(index % HAL_ADC_NUM_CHANNELS);
+
+        if (HAL_ADC_AlarmTripped(&s_alarm[channel], s_scanBuffer[index]))
+        {
+            tripped |= (uint8_t)(1U << channel);
+        }
+    }
+
+    if (tripped != 0U)
+    {
+        callback(tripped);
+    }
+}
+
+/**
+ * \brief Configures PDB0 to trigger both ADC channels periodically.
+ *
+ * \details Pre-trigger 0 starts the conversion of SC1[0] at the beginning of each
+ *          period and pre-trigger 1 is chained back to back, so SC1[1] starts as
+ *          soon as the first conversion completes. The smallest prescaler giving a
+ *          16-bit modulus is selected for the requested rate.
+ *
+ * \param[in] sampleRateHz Scan rate (pairs of samples per second).
+ *
+ * \return void.
+ */
+static void HAL_ADC_ConfigPdb(uint32_t sampleRateHz)
+{
+    uint32_t busClk = 0U;
+    uint32_t prescaler = 0U;
+    uint32_t modulus;
+
+    (void)CLOCK_SYS_GetFreq(BUS_CLK, &busClk);
+
+    modulus = busClk / sampleRateHz;
+    while (((modulus >> prescaler) > PDB_MOD_MOD_MASK) && (prescaler < PDB_PRESCALER_MAX))
+    {
+        prescaler++;
+    }
+    modulus >>= prescaler;
+    if (modulus > PDB_MOD_MOD_MASK)
+    {
+        modulus = PDB_MOD_MOD_MASK;
+    }
+    if (modulus == 0U)
+    {
+        modulus = 1U;
+    }
+
+    PDB0->SC = 0U;
+    PDB0->SC = PDB_SC_PRESCALER(prescaler) | PDB_SC_MULT(0U) |
+               PDB_SC_TRGSEL(PDB_TRGSEL_SOFTWARE) | PDB_SC_CONT(1U) | PDB_SC_PDBEN(1U);
+    PDB0->MOD = PDB_MOD_MOD(modulus - 1U);
+    PDB0->IDLY = PDB_IDLY_IDLY(0U);
+
+    /* Pre-triggers 0 and 1 enabled, 0 after DLY[0], 1 back to back after 0 */
+    PDB0->CH[0].DLY[0] = PDB_DLY_DLY(0U);
+    PDB0->CH[0].C1 = PDB_C1_EN(0x3U) | PDB_C1_TOS(0x1U) | PDB_C1_BB(0x2U);
+
+    /* Load MOD/IDLY/DLY and start the continuous sequence */
+    PDB0->SC |= PDB_SC_LDOK(1U);
+    PDB0->SC |= PDB_SC_SWTRIG(1U);
+}
+
+/**
+ * \brief Configures the eDMA channel that copies ADC results into the ring buffer.
+ *
+ * \details Each ADC DMA request (any COCO flag) moves one 16-bit result. The
+ *          source walks R[0], R[1] with an 8-byte modulo, the destination walks the
+ *          ring buffer and is rewound at the end of every major loop. Requests are
+ *          left enabled, so the loop restarts forever. The half and complete major
+ *          loop interrupts drive the threshold alarms.
+ *
+ * \return void.
+ */
+static void HAL_ADC_ConfigScanDma(void)
+{
+    edma_channel_config_t chnConfig = {
+        .channelPriority = EDMA_CHN_DEFAULT_PRIORITY,
+        .virtChnConfig = HAL_DMA_CH_ADC_SCAN,
+        .source = EDMA_REQ_ADC0,
+        .callback = HAL_ADC_ScanDmaCallback,
+        .callbackParam = NULL,
+        .enableTrigger = false
+    };
+    edma_transfer_config_t transferConfig = {
+        .srcAddr = (uint32_t)&ADC0->R[0],
+        .destAddr = (uint32_t)&s_scanBuffer[0],
+        .srcTransferSize = EDMA_TRANSFER_SIZE_2B,
+        .destTransferSize = EDMA_TRANSFER_SIZE_2B,
+        .srcOffset = ADC_RESULT_STRIDE,
+        .destOffset = (int16_t)sizeof(s_scanBuffer[0]),
+        .srcLastAddrAdjust = 0,
+        .destLastAddrAdjust = -(int32_t)sizeof(s_scanBuffer),
+        .srcModulo = EDMA_MODULO_8B,
+        .destModulo = EDMA_MODULO_OFF,
+        .minorByteTransferCount = sizeof(s_scanBuffer[0]),
+        .scatterGatherEnable = false,
+        .scatterGatherNextDescAddr = 0U,
+        .interruptEnable = true,
+        .loopTransferConfig = &s_scanLoopConfig
+    };
+
+    s_scanLoopConfig.majorLoopIterationCount = ADC_SCAN_BUFFER_LEN;
+    s_scanLoopConfig.srcOffsetEnable = false;
+    s_scanLoopConfig.dstOffsetEnable = false;
+    s_scanLoopConfig.minorLoopOffset = 0;
+    s_scanLoopConfig.minorLoopChnLinkEnable = false;
+    s_scanLoopConfig.minorLoopChnLinkNumber = 0U;
+    s_scanLoopConfig.majorLoopChnLinkEnable = false;
+    s_scanLoopConfig.majorLoopChnLinkNumber = 0U;
+
+    (void)EDMA_DRV_ChannelInit(&s_scanDmaState, &chnConfig);
+    (void)EDMA_DRV_ConfigLoopTransfer(HAL_DMA_CH_ADC_SCAN, &transferConfig);
+    EDMA_DRV_ConfigureInterrupt(HAL_DMA_CH_ADC_SCAN, EDMA_CHN_HALF_MAJOR_LOOP_INT, true);
+    (void)EDMA_DRV_StartChannel(HAL_DMA_CH_ADC_SCAN);
+}
+
 /******************************************************************************/
 /*                      Definition of exported functions                      */
 /******************************************************************************/
@@ -38,7 +385,8 @@ static adc_converter_config_t s_adcConfig;
  *
  * \return void.
  *
- * \note The ADC is configured for 8-bit resolution and software triggering.
+ * \note The ADC is configured for the resolution of the board configuration
+ *       (adc_config_1_ConvConfig0, 12-bit) and software triggering.
  */
 void HAL_ADC_Init(void)
 {
@@ -46,13 +394,13 @@ void HAL_ADC_Init(void)
     ADC_DRV_InitConverterStruct(&s_adcConfig);
 
     /* Adjust parameters if needed:
-     * - Use 8-bit resolution.
+     * - Use the board resolution (12-bit).
      * - Use software trigger.
      * - Single conversion (non-continuous).
      * - Disable DMA.
      * - Use internal voltage reference (VREF).
      */
-    s_adcConfig.resolution = ADC_RESOLUTION_8BIT;         /* 8-bit resolution */
+    s_adcConfig.resolution = adc_config_1_ConvConfig0.resolution;  /* 12-bit resolution */
     s_adcConfig.trigger = ADC_TRIGGER_SOFTWARE;           /* Software trigger */
     s_adcConfig.continuousConvEnable = false;             /* Single conversion mode */
     s_adcConfig.dmaEnable = false;                        /* DMA disabled */
@@ -63,6 +411,224 @@ void HAL_ADC_Init(void)
 
     /* Optional: Perform auto-calibration */
     ADC_DRV_AutoCalibration(0);
+
+    /* Fold reference, resolution, divider and gain into one factor per channel */
+    HAL_ADC_ComputeScales();
+}
+
+/**
+ * \brief Starts the continuous DMA scan of ADC channels 0 and 1.
+ *
+ * \details Switches the converter to hardware triggering with DMA enabled, using
+ *          the PDB trigger selections of the board configuration
+ *          (adc_config_1_ConvConfig0), assigns channel 0 to SC1[0] and channel 1 to
+ *          SC1[1], then starts the eDMA loop and the PDB. From then on samples are
+ *          acquired without CPU intervention and can be fetched with
+ *          HAL_ADC_GetLatestSample().
+ *
+ * \param[in] sampleRateHz Scan rate, in pairs of samples per second. Must be low
+ *                         enough for two conversions to fit in one period.
+ *
+ * \return void.
+ *
+ * \note HAL_DMA_Init() must have been called. HAL_ADC_ReadChannel() must not be
+ *       used while the scan is running.
+ */
+void HAL_ADC_StartScan(uint32_t sampleRateHz)
+{
+    adc_chan_config_t chanConfig;
+    uint8_t channel;
+
+    DEV_ASSERT(sampleRateHz > 0U);
+
+    /* Hardware trigger from PDB0, one DMA request per conversion */
+    s_adcConfig.trigger = ADC_TRIGGER_HARDWARE;
+    s_adcConfig.pretriggerSel = adc_config_1_ConvConfig0.pretriggerSel;
+    s_adcConfig.triggerSel = adc_config_1_ConvConfig0.triggerSel;
+    s_adcConfig.continuousConvEnable = false;
+    s_adcConfig.dmaEnable = true;
+    ADC_DRV_ConfigConverter(ADC_INSTANCE, &s_adcConfig);
+
+    /* Control channel n converts input channel n */
+    for (channel = 0U; channel < HAL_ADC_NUM_CHANNELS; channel++)
+    {
+        ADC_DRV_InitChanStruct(&chanConfig);
+        chanConfig.channel = channel;
+        chanConfig.interruptEnable = false;
+        ADC_DRV_ConfigChan(ADC_INSTANCE, channel, &chanConfig);
+    }
+
+    HAL_ADC_ConfigScanDma();
+    HAL_ADC_ConfigPdb(sampleRateHz);
+
+    s_scanRunning = true;
+}
+
+/**
+ * \brief Returns the most recent scanned sample of a channel.
+ *
+ * \details The eDMA current major iteration count gives the next entry to be
+ *          written; the newest entry of the requested channel is searched
+ *          backwards from there, taking the interleaving into account.
+ *
+ * \param[in] channel ADC channel number (0 or 1).
+ *
+ * \return The latest raw conversion result, or 0 if the scan is not running.
+ */
+uint16_t HAL_ADC_GetLatestSample(uint8_t channel)
+{
+    uint32_t remaining;
+    uint32_t next;
+    uint32_t index;
+
+    if ((!s_scanRunning) || (channel >= HAL_ADC_NUM_CHANNELS))
+    {
+        return 0U;
+    }
+
+    remaining = EDMA_DRV_GetRemainingMajorIterationsCount(HAL_DMA_CH_ADC_SCAN);
+    next = (ADC_SCAN_BUFFER_LEN - remaining) % ADC_SCAN_BUFFER_LEN;
+
+    /* Step back to the last written entry belonging to the channel */
+    index = (next + ADC_SCAN_BUFFER_LEN - 1U) % ADC_SCAN_BUFFER_LEN;
+    while ((index % HAL_ADC_NUM_CHANNELS) != channel)
+    {
+        index = (index + ADC_SCAN_BUFFER_LEN - 1U) % ADC_SCAN_BUFFER_LEN;
+    }
+
+    return s_scanBuffer[index];
+}
+
+/**
+ * \brief Selects the noise reduction mode.
+ *
+ * \details The hardware averaging unit is enabled for the HAL_ADC_MODE_HW_AVG_x
+ *          modes and disabled otherwise. With averaging enabled each PDB
+ *          pre-trigger starts a whole averaged conversion and COCO (hence the DMA
+ *          request) is only set once it completes, so the scan keeps its layout. At
+ *          the default 2 kHz scan rate two 32-sample averages still fit in one PDB
+ *          period. The sample being averaged when the mode changes may mix both
+ *          settings.
+ *
+ * \param[in] mode Noise reduction mode. Invalid values are ignored.
+ *
+ * \return void.
+ */
+void HAL_ADC_SetMode(HAL_ADC_Mode_t mode)
+{
+    adc_average_config_t avgConfig;
+
+    if (mode >= HAL_ADC_MODE_COUNT)
+    {
+        return;
+    }
+
+    ADC_DRV_InitHwAverageStruct(&avgConfig);
+    avgConfig.hwAvgEnable = true;
+
+    switch (mode)
+    {
+        case HAL_ADC_MODE_HW_AVG_4:
+            avgConfig.hwAverage = ADC_AVERAGE_4;
+            break;
+        case HAL_ADC_MODE_HW_AVG_8:
+            avgConfig.hwAverage = ADC_AVERAGE_8;
+            break;
+        case HAL_ADC_MODE_HW_AVG_16:
+            avgConfig.hwAverage = ADC_AVERAGE_16;
+            break;
+        case HAL_ADC_MODE_HW_AVG_32:
+            avgConfig.hwAverage = ADC_AVERAGE_32;
+            break;
+        default:
+            avgConfig.hwAvgEnable = false;
+            break;
+    }
+
+    ADC_DRV_ConfigHwAverage(ADC_INSTANCE, &avgConfig);
+    s_adcMode = mode;
+}
+
+/**
+ * \brief Returns the current sample of a channel, filtered by the selected mode.
+ *
+ * \details In oversampling mode the ring buffer of the channel is decimated,
+ *          otherwise the latest scanned sample is returned (already averaged by
+ *          hardware in the HAL_ADC_MODE_HW_AVG_x modes).
+ *
+ * \param[in] channel ADC channel number (0 or 1).
+ *
+ * \return The sample, with HAL_ADC_GetSampleBits() bits of resolution, or 0 if the
+ *         scan is not running.
+ */
+uint16_t HAL_ADC_GetSample(uint8_t channel)
+{
+    if ((!s_scanRunning) || (channel >= HAL_ADC_NUM_CHANNELS))
+    {
+        return 0U;
+    }
+    if (s_adcMode == HAL_ADC_MODE_OVERSAMPLE)
+    {
+        return HAL_ADC_Decimate(channel);
+    }
+    return HAL_ADC_GetLatestSample(channel);
+}
+
+/**
+ * \brief Returns the resolution of the values returned by HAL_ADC_GetSample().
+ *
+ * \return HAL_ADC_NATIVE_BITS, plus HAL_ADC_OVERSAMPLE_EXTRA_BITS in
+ *         oversampling mode.
+ */
+uint8_t HAL_ADC_GetSampleBits(void)
+{
+    if (s_adcMode == HAL_ADC_MODE_OVERSAMPLE)
+    {
+        return (uint8_t)(HAL_ADC_NATIVE_BITS + HAL_ADC_OVERSAMPLE_EXTRA_BITS);
+    }
+    return (uint8_t)HAL_ADC_NATIVE_BITS;
+}
+
+/**
+ * \brief Programs the threshold alarm of a channel.
+ *
+ * \details The ADC hardware compare unit is not used: it is shared by all the
+ *          conversions of the converter and a result that does not match is not
+ *          stored and raises no COCO, which would break the eDMA scan. The
+ *          thresholds are instead checked by the eDMA interrupt on every half of
+ *          the scan ring. The alarm is disabled while the thresholds are updated,
+ *          so the ISR never uses a half-written pair.
+ *
+ * \param[in] channel ADC channel number (0 or 1).
+ * \param[in] mode    Alarm condition. Invalid values disable the alarm.
+ * \param[in] low     Low threshold (undervoltage), in codes.
+ * \param[in] high    High threshold (overvoltage), in codes.
+ *
+ * \return void.
+ */
+void HAL_ADC_SetAlarm(uint8_t channel, HAL_ADC_AlarmMode_t mode, uint16_t low, uint16_t high)
+{
+    if (channel >= HAL_ADC_NUM_CHANNELS)
+    {
+        return;
+    }
+
+    s_alarm[channel].mode = HAL_ADC_ALARM_OFF;
+    s_alarm[channel].low = low;
+    s_alarm[channel].high = high;
+    s_alarm[channel].mode = (mode <= HAL_ADC_ALARM_WINDOW) ? mode : HAL_ADC_ALARM_OFF;
+}
+
+/**
+ * \brief Registers the function called when a channel trips its alarm.
+ *
+ * \param[in] callback Alarm callback, called from the eDMA ISR, or NULL.
+ *
+ * \return void.
+ */
+void HAL_ADC_SetAlarmCallback(HAL_ADC_AlarmCallback_t callback)
+{
+    s_alarmCallback = callback;
 }
 
 /**
@@ -107,25 +673,98 @@ uint16_t HAL_ADC_ReadChannel(uint8_t channel)
 }
 
 /**
- * \brief Converts the raw ADC value to the actual input voltage.
+ * \brief Returns the full-scale code of the configured resolution.
  *
- * This function converts the raw ADC value (assumed to be 8-bit, i.e., range 0-255)
- * to the input voltage in volts. It assumes:
- *  - The ADC reference voltage is 3.3 V.
- *  - An external voltage divider scales the actual input voltage (5-20 V)
+ * \return 255, 1023 or 4095 for 8-, 10- or 12-bit resolution.
+ */
+uint16_t HAL_ADC_GetFullScale(void)
+{
+    uint16_t fullScale;
+
+    switch (s_adcConfig.resolution)
+    {
+        case ADC_RESOLUTION_8BIT:
+            fullScale = ADC_FULL_SCALE_8BIT;
+            break;
+        case ADC_RESOLUTION_10BIT:
+            fullScale = ADC_FULL_SCALE_10BIT;
+            break;
+        default:
+            fullScale = ADC_FULL_SCALE_12BIT;
+            break;
+    }
+    return fullScale;
+}
+
+/**
+ * \brief Converts a raw ADC value to the input voltage in millivolts.
  *
- * The conversion is performed as follows:
- *   V_adc = (adcValue / 255.0) * 3.3
- *   V_in  = V_adc / 0.15
+ * This function applies the per-channel calibration to the ADC sample:
+ *   code = max(adcValue - offset * 2^extra, 0)
+ *   V_in [mV] = (code * scaleQ16 + 0.5 * 2^extra) >> (16 + extra)
+ * where scaleQ16 was computed by HAL_ADC_Init() from the reference voltage, the
+ * full-scale code, the divider ratio and the gain of the channel, and extra is
+ * the number of bits of the sample beyond HAL_ADC_NATIVE_BITS. It costs one
+ * subtraction, one multiplication and one shift per sample.
  *
- * \param[in] adcValue Raw ADC conversion result.
+ * \param[in] channel    ADC channel number (0 or 1).
+ * \param[in] adcValue   ADC sample.
+ * \param[in] sampleBits Resolution of the sample (HAL_ADC_GetSampleBits()).
  *
- * \return The calculated input voltage (in volts).
+ * \return The input voltage in millivolts, or 0 for an invalid channel.
  *
  */
-float HAL_ADC_ConvertToVoltage(uint16_t adcValue)
+uint16_t HAL_ADC_ConvertToMillivolts(uint8_t channel, uint16_t adcValue, uint8_t sampleBits)
 {
-    float v_adc = ((float)adcValue / 255.0f) * 3.3f;
-    float v_in = v_adc / 0.15f;
-    return v_in;
+    if (channel >= HAL_ADC_NUM_CHANNELS)
+    {
+        return 0U;
+    }
+    return HAL_ADC_ScaleToMillivolts(adcValue, s_adcCalibration[channel].offsetCodes,
+                                     s_scaleQ16[channel], HAL_ADC_ExtraBits(sampleBits));
+}
+
+/**
+ * \brief Converts a block of raw ADC values of one channel to millivolts.
+ *
+ * This function is the batch variant of HAL_ADC_ConvertToMillivolts(): the
+ * channel offset and scale are loaded once and the loop is unrolled by four, so
+ * the per-sample cost is reduced to the conversion kernel itself.
+ *
+ * \param[in]  channel    ADC channel number (0 or 1).
+ * \param[in]  adcValues  ADC samples.
+ * \param[out] millivolts Converted values, in millivolts (may alias adcValues).
+ * \param[in]  count      Number of values to convert.
+ * \param[in]  sampleBits Resolution of the samples (HAL_ADC_GetSampleBits()).
+ *
+ * \return void.
+ *
+ */
+void HAL_ADC_ConvertBlockToMillivolts(uint8_t channel, const uint16_t *adcValues,
+                                      uint16_t *millivolts, uint32_t count, uint8_t sampleBits)
+{
+    int32_t offset;
+    uint32_t scale;
+    uint8_t extra = HAL_ADC_ExtraBits(sampleBits);
+    uint32_t i = 0U;
+
+    if (channel >= HAL_ADC_NUM_CHANNELS)
+    {
+        return;
+    }
+
+    offset = s_adcCalibration[channel].offsetCodes;
+    scale = s_scaleQ16[channel];
+
+    for (; (i + 4U) <= count; i += 4U)
+    {
+        millivolts[i]      = HAL_ADC_ScaleToMillivolts(adcValues[i],      offset, scale, extra);
+        millivolts[i + 1U] = HAL_ADC_ScaleToMillivolts(adcValues[i + 1U], offset, scale, extra);
+        millivolts[i + 2U] = HAL_ADC_ScaleToMillivolts(adcValues[i + 2U], offset, scale, extra);
+        millivolts[i + 3U] = HAL_ADC_ScaleToMillivolts(adcValues[i + 3U], offset, scale, extra);
+    }
+    for (; i < count; i++)
+    {
+        millivolts[i] = HAL_ADC_ScaleToMillivolts(adcValues[i], offset, scale, extra);
+    }
 }
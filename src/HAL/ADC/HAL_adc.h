@@ -8,9 +8,11 @@
 /*   This module provides functions for initializing the ADC to read two     */
 /*   single-ended channels (referenced to GND), reading the raw ADC           */
 /*   conversion result from a specified channel, and converting that raw      */
-/*   value into the corresponding input voltage (in volts). The conversion     */
+/*   value into the corresponding input voltage (in millivolts). The conversion */
 /*   accounts for an external voltage divider which scales an input range of    */
 /*   520 V down to an acceptable range for the ADC (e.g., 03.3 V).           */
+/*   Hardware averaging and software oversampling modes reduce the noise of   */
+/*   the conditioned inputs.                                                  */
 /*                                                                            */
 /*   This software is provided free of charge.                                                    */
 /*                                                                            */
@@ -21,6 +23,67 @@
 
 #include <stdint.h>
 
+/******************************************************************************/
+/*                Definition of exported symbolic constants               */
+/******************************************************************************/
+/** \brief Number of ADC channels acquired by this module. */
+#define HAL_ADC_NUM_CHANNELS   2U
+
+/** \brief Number of samples per channel kept in the scan ring buffer. */
+#define HAL_ADC_SCAN_DEPTH     16U
+
+/** \brief Default scan rate, in pairs of samples per second. */
+#define HAL_ADC_SCAN_RATE_HZ   2000U
+
+/** \brief Native resolution of the conversions, in bits. */
+#define HAL_ADC_NATIVE_BITS    12U
+
+/**
+ * \brief Extra bits of resolution gained in oversampling mode.
+ * \details Oversampling by 4^n and decimating yields n extra bits, so the
+ *          HAL_ADC_SCAN_DEPTH (16) samples of the ring buffer give 2 bits.
+ */
+#define HAL_ADC_OVERSAMPLE_EXTRA_BITS 2U
+
+/******************************************************************************/
+/*                Definition of exported types                                */
+/******************************************************************************/
+/**
+ * \brief Noise reduction mode of the ADC acquisition.
+ *
+ * \details The values match the encoding of the REG_ADCMODE register.
+ */
+typedef enum
+{
+    HAL_ADC_MODE_SINGLE = 0U,     /**< One conversion per sample, no filtering. */
+    HAL_ADC_MODE_HW_AVG_4,        /**< Hardware average of 4 conversions. */
+    HAL_ADC_MODE_HW_AVG_8,        /**< Hardware average of 8 conversions. */
+    HAL_ADC_MODE_HW_AVG_16,       /**< Hardware average of 16 conversions. */
+    HAL_ADC_MODE_HW_AVG_32,       /**< Hardware average of 32 conversions. */
+    HAL_ADC_MODE_OVERSAMPLE,      /**< Software oversample and decimate (14-bit). */
+    HAL_ADC_MODE_COUNT            /**< Number of modes, not a valid mode. */
+} HAL_ADC_Mode_t;
+
+/**
+ * \brief Threshold alarm condition of one channel.
+ *
+ * \details The values match the encoding of the REG_ALARMCFG register fields.
+ */
+typedef enum
+{
+    HAL_ADC_ALARM_OFF = 0U,       /**< Alarm disabled. */
+    HAL_ADC_ALARM_HIGH,           /**< Alarm when a sample is above the high threshold. */
+    HAL_ADC_ALARM_LOW,            /**< Alarm when a sample is below the low threshold. */
+    HAL_ADC_ALARM_WINDOW          /**< Alarm when a sample is outside [low, high]. */
+} HAL_ADC_AlarmMode_t;
+
+/**
+ * \brief Callback invoked from interrupt context when samples trip an alarm.
+ *
+ * \param[in] channelMask Bit n set if channel n tripped its alarm.
+ */
+typedef void (*HAL_ADC_AlarmCallback_t)(uint8_t channelMask);
+
 /**
  * \brief Initializes the ADC for reading two simple channels.
  *
@@ -32,11 +95,93 @@
  */
 void HAL_ADC_Init(void);
 
+/**
+ * \brief Starts the continuous DMA scan of the two ADC channels.
+ *
+ * \details PDB0 hardware-triggers channel 0 and channel 1 back to back at the
+ *          given rate and eDMA moves each result into an internal ring buffer,
+ *          so no CPU time is spent per sample.
+ *
+ * \param[in] sampleRateHz Scan rate, in pairs of samples per second.
+ *
+ * \return void.
+ */
+void HAL_ADC_StartScan(uint32_t sampleRateHz);
+
+/**
+ * \brief Returns the most recent scanned sample of the specified channel.
+ *
+ * \param[in] channel ADC channel number (0 or 1).
+ *
+ * \return The latest raw ADC conversion result, or 0 if the scan is not running.
+ */
+uint16_t HAL_ADC_GetLatestSample(uint8_t channel);
+
+/**
+ * \brief Selects the noise reduction mode.
+ *
+ * \details Hardware averaging modes program the ADC averaging unit, so every
+ *          scanned sample is already the mean of 4 to 32 conversions. The
+ *          oversampling mode keeps single conversions and decimates the whole scan
+ *          ring buffer of the channel when a sample is fetched. Can be called while
+ *          the scan is running.
+ *
+ * \param[in] mode Noise reduction mode. Invalid values are ignored.
+ *
+ * \return void.
+ */
+void HAL_ADC_SetMode(HAL_ADC_Mode_t mode);
+
+/**
+ * \brief Returns the current sample of a channel, filtered by the selected mode.
+ *
+ * \param[in] channel ADC channel number (0 or 1).
+ *
+ * \return The sample, with HAL_ADC_GetSampleBits() bits of resolution.
+ */
+uint16_t HAL_ADC_GetSample(uint8_t channel);
+
+/**
+ * \brief Returns the resolution of the values returned by HAL_ADC_GetSample().
+ *
+ * \return 12 bits, or 14 bits in oversampling mode.
+ */
+uint8_t HAL_ADC_GetSampleBits(void);
+
+/**
+ * \brief Programs the threshold alarm of a channel.
+ *
+ * \details Thresholds are raw codes at the native resolution and are compared
+ *          with every scanned sample (after hardware averaging, if enabled).
+ *          The alarm latency is half a scan ring, not one conversion time: a
+ *          sample is checked once eDMA has filled the half of the ring holding
+ *          it, up to HAL_ADC_SCAN_DEPTH / 2 scan periods later, about 4 ms at
+ *          the default 2 kHz scan rate.
+ *
+ * \param[in] channel ADC channel number (0 or 1).
+ * \param[in] mode    Alarm condition.
+ * \param[in] low     Low threshold (undervoltage), in codes.
+ * \param[in] high    High threshold (overvoltage), in codes.
+ *
+ * \return void.
+ */
+void HAL_ADC_SetAlarm(uint8_t channel, HAL_ADC_AlarmMode_t mode, uint16_t low, uint16_t high);
+
+/**
+ * \brief Registers the function called when a channel trips its alarm.
+ *
+ * \param[in] callback Alarm callback, or NULL to disable notifications.
+ *
+ * \return void.
+ */
+void HAL_ADC_SetAlarmCallback(HAL_ADC_AlarmCallback_t callback);
+
 /**
  * \brief Reads the specified ADC channel.
  *
  * \details Configures and triggers a conversion on the specified ADC channel,
  *          then waits for the conversion to complete and returns the raw result.
+ *          Only valid in software trigger mode, i.e. before HAL_ADC_StartScan().
  *
  * \param[in] channel ADC channel number (e.g., 0 or 1).
  *
@@ -45,19 +190,43 @@ void HAL_ADC_Init(void);
 uint16_t HAL_ADC_ReadChannel(uint8_t channel);
 
 /**
- * \brief Converts the raw ADC value to the actual input voltage.
+ * \brief Returns the full-scale code of the configured ADC resolution.
+ *
+ * \return 255, 1023 or 4095 for 8-, 10- or 12-bit resolution.
+ */
+uint16_t HAL_ADC_GetFullScale(void);
+
+/**
+ * \brief Converts the raw ADC value to the actual input voltage in millivolts.
  *
- * \details This function converts the raw ADC reading (assumed to be an 8-bit value
- *          in the range 0-255) to the corresponding voltage at the input before the
- *          voltage divider. For example, if the ADC reference is 3.3 V and the divider
- *          scales the input voltage by 0.15, the conversion is as follows:
- *          \n V_adc = (adcValue / 255.0) * 3.3
+ * \details Fixed-point conversion using the calibration constants of the channel
+ *          (gain, offset and divider ratio). The conversion is:
+ *          \n V_adc = (adcValue / fullScale) * 3300 mV
  *          \n V_in  = V_adc / 0.15
+ *          folded at initialization into a single Q16 factor, so each sample only
+ *          costs a multiplication and a shift. Oversampled samples are scaled
+ *          down by their extra bits.
  *
- * \param[in] adcValue Raw ADC conversion result.
+ * \param[in] channel    ADC channel number (0 or 1).
+ * \param[in] adcValue   ADC sample, as returned by HAL_ADC_GetSample().
+ * \param[in] sampleBits Resolution of the sample (HAL_ADC_GetSampleBits()).
  *
- * \return A float representing the input voltage (in volts).
+ * \return The input voltage in millivolts, saturated at 65535.
+ */
+uint16_t HAL_ADC_ConvertToMillivolts(uint8_t channel, uint16_t adcValue, uint8_t sampleBits);
+
+/**
+ * \brief Converts a block of raw ADC values of one channel to millivolts.
+ *
+ * \param[in]  channel    ADC channel number (0 or 1).
+ * \param[in]  adcValues  ADC samples.
+ * \param[out] millivolts Converted values, in millivolts (may alias adcValues).
+ * \param[in]  count      Number of values to convert.
+ * \param[in]  sampleBits Resolution of the samples (HAL_ADC_GetSampleBits()).
+ *
+ * \return void.
  */
-float HAL_ADC_ConvertToVoltage(uint16_t adcValue);
+void HAL_ADC_ConvertBlockToMillivolts(uint8_t channel, const uint16_t *adcValues,
+                                      uint16_t *millivolts, uint32_t count, uint8_t sampleBits);
 
 #endif /* HAL_ADC_HAL_ADC_H_ */
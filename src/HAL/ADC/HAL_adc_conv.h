@@ -0,0 +1,100 @@
+/******************************************************************************/
+/*                                                                            */
+/*   S32K144 ADC HAL Module - millivolt conversion kernel                     */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Fixed-point conversion from ADC codes to millivolts used by HAL_adc.c.   */
+/*   It does not touch the ADC registers, so it is also built and checked     */
+/*   against a floating-point reference by the host tests (test/).            */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef HAL_ADC_HAL_ADC_CONV_H_
+#define HAL_ADC_HAL_ADC_CONV_H_
+
+#include <stdint.h>
+#include <HAL_adc.h>
+
+/******************************************************************************/
+/*                Definition of exported functions                            */
+/******************************************************************************/
+
+/**
+ * \brief Fixed-point conversion kernel from ADC code to millivolts.
+ *
+ * \details A sample with extraBits more bits than the native resolution is
+ *          2^extraBits times the native code, so the Q16 factor of the native
+ *          resolution applies with a shift of 16 + extraBits. The product is
+ *          64-bit (UMULL on the Cortex-M4), so no code can overflow it.
+ *
+ * \param[in] adcValue  ADC sample.
+ * \param[in] offset    Offset to subtract, in native codes.
+ * \param[in] scaleQ16  Millivolts per native code, Q16.
+ * \param[in] extraBits Bits of the sample beyond the native resolution.
+ *
+ * \return The input voltage in millivolts, rounded to nearest and saturated
+ *         at 65535.
+ */
+static inline uint16_t HAL_ADC_ScaleToMillivolts(uint16_t adcValue, int32_t offset, uint32_t scaleQ16,
+                                                 uint8_t extraBits)
+{
+    int32_t code = (int32_t)adcValue - (offset * (int32_t)(1UL << extraBits));
+    uint64_t millivolts;
+
+    if (code < 0)
+    {
+        code = 0;
+    }
+    millivolts = (((uint64_t)(uint32_t)code * scaleQ16) + (0x8000ULL << extraBits)) >> (16U + extraBits);
+    return (millivolts > 0xFFFFU) ? 0xFFFFU : (uint16_t)millivolts;
+}
+
+/**
+ * \brief Returns the bits of a sample beyond the native resolution.
+ *
+ * \param[in] sampleBits Resolution of the sample, in bits.
+ *
+ * \return 0 to HAL_ADC_OVERSAMPLE_EXTRA_BITS.
+ */
+static inline uint8_t HAL_ADC_ExtraBits(uint8_t sampleBits)
+{
+    if (sampleBits <= HAL_ADC_NATIVE_BITS)
+    {
+        return 0U;
+    }
+    if (sampleBits >= (HAL_ADC_NATIVE_BITS + HAL_ADC_OVERSAMPLE_EXTRA_BITS))
+    {
+        return HAL_ADC_OVERSAMPLE_EXTRA_BITS;
+    }
+    return (uint8_t)(sampleBits - HAL_ADC_NATIVE_BITS);
+}
+
+/**
+ * \brief Computes the Q16 millivolts-per-code factor of a channel.
+ *
+ * \details scaleQ16 = gainQ16 * vrefMv * dividerDen / (fullScale * dividerNum),
+ *          rounded to nearest. Evaluated once with 64-bit intermediates, so the
+ *          per-sample kernel needs a single multiplication.
+ *
+ * \param[in] gainQ16    Gain correction, Q16 (65536 = 1.0).
+ * \param[in] dividerNum Divider ratio numerator.
+ * \param[in] dividerDen Divider ratio denominator.
+ * \param[in] vrefMv     ADC reference voltage, in millivolts.
+ * \param[in] fullScale  Full-scale code at the native resolution.
+ *
+ * \return Millivolts per code, Q16.
+ */
+static inline uint32_t HAL_ADC_ComputeScaleQ16(uint32_t gainQ16, uint16_t dividerNum, uint16_t dividerDen,
+                                               uint32_t vrefMv, uint32_t fullScale)
+{
+    uint64_t numerator = (uint64_t)gainQ16 * vrefMv * dividerDen;
+    uint64_t denominator = (uint64_t)fullScale * dividerNum;
+
+    return (uint32_t)((numerator + (denominator / 2U)) / denominator);
+}
+
+#endif /* HAL_ADC_HAL_ADC_CONV_H_ */
@@ -7,19 +7,126 @@
 /*                                                                            */
 /*   This module provides functions for initializing the 8 GPIO pins used    */
 /*   for digital input and for reading their current state. The pins are      */
-/*   configured using the S32K144 pin driver.                                 */
+/*   configured using the S32K144 pin driver. The PORT pin interrupts can     */
+/*   capture every edge of the inputs, so pulses shorter than the main loop   */
+/*   period are not lost. Noise is rejected by the PORT digital filter and by */
+/*   a per-pin integrator running on a fixed tick.                            */
 /*                                                                            */
 /*   This software is provided free of charge.                                                     */
 /*                                                                            */
 /******************************************************************************/
 
 #include <HAL_dio.h>       /* Interface for DIO HAL functions */
+#include <HAL_tim.h>       /* Timestamps of the captured edges */
+#include <stddef.h>
 #include "pins_driver.h"   /* Definitions for pin_settings_config_t, PINS_Init, etc. */
+#include "interrupt_manager.h"
 #include "S32K144.h"       /* Microcontroller-specific constants */
 
 /******************************************************************************/
 /*                   Definition of local types and enums                      */
 /******************************************************************************/
+/**
+ * \brief Location of one digital input.
+ */
+typedef struct
+{
+    PORT_Type *port;    /**< PORT module of the pin. */
+    uint8_t pin;        /**< Pin index within the port. */
+} dio_input_t;
+
+/******************************************************************************/
+/*                   Definition of local constants                            */
+/******************************************************************************/
+/** \brief Inputs in bit order of HAL_GPIO_ReadInputs(). */
+static const dio_input_t s_inputs[HAL_GPIO_NUM_INPUTS] = {
+    { PORTC, 7U }, { PORTC, 6U }, { PORTB, 17U }, { PORTB, 14U },
+    { PORTB, 15U }, { PORTB, 16U }, { PORTC, 14U }, { PORTC, 3U }
+};
+
+/******************************************************************************/
+/*                   Definition of local variables                            */
+/******************************************************************************/
+/** \brief Function receiving the captured edges. */
+static HAL_GPIO_EdgeCallback_t s_edgeCallback = NULL;
+
+/** \brief Input levels seen by the last edge interrupt (bit order of the inputs). */
+static uint8_t s_lastLevels = 0U;
+
+/** \brief Function receiving the debounced state. */
+static HAL_GPIO_DebounceCallback_t s_debounceCallback = NULL;
+
+/** \brief Number of consistent ticks needed to accept a new level. */
+static volatile uint8_t s_debounceSamples = 1U;
+
+/** \brief Integrator of each input, from 0 (low) to s_debounceSamples (high). */
+static uint8_t s_integrator[HAL_GPIO_NUM_INPUTS];
+
+/** \brief Debounced state of the inputs. */
+static uint8_t s_debounced = 0U;
+
+/******************************************************************************/
+/*                   Declaration of interrupt handlers                        */
+/******************************************************************************/
+void PORTB_IRQHandler(void);
+void PORTC_IRQHandler(void);
+
+/******************************************************************************/
+/*                     Definition of local functions                         */
+/******************************************************************************/
+
+/**
+ * \brief Captures the edges flagged on one port.
+ *
+ * \details The flags of the inputs are cleared before their levels are sampled,
+ *          so a later edge raises a new interrupt. If the level of a flagged input
+ *          equals its previous level, a pulse shorter than the interrupt latency
+ *          occurred and both of its edges are reported with the same timestamp.
+ *
+ * \param[in] port PORT module that raised the interrupt.
+ *
+ * \return void.
+ */
+static void HAL_GPIO_CaptureEdges(PORT_Type *port)
+{
+    uint32_t flags = PINS_DRV_GetPortIntFlag(port);
+    uint32_t timestamp;
+    uint8_t flagged = 0U;
+    uint8_t levels;
+    uint8_t input;
+
+    for (input = 0U; input < HAL_GPIO_NUM_INPUTS; input++)
+    {
+        if ((s_inputs[input].port == port) && ((flags & (1UL << s_inputs[input].pin)) != 0U))
+        {
+            PINS_DRV_ClearPinIntFlagCmd(port, s_inputs[input].pin);
+            flagged |= (uint8_t)(1U << input);
+        }
+    }
+
+    timestamp = HAL_TIM_GetTicks();
+    levels = HAL_GPIO_ReadInputs();
+
+    for (input = 0U; input < HAL_GPIO_NUM_INPUTS; input++)
+    {
+        uint8_t mask = (uint8_t)(1U << input);
+        bool level = ((levels & mask) != 0U);
+
+        if ((flagged & mask) == 0U)
+        {
+            continue;
+        }
+        if (level == ((s_lastLevels & mask) != 0U))
+        {
+            /* Missed pulse: report the edge away from the current level first */
+            s_edgeCallback(input, !level, timestamp);
+        }
+        s_edgeCallback(input, level, timestamp);
+    }
+
+    /* Only the flagged inputs: an unflagged one may have an edge pending */
+    s_lastLevels = (uint8_t)((s_lastLevels & (uint8_t)~flagged) | (levels & flagged));
+}
 
 /******************************************************************************/
 /*                     Definition of exported functions                     */
@@ -104,3 +211,199 @@ uint8_t HAL_GPIO_ReadInputs(void)
 
     return estado;
 }
+
+/**
+ * \brief Starts capturing the edges of the 8 digital inputs.
+ *
+ * \details Records the current input levels, selects an interrupt on either edge
+ *          for every input, clears stale flags and enables the PORTB and PORTC
+ *          interrupts. Both run at the same (default) priority, so they never
+ *          preempt each other and the callback always has a single producer.
+ *
+ * \param[in] callback Function receiving the captured edges.
+ *
+ * \return void.
+ */
+void HAL_GPIO_StartEdgeCapture(HAL_GPIO_EdgeCallback_t callback)
+{
+    uint8_t input;
+
+    DEV_ASSERT(callback != NULL);
+
+    s_edgeCallback = callback;
+    s_lastLevels = HAL_GPIO_ReadInputs();
+
+    for (input = 0U; input < HAL_GPIO_NUM_INPUTS; input++)
+    {
+        PINS_DRV_SetPinIntSel(s_inputs[input].port, s_inputs[input].pin, PORT_INT_EITHER_EDGE);
+        PINS_DRV_ClearPinIntFlagCmd(s_inputs[input].port, s_inputs[input].pin);
+    }
+
+    INT_SYS_EnableIRQ(PORTB_IRQn);
+    INT_SYS_EnableIRQ(PORTC_IRQn);
+}
+
+/**
+ * \brief Configures the PORT digital filter of the 8 digital inputs.
+ *
+ * \details The filters are clocked by the LPO clock. As required by the driver,
+ *          the filters of the inputs are disabled before the width of PORTB and
+ *          PORTC is updated, then re-enabled if width is not 0. The filter delays
+ *          the input, and its edge interrupts, by the filter width.
+ *
+ * \param[in] width Filter width in LPO clock cycles (1..31), 0 to disable it.
+ *
+ * \return void.
+ */
+void HAL_GPIO_SetDigitalFilter(uint8_t width)
+{
+    port_digital_filter_config_t filterConfig = {
+        .clock = PORT_DIGITAL_FILTER_LPO_CLOCK,
+        .width = width
+    };
+    uint8_t input;
+
+    if (width > HAL_GPIO_DIGITAL_FILTER_MAX)
+    {
+        return;
+    }
+
+    for (input = 0U; input < HAL_GPIO_NUM_INPUTS; input++)
+    {
+        PINS_DRV_DisableDigitalFilter(s_inputs[input].port, s_inputs[input].pin);
+    }
+    if (width == 0U)
+    {
+        return;
+    }
+
+    PINS_DRV_ConfigDigitalFilter(PORTB, &filterConfig);
+    PINS_DRV_ConfigDigitalFilter(PORTC, &filterConfig);
+    for (input = 0U; input < HAL_GPIO_NUM_INPUTS; input++)
+    {
+        PINS_DRV_EnableDigitalFilter(s_inputs[input].port, s_inputs[input].pin);
+    }
+}
+
+/**
+ * \brief Starts the software debounce of the 8 digital inputs.
+ *
+ * \param[in] samples  Number of consistent ticks needed to accept a new level.
+ * \param[in] callback Function receiving the debounced state.
+ *
+ * \return void.
+ */
+void HAL_GPIO_StartDebounce(uint8_t samples, HAL_GPIO_DebounceCallback_t callback)
+{
+    uint8_t input;
+
+    DEV_ASSERT(callback != NULL);
+
+    HAL_GPIO_SetDebounceSamples(samples);
+    s_debounced = HAL_GPIO_ReadInputs();
+    for (input = 0U; input < HAL_GPIO_NUM_INPUTS; input++)
+    {
+        s_integrator[input] = ((s_debounced & (1U << input)) != 0U) ? s_debounceSamples : 0U;
+    }
+
+    s_debounceCallback = callback;
+    s_debounceCallback(s_debounced, 0U);
+}
+
+/**
+ * \brief Changes the number of ticks needed to accept a new level.
+ *
+ * \param[in] samples Number of ticks (0 is treated as 1).
+ *
+ * \return void.
+ */
+void HAL_GPIO_SetDebounceSamples(uint8_t samples)
+{
+    s_debounceSamples = (samples == 0U) ? 1U : samples;
+}
+
+/**
+ * \brief Runs one step of the software debounce.
+ *
+ * \details Each input has an integrator that counts up while the raw input is
+ *          high and down while it is low, saturating at 0 and at the number of
+ *          samples. The debounced level only changes when the integrator reaches
+ *          either end, so a level must be stable for that many ticks (with noise
+ *          merely delaying the decision) to be accepted.
+ *
+ * \return void.
+ */
+void HAL_GPIO_DebounceTick(void)
+{
+    uint8_t raw = HAL_GPIO_ReadInputs();
+    uint8_t samples = s_debounceSamples;
+    uint8_t changed = 0U;
+    uint8_t input;
+
+    if (s_debounceCallback == NULL)
+    {
+        return;
+    }
+
+    for (input = 0U; input < HAL_GPIO_NUM_INPUTS; input++)
+    {
+        uint8_t mask = (uint8_t)(1U << input);
+
+        if ((raw & mask) != 0U)
+        {
+            if (s_integrator[input] < samples)
+            {
+                s_integrator[input]++;
+            }
+        }
+        else if (s_integrator[input] > 0U)
+        {
+            s_integrator[input]--;
+        }
+
+        /* Clamp after a reduction of the number of samples */
+        if (s_integrator[input] > samples)
+        {
+            s_integrator[input] = samples;
+        }
+
+        if ((s_integrator[input] == samples) && ((s_debounced & mask) == 0U))
+        {
+            changed |= mask;
+        }
+        else if ((s_integrator[input] == 0U) && ((s_debounced & mask) != 0U))
+        {
+            changed |= mask;
+        }
+    }
+
+    if (changed != 0U)
+    {
+        s_debounced ^= changed;
+        s_debounceCallback(s_debounced, changed);
+    }
+}
+
+/******************************************************************************/
+/*                     Definition of interrupt handlers                       */
+/******************************************************************************/
+
+/**
+ * \brief PORTB pin detect interrupt handler.
+ *
+ * \return void.
+ */
+void PORTB_IRQHandler(void)
+{
+    HAL_GPIO_CaptureEdges(PORTB);
+}
+
+/**
+ * \brief PORTC pin detect interrupt handler.
+ *
+ * \return void.
+ */
+void PORTC_IRQHandler(void)
+{
+    HAL_GPIO_CaptureEdges(PORTC);
+}
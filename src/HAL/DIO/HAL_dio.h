@@ -7,7 +7,9 @@
 /*                                                                            */
 /*   This module provides functions for initializing 8 digital I/O (GPIO) pins  */
 /*   and for reading the state of these pins. The pins are configured as       */
-/*   digital inputs using the S32K144 pin driver.                             */
+/*   digital inputs using the S32K144 pin driver. Edges on the inputs can     */
+/*   also be captured by interrupt and reported with a timestamp, and are     */
+/*   debounced by the PORT digital filter and a per-pin software integrator.  */
 /*                                                                            */
 /*   This software is provided free of charge.                              */
 /*                                                                            */
@@ -17,6 +19,39 @@
 #define HAL_DIO_HAL_DIO_H_
 
 #include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/*                Definition of exported symbolic constants               */
+/******************************************************************************/
+/** \brief Number of digital inputs (bits of HAL_GPIO_ReadInputs()). */
+#define HAL_GPIO_NUM_INPUTS  8U
+
+/** \brief Rate at which HAL_GPIO_DebounceTick() must be called, in Hz. */
+#define HAL_GPIO_DEBOUNCE_TICK_HZ  1000U
+
+/** \brief Largest PORT digital filter width, in LPO clock cycles. */
+#define HAL_GPIO_DIGITAL_FILTER_MAX  31U
+
+/******************************************************************************/
+/*                Definition of exported types                                */
+/******************************************************************************/
+/**
+ * \brief Callback invoked from the PORT interrupt for every captured edge.
+ *
+ * \param[in] input     Input number, i.e. bit of HAL_GPIO_ReadInputs() (0..7).
+ * \param[in] rising    true for a rising edge, false for a falling edge.
+ * \param[in] timestamp Time of the interrupt, in HAL_TIM_GetTicks() ticks.
+ */
+typedef void (*HAL_GPIO_EdgeCallback_t)(uint8_t input, bool rising, uint32_t timestamp);
+
+/**
+ * \brief Callback invoked from the debounce tick when the debounced state changes.
+ *
+ * \param[in] state   Debounced state of the inputs (bit order of HAL_GPIO_ReadInputs()).
+ * \param[in] changed Bit n set if input n changed on this tick.
+ */
+typedef void (*HAL_GPIO_DebounceCallback_t)(uint8_t state, uint8_t changed);
 
 /**
  * \brief Initializes the 8 digital I/O pins.
@@ -40,4 +75,59 @@ void HAL_GPIO_Init(void);
  */
 uint8_t HAL_GPIO_ReadInputs(void);
 
+/**
+ * \brief Starts capturing the edges of the 8 digital inputs.
+ *
+ * \details Enables the PORTB/PORTC interrupt on either edge of every input. Each
+ *          edge is reported to the callback, from interrupt context, with the
+ *          HAL_TIM timestamp of the interrupt. HAL_TIM_Init() must have been called.
+ *
+ * \param[in] callback Function receiving the captured edges.
+ *
+ * \return void.
+ */
+void HAL_GPIO_StartEdgeCapture(HAL_GPIO_EdgeCallback_t callback);
+
+/**
+ * \brief Configures the PORT digital filter of the 8 digital inputs.
+ *
+ * \param[in] width Filter width in LPO clock cycles (1..31), 0 to disable it.
+ *
+ * \return void.
+ */
+void HAL_GPIO_SetDigitalFilter(uint8_t width);
+
+/**
+ * \brief Starts the software debounce of the 8 digital inputs.
+ *
+ * \details The debounced state is initialized to the current inputs and reported
+ *          to the callback with no changed bits. The caller must then invoke
+ *          HAL_GPIO_DebounceTick() at HAL_GPIO_DEBOUNCE_TICK_HZ.
+ *
+ * \param[in] samples  Number of consistent ticks needed to accept a new level.
+ * \param[in] callback Function receiving the debounced state.
+ *
+ * \return void.
+ */
+void HAL_GPIO_StartDebounce(uint8_t samples, HAL_GPIO_DebounceCallback_t callback);
+
+/**
+ * \brief Changes the number of ticks needed to accept a new level.
+ *
+ * \param[in] samples Number of ticks (0 is treated as 1).
+ *
+ * \return void.
+ */
+void HAL_GPIO_SetDebounceSamples(uint8_t samples);
+
+/**
+ * \brief Runs one step of the software debounce.
+ *
+ * \details Must be called at HAL_GPIO_DEBOUNCE_TICK_HZ, e.g. from a timer
+ *          interrupt, independently of the main loop.
+ *
+ * \return void.
+ */
+void HAL_GPIO_DebounceTick(void);
+
 #endif /* HAL_DIO_HAL_DIO_H_ */
@@ -0,0 +1,47 @@
+/******************************************************************************/
+/*                                                                            */
+/*   S32K144 DMA HAL Module                                                   */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   This module initializes the eDMA controller with fixed channel priority */
+/*   arbitration. The individual channels are requested and configured by     */
+/*   the HAL modules that own them.                                           */
+/*                                                                            */
+/*   This software is provided free of charge.                              */
+/*                                                                            */
+/******************************************************************************/
+
+#include <stddef.h>
+#include "HAL_dma.h"
+#include "edma_driver.h"
+
+/******************************************************************************/
+/*                   Definition of local variables                            */
+/******************************************************************************/
+/** \brief Internal state of the eDMA driver. */
+static edma_state_t s_edmaState;
+
+/******************************************************************************/
+/*                      Definition of exported functions                      */
+/******************************************************************************/
+
+/**
+ * \brief Initializes the eDMA controller.
+ *
+ * \details Configures fixed priority arbitration and does not halt on errors, so
+ *          that a faulty channel does not stop the other ones. No channel is
+ *          initialized here.
+ *
+ * \return void.
+ */
+void HAL_DMA_Init(void)
+{
+    edma_user_config_t edmaConfig = {
+        .chnArbitration = EDMA_ARBITRATION_FIXED_PRIORITY,
+        .haltOnError = false
+    };
+
+    (void)EDMA_DRV_Init(&s_edmaState, &edmaConfig, NULL, NULL, 0U);
+}
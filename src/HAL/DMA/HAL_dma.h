@@ -0,0 +1,49 @@
+/******************************************************************************/
+/*                                                                            */
+/*   S32K144 DMA HAL Module                                                   */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   This module initializes the eDMA controller shared by the other HAL      */
+/*   modules and defines which eDMA channel is reserved for each of them.     */
+/*                                                                            */
+/*   This software is provided free of charge.                              */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef HAL_DMA_HAL_DMA_H_
+#define HAL_DMA_HAL_DMA_H_
+
+#include <stdint.h>
+
+/******************************************************************************/
+/*                Definition of exported symbolic constants               */
+/******************************************************************************/
+/** \brief eDMA channel used by the ADC scan (ADC0 result -> ring buffer). */
+#define HAL_DMA_CH_ADC_SCAN   0U
+
+/** \brief eDMA channel used by the SPI receive path (LPSPI0 RDR -> memory). */
+#define HAL_DMA_CH_SPI_RX     1U
+
+/** \brief eDMA channel used by the SPI transmit path (memory -> LPSPI0 TDR). */
+#define HAL_DMA_CH_SPI_TX     2U
+
+/** \brief eDMA channel used by the I2C slave data phases (LPI2C0 SRDR/STDR). */
+#define HAL_DMA_CH_I2C        3U
+
+/******************************************************************************/
+/*                Declaration of exported function prototypes               */
+/******************************************************************************/
+
+/**
+ * \brief Initializes the eDMA controller.
+ *
+ * \details Must be called once, before any HAL module that uses an eDMA channel
+ *          is initialized. Channels are initialized later by their owner module.
+ *
+ * \return void.
+ */
+void HAL_DMA_Init(void);
+
+#endif /* HAL_DMA_HAL_DMA_H_ */
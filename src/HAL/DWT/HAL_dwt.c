@@ -0,0 +1,219 @@
+/******************************************************************************/
+/*                                                                            */
+/*   S32K144 DWT HAL Module                                                   */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   This module enables the DWT cycle counter (CYCCNT) of the Cortex-M4 and  */
+/*   accumulates the durations of the instrumented stages. The DWT is a core  */
+/*   debug block the SDK has no driver for, so it is programmed through its   */
+/*   registers in the system address space. The register and barrier macros   */
+/*   can be defined before this file is compiled, which the host test uses to */
+/*   replace the DWT by a counter in RAM.                                     */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#include "HAL_dwt.h"
+#include <string.h>
+
+/******************************************************************************/
+/*                   Definition of local symbolic constants                 */
+/******************************************************************************/
+/** \brief Debug Exception and Monitor Control Register. */
+#ifndef DWT_DEMCR
+#define DWT_DEMCR                (*(volatile uint32_t *)0xE000EDFCUL)
+#endif
+
+/** \brief DEMCR: enables the DWT and ITM blocks. */
+#define DWT_DEMCR_TRCENA_MASK    (1UL << 24U)
+
+/** \brief DWT Control Register. */
+#ifndef DWT_CTRL
+#define DWT_CTRL                 (*(volatile uint32_t *)0xE0001000UL)
+#endif
+
+/** \brief DWT_CTRL: enables the cycle counter. */
+#define DWT_CTRL_CYCCNTENA_MASK  (1UL << 0U)
+
+/** \brief DWT Cycle Count Register. */
+#ifndef DWT_CYCCNT
+#define DWT_CYCCNT               (*(volatile uint32_t *)0xE0001004UL)
+#endif
+
+/** \brief log2 of the upper bound of histogram bin 0 (32 cycles). */
+#define DWT_HIST_FIRST_LOG2      5U
+
+/**
+ * \brief Compiler barrier: memory accesses are not moved across it.
+ *
+ * \details Only count is volatile, so this keeps the other stage fields on the
+ *          right side of the count accesses. The writer and the reader run on
+ *          the same core, so no hardware barrier is needed.
+ */
+#ifndef DWT_COMPILER_BARRIER
+#define DWT_COMPILER_BARRIER()   __asm volatile ("" ::: "memory")
+#endif
+
+/******************************************************************************/
+/*                   Definition of local types                                */
+/******************************************************************************/
+/**
+ * \brief Accumulated timing of one stage.
+ */
+typedef struct
+{
+    volatile uint32_t count;                 /**< Number of durations recorded, written last. */
+    uint32_t minCycles;                      /**< Shortest duration. */
+    uint32_t maxCycles;                      /**< Longest duration. */
+    uint64_t totalCycles;                    /**< Sum of the durations. */
+    uint16_t histogram[HAL_DWT_HIST_BINS];   /**< Durations per bin, saturated. */
+} HAL_DWT_Stage_t;
+
+/******************************************************************************/
+/*                   Definition of local variables                            */
+/******************************************************************************/
+/** \brief Accumulated timing of every stage. */
+static HAL_DWT_Stage_t s_stages[HAL_DWT_STAGE_COUNT];
+
+/******************************************************************************/
+/*                   Definition of local functions                            */
+/******************************************************************************/
+
+/**
+ * \brief Returns the histogram bin of a duration.
+ *
+ * \param[in] cycles Duration, in core clock cycles.
+ *
+ * \return The bin, 0 to HAL_DWT_HIST_BINS - 1.
+ */
+static uint8_t HAL_DWT_Bin(uint32_t cycles)
+{
+    uint32_t log2;
+
+    if (cycles < (1UL << DWT_HIST_FIRST_LOG2))
+    {
+        return 0U;
+    }
+
+    /* CLZ instruction on the Cortex-M4 */
+    log2 = 31U - (uint32_t)__builtin_clz(cycles);
+    if ((log2 - DWT_HIST_FIRST_LOG2 + 1U) >= HAL_DWT_HIST_BINS)
+    {
+        return (uint8_t)(HAL_DWT_HIST_BINS - 1U);
+    }
+    return (uint8_t)(log2 - DWT_HIST_FIRST_LOG2 + 1U);
+}
+
+/******************************************************************************/
+/*                      Definition of exported functions                      */
+/******************************************************************************/
+
+/**
+ * \brief Enables the DWT cycle counter and clears the statistics.
+ *
+ * \details The counter keeps running while the core sleeps in WAIT mode, so a
+ *          stage that sleeps includes the time slept.
+ *
+ * \return void.
+ */
+void HAL_DWT_Init(void)
+{
+    memset(s_stages, 0, sizeof(s_stages));
+
+    DWT_DEMCR |= DWT_DEMCR_TRCENA_MASK;
+    DWT_CYCCNT = 0U;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA_MASK;
+}
+
+/**
+ * \brief Returns the DWT cycle counter.
+ *
+ * \return The current cycle count.
+ */
+uint32_t HAL_DWT_GetCycles(void)
+{
+    return DWT_CYCCNT;
+}
+
+/**
+ * \brief Records one duration of a stage.
+ *
+ * \details The count is incremented after the other fields, so that
+ *          HAL_DWT_GetStats() can detect a record that interleaved with its copy.
+ *
+ * \param[in] stage  HAL_DWT_STAGE_x.
+ * \param[in] cycles Duration, in core clock cycles.
+ *
+ * \return void.
+ */
+void HAL_DWT_Record(uint8_t stage, uint32_t cycles)
+{
+    HAL_DWT_Stage_t *entry;
+    uint8_t bin;
+
+    if (stage >= HAL_DWT_STAGE_COUNT)
+    {
+        return;
+    }
+
+    entry = &s_stages[stage];
+    if ((entry->count == 0U) || (cycles < entry->minCycles))
+    {
+        entry->minCycles = cycles;
+    }
+    if (cycles > entry->maxCycles)
+    {
+        entry->maxCycles = cycles;
+    }
+    entry->totalCycles += cycles;
+
+    bin = HAL_DWT_Bin(cycles);
+    if (entry->histogram[bin] < 0xFFFFU)
+    {
+        entry->histogram[bin]++;
+    }
+    DWT_COMPILER_BARRIER();
+    entry->count = entry->count + 1U;
+}
+
+/**
+ * \brief Returns the statistics of a stage.
+ *
+ * \details The copy is retried while the count changes under it, which only
+ *          happens when an interrupt records the stage meanwhile.
+ *
+ * \param[in]  stage HAL_DWT_STAGE_x.
+ * \param[out] stats Statistics of the stage.
+ *
+ * \return false if stage is out of range; true otherwise.
+ */
+bool HAL_DWT_GetStats(uint8_t stage, HAL_DWT_Stats_t *stats)
+{
+    const HAL_DWT_Stage_t *entry;
+    uint64_t total;
+    uint32_t count;
+
+    if (stage >= HAL_DWT_STAGE_COUNT)
+    {
+        return false;
+    }
+
+    entry = &s_stages[stage];
+    do
+    {
+        count = entry->count;
+        DWT_COMPILER_BARRIER();
+        stats->minCycles = entry->minCycles;
+        stats->maxCycles = entry->maxCycles;
+        total = entry->totalCycles;
+        memcpy(stats->histogram, entry->histogram, sizeof(stats->histogram));
+        DWT_COMPILER_BARRIER();
+    } while (count != entry->count);
+
+    stats->count = count;
+    stats->meanCycles = (count == 0U) ? 0U : (uint32_t)(total / count);
+    return true;
+}
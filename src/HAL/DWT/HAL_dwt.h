@@ -0,0 +1,134 @@
+/******************************************************************************/
+/*                                                                            */
+/*   S32K144 DWT HAL Module                                                   */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   This module measures the execution time of instrumented code stages with */
+/*   the Cortex-M4 DWT cycle counter and keeps, per stage, the minimum,       */
+/*   maximum and mean duration and a log2 histogram. The instrumentation      */
+/*   macros compile to nothing unless HAL_DWT_PROFILING is set.               */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef HAL_DWT_HAL_DWT_H_
+#define HAL_DWT_HAL_DWT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/*                Definition of exported symbolic constants               */
+/******************************************************************************/
+/**
+ * \brief Set to 1 to build the cycle counter instrumentation.
+ *
+ * \details With 0 (default) HAL_DWT_BEGIN() and HAL_DWT_END() expand to nothing,
+ *          so the instrumented code is the same as without them.
+ */
+#ifndef HAL_DWT_PROFILING
+#define HAL_DWT_PROFILING 0
+#endif
+
+/** \brief Stage: GPIO acquisition task. */
+#define HAL_DWT_STAGE_GPIO        0U
+
+/** \brief Stage: ADC acquisition and frame publication task. */
+#define HAL_DWT_STAGE_ADC         1U
+
+/** \brief Stage: SPI output update task. */
+#define HAL_DWT_STAGE_SPI         2U
+
+/** \brief Stage: task applying the settings written via I2C. */
+#define HAL_DWT_STAGE_I2C_CONFIG  3U
+
+/** \brief Stage: LPI2C slave interrupt (address match and end of transfer). */
+#define HAL_DWT_STAGE_I2C_ISR     4U
+
+/** \brief Number of instrumented stages. */
+#define HAL_DWT_STAGE_COUNT       5U
+
+/**
+ * \brief Number of histogram bins.
+ *
+ * \details Bin 0 counts durations below 32 cycles, bin n (1 to 14) durations in
+ *          [2^(n+4), 2^(n+5)) cycles and bin 15 durations of 2^19 cycles or more.
+ */
+#define HAL_DWT_HIST_BINS         16U
+
+#if (HAL_DWT_PROFILING != 0)
+/** \brief Starts timing a stage: declares the local variable start. */
+#define HAL_DWT_BEGIN(start)      uint32_t start = HAL_DWT_GetCycles()
+/** \brief Ends timing a stage started by HAL_DWT_BEGIN(start). */
+#define HAL_DWT_END(stage, start) HAL_DWT_Record((stage), HAL_DWT_GetCycles() - (start))
+#else
+#define HAL_DWT_BEGIN(start)
+#define HAL_DWT_END(stage, start)
+#endif
+
+/******************************************************************************/
+/*                Definition of exported types                                */
+/******************************************************************************/
+/**
+ * \brief Timing statistics of one stage, in core clock cycles.
+ */
+typedef struct
+{
+    uint32_t count;                          /**< Number of durations recorded. */
+    uint32_t minCycles;                      /**< Shortest duration (0 if none). */
+    uint32_t maxCycles;                      /**< Longest duration. */
+    uint32_t meanCycles;                     /**< Mean duration, rounded down. */
+    uint16_t histogram[HAL_DWT_HIST_BINS];   /**< Durations per bin, saturated at 0xFFFF. */
+} HAL_DWT_Stats_t;
+
+/******************************************************************************/
+/*                Declaration of exported function prototypes               */
+/******************************************************************************/
+
+/**
+ * \brief Enables the DWT cycle counter and clears the statistics.
+ *
+ * \return void.
+ */
+void HAL_DWT_Init(void);
+
+/**
+ * \brief Returns the DWT cycle counter.
+ *
+ * \details The counter increments at the core clock and wraps around at 2^32,
+ *          so durations must be computed with unsigned subtraction.
+ *
+ * \return The current cycle count.
+ */
+uint32_t HAL_DWT_GetCycles(void);
+
+/**
+ * \brief Records one duration of a stage.
+ *
+ * \details Each stage must be recorded from a single context (main loop or one
+ *          interrupt).
+ *
+ * \param[in] stage  HAL_DWT_STAGE_x.
+ * \param[in] cycles Duration, in core clock cycles.
+ *
+ * \return void.
+ */
+void HAL_DWT_Record(uint8_t stage, uint32_t cycles);
+
+/**
+ * \brief Returns the statistics of a stage.
+ *
+ * \details Called from the main loop. The copy is consistent even if the stage
+ *          is recorded from an interrupt meanwhile.
+ *
+ * \param[in]  stage HAL_DWT_STAGE_x.
+ * \param[out] stats Statistics of the stage.
+ *
+ * \return false if stage is out of range; true otherwise.
+ */
+bool HAL_DWT_GetStats(uint8_t stage, HAL_DWT_Stats_t *stats);
+
+#endif /* HAL_DWT_HAL_DWT_H_ */
@@ -5,86 +5,605 @@
 /*   Author:  Pablo Prez Fernndez                                           */
 /*   Date:    30/03/2025                                                      */
 /*                                                                            */
-/*   This module provides basic initialization and communication functions   */
-/*   for the I2C peripheral operating in slave mode on the S32K144. It performs */
-/*   a hardware reset of the I2C module, sets the slave address, configures the  */
-/*   I2C pins (using a 2-pin open drain configuration), and enables the module. */
-/*   Additionally, it offers simple functions for transmitting and receiving a  */
-/*   single byte using the LPI2C driver.                                      */
+/*   This module provides the initialization and interrupt handling for the  */
+/*   I2C peripheral operating in slave mode on the S32K144. The LPI2C slave     */
+/*   driver is run in listening mode with eDMA transfers: the data bytes are   */
+/*   moved by eDMA and only address match and STOP events are serviced from    */
+/*   the LPI2C slave ISR, which forwards them to the upper-layer handlers.     */
 /*                                                                            */
 /*   This software is provided free of charge.                              */
 /*                                                                            */
 /******************************************************************************/
 
+#include <stddef.h>
 #include "HAL_i2c.h"
-#include "lpi2c_hw_access.h"  /* Includes LPI2C driver definitions and functions */
+#include "lpi2c_driver.h"      /* LPI2C slave driver (DMA based) */
+#include "lpi2c_hw_access.h"   /* Slave enable and address registers */
+#include "peripherals_lpi2c_config_1.h"  /* lpi2c0_SlaveConfig0 */
+#include "clock_manager.h"
+#include "interrupt_manager.h"
+#include "edma_driver.h"
+#include "HAL_dma.h"
+#include "HAL_dwt.h"          /* Timing of the slave events (HAL_DWT_STAGE_I2C_ISR) */
 
 /******************************************************************************/
 /*                   Definition of local symbolic constants                 */
 /******************************************************************************/
-/** \brief I2C slave instance using LPI2C0 base address. */
-#define I2C_SLAVE_INSTANCE   ((LPI2C_Type *)LPI2C0_BASE)
+/** \brief LPI2C instance used as I2C slave. */
+#define I2C_SLAVE_INSTANCE   0U
 
-/** \brief I2C slave address. Adjust as necessary. */
-#define SLAVE_ADDRESS        0x3A
+/**
+ * \brief Fixed part of the slave SDA data valid delay and clock hold time, in
+ *        functional clock cycles.
+ *
+ * \details Data valid delay = FILTSCL + DATAVD + 3 cycles, clock hold time =
+ *          FILTSCL + CLKHOLD + 3 cycles (SCFGR2, with SCR[FILTEN] set).
+ */
+#define I2C_SLAVE_FIXED_CYCLES  3U
+
+/** \brief Width of the spikes the input filters must suppress (tSP), in ns. */
+#define I2C_SPIKE_NS            50U
+
+/** \brief Largest SCFGR2 glitch filter width, in cycles. */
+#define I2C_FILTER_MAX          (LPI2C_SCFGR2_FILTSCL_MASK >> LPI2C_SCFGR2_FILTSCL_SHIFT)
+
+/** \brief Largest SCFGR2 data valid delay, in cycles. */
+#define I2C_DATAVD_MAX          (LPI2C_SCFGR2_DATAVD_MASK >> LPI2C_SCFGR2_DATAVD_SHIFT)
+
+/** \brief Largest SCFGR2 clock hold time, in cycles. */
+#define I2C_CLKHOLD_MAX         (LPI2C_SCFGR2_CLKHOLD_MASK >> LPI2C_SCFGR2_CLKHOLD_SHIFT)
 
 /******************************************************************************/
-/*                      Definition of exported functions                      */
+/*                   Definition of local types                                */
+/******************************************************************************/
+/**
+ * \brief Timing requirements of an I2C bus mode (I2C specification, UM10204).
+ */
+typedef struct
+{
+    lpi2c_mode_t driverMode;  /**< Driver operating mode. */
+    uint32_t busRate;         /**< Maximum SCL frequency, in Hz. */
+    uint16_t setupNs;         /**< Minimum data setup time tSU;DAT, in ns. */
+    uint16_t holdNs;          /**< Internal SDA hold bridging the SCL fall time, in ns. */
+    uint16_t dataValidNs;     /**< Maximum data valid time tVD;DAT, in ns. */
+} i2c_bus_timing_t;
+
+/******************************************************************************/
+/*                   Definition of local variables                            */
+/******************************************************************************/
+/** \brief Internal state of the LPI2C slave driver. */
+static lpi2c_slave_state_t s_slaveState;
+
+/** \brief Upper-layer handlers registered in HAL_I2C_Init(). */
+static HAL_I2C_Callbacks_t s_callbacks;
+
+/**
+ * \brief Timing requirements of each bus mode, indexed by HAL_I2C_BusMode_t.
+ *
+ * \details The SDK has no Fm+ operating mode on this device
+ *          (LPI2C_HAS_FAST_PLUS_MODE = 0), so the Fm+ entry is only used where
+ *          the SDK enables it; HAL_I2C_ComputeTiming() refuses it otherwise.
+ */
+static const i2c_bus_timing_t s_busTimings[HAL_I2C_MODE_COUNT] = {
+    { LPI2C_STANDARD_MODE,  100000U, 250U, 300U, 3450U },
+    { LPI2C_FAST_MODE,      400000U, 100U, 300U,  900U },
+    { LPI2C_FAST_MODE,     1000000U,  50U, 120U,  450U }
+};
+
+/** \brief LPI2C0 functional clock, read by HAL_I2C_Init(). */
+static uint32_t s_functionalClk = 0U;
+
+/** \brief Bus mode the slave timing is configured for. */
+static HAL_I2C_BusMode_t s_busMode = HAL_I2C_MODE_STANDARD;
+
+/** \brief Fastest bus rate supported, set by HAL_I2C_Init(). */
+static uint32_t s_maxBusRate = 0U;
+
+/** \brief Run-time state of the eDMA channel used by the slave. */
+static edma_chn_state_t s_dmaState;
+
+/** \brief Reception buffer of a master write, filled by eDMA. */
+static uint8_t s_rxBlock[HAL_I2C_RX_BLOCK_LEN];
+
+/** \brief Sink of the bytes written past the end of s_rxBlock. */
+static uint8_t s_rxDiscard;
+
+/** \brief Byte transmitted past the end of the block of a master read. */
+static const uint8_t s_txPad = 0U;
+
+/** \brief Length of the block handed to eDMA for the transfer in progress. */
+static uint32_t s_blockLen = 0U;
+
+/** \brief true if the transfer in progress is a master read. */
+static bool s_txActive = false;
+
+/** \brief true if the transfer in progress is a master write. */
+static bool s_rxActive = false;
+
+/** \brief true once eDMA has moved the whole block (set by the eDMA ISR). */
+static volatile bool s_blockDone = false;
+
+/** \brief true once a major loop on s_txPad has ended (set by the eDMA ISR). */
+static volatile bool s_padLooped = false;
+
+/** \brief Repeated START count of the driver at the end of the last transfer. */
+static uint8_t s_repeatedStarts = 0U;
+
 /******************************************************************************/
+/*                   Definition of local functions                            */
+/******************************************************************************/
+
+/**
+ * \brief Notifies the upper layer of the slave address that matched.
+ *
+ * \details The driver has already read SASR to clear the address valid flag;
+ *          RADDR keeps the received address (7-bit address and R/W bit) until
+ *          the next address byte.
+ *
+ * \return void.
+ */
+static void HAL_I2C_NotifyStart(void)
+{
+    uint16_t receivedAddr;
+
+    if (s_callbacks.startCallback != NULL)
+    {
+        receivedAddr = LPI2C_Get_SlaveReceivedAddr(LPI2C0);
+        s_callbacks.startCallback((((receivedAddr >> 1U) & 0x7FU) == HAL_I2C_SLAVE_ADDRESS_SECONDARY) ?
+                                  HAL_I2C_ADDRESS_SECONDARY : HAL_I2C_ADDRESS_PRIMARY);
+    }
+}
 
 /**
- * \brief Initializes the I2C peripheral in slave mode.
+ * \brief Hands the block of a master read to the driver.
  *
- * \details This function resets the internal logic of the I2C module, sets the
- *          slave address using ADDR0, configures the I2C pins in 2-pin open drain
- *          mode, and enables the I2C module in slave mode.
+ * \details The driver starts the eDMA transfer right after this event. A read
+ *          with no block (or no transmit handler) sends s_txPad.
  *
  * \return void.
+ */
+static void HAL_I2C_StartTx(void)
+{
+    const uint8_t *block = NULL;
+    uint32_t length = 0U;
+
+    if (s_callbacks.txCallback != NULL)
+    {
+        length = s_callbacks.txCallback(&block);
+    }
+    if ((block == NULL) || (length == 0U))
+    {
+        block = &s_txPad;
+        length = 0U;
+    }
+
+    s_blockLen = length;
+    s_blockDone = (length == 0U);
+    s_padLooped = false;
+    s_txActive = true;
+    (void)LPI2C_DRV_SlaveSetTxBuffer(I2C_SLAVE_INSTANCE, block, (length == 0U) ? 1U : length);
+}
+
+/**
+ * \brief Hands the reception buffer of a master write to the driver.
+ *
+ * \details The driver starts a transmit transfer whenever it holds a transmit
+ *          buffer, so the one left by the previous read is dropped first.
+ *
+ * \return void.
+ */
+static void HAL_I2C_StartRx(void)
+{
+    s_slaveState.txSize = 0U;
+    s_blockLen = HAL_I2C_RX_BLOCK_LEN;
+    s_blockDone = false;
+    s_padLooped = false;
+    s_rxActive = true;
+    (void)LPI2C_DRV_SlaveSetRxBuffer(I2C_SLAVE_INSTANCE, s_rxBlock, HAL_I2C_RX_BLOCK_LEN);
+}
+
+/**
+ * \brief Ends the transfer in progress and notifies the upper layer.
+ *
+ * \details The driver has already stopped the eDMA channel. The received bytes
+ *          are delivered first, then the stop handler gets the number of bytes
+ *          of the transmit block the master actually read. eDMA loads STDR one
+ *          byte ahead of the master, so a byte still in STDR (TDF clear) was
+ *          counted by the channel but never sent: it is left out of the count
+ *          and flushed, so it cannot lead the next read. Once the block is done
+ *          the channel restarts its major loop on s_txPad, so a full iteration
+ *          count means the byte in STDR is the last one of the block, unless
+ *          a loop on s_txPad has ended since and the byte is a pad byte. The
+ *          driver reports STOP and repeated START alike, but counts the
+ *          repeated STARTs: a change of the count since the last transfer tells
+ *          them apart.
  *
- * \note This is a basic initialization. For full I2C register management, additional
- *       protocol layers (e.g., handling multi-byte transactions) should be implemented.
+ * \return void.
  */
-void HAL_I2C_Init(void)
+static void HAL_I2C_EndTransfer(void)
 {
-    /* Perform a software reset of the I2C slave module */
-    LPI2C_Set_SlaveSoftwareReset(I2C_SLAVE_INSTANCE, true);
-    LPI2C_Set_SlaveSoftwareReset(I2C_SLAVE_INSTANCE, false);
+    uint32_t count = 0U;
+    uint32_t remaining = 0U;
+    bool stdrLoaded;
+    bool repeatedStart;
+    uint32_t i;
 
-    /* Set the slave address using ADDR0 */
-    LPI2C_Set_SlaveAddr0(I2C_SLAVE_INSTANCE, SLAVE_ADDRESS);
+    if (s_txActive || s_rxActive)
+    {
+        remaining = EDMA_DRV_GetRemainingMajorIterationsCount(HAL_DMA_CH_I2C);
+        count = s_blockDone ? s_blockLen : (s_blockLen - remaining);
+    }
+    if (s_txActive)
+    {
+        stdrLoaded = ((LPI2C0->SSR & LPI2C_SSR_TDF_MASK) == 0U);
+        if (stdrLoaded && (count > 0U) &&
+            (!s_blockDone || (!s_padLooped && (remaining == s_blockLen))))
+        {
+            count--;
+        }
+    }
 
-    /* Configure the I2C pins.
-       Typically, I2C uses 2-pin open drain configuration. */
-    LPI2C_Set_MasterPinConfig(I2C_SLAVE_INSTANCE, LPI2C_CFG_2PIN_OPEN_DRAIN);
+    if (s_rxActive && (s_callbacks.rxCallback != NULL))
+    {
+        for (i = 0U; i < count; i++)
+        {
+            s_callbacks.rxCallback(s_rxBlock[i]);
+        }
+    }
+    if (s_txActive)
+    {
+        LPI2C0->SCR |= LPI2C_SCR_RTF_MASK;
+    }
+    repeatedStart = (s_slaveState.repeatedStarts != s_repeatedStarts);
+    s_repeatedStarts = s_slaveState.repeatedStarts;
+    if (s_callbacks.stopCallback != NULL)
+    {
+        s_callbacks.stopCallback(s_txActive ? count : 0U, repeatedStart);
+    }
 
-    /* Enable the I2C module in slave mode */
-    LPI2C_Set_SlaveEnable(I2C_SLAVE_INSTANCE, true);
+    s_txActive = false;
+    s_rxActive = false;
+    s_blockLen = 0U;
 }
 
 /**
- * \brief Transmits a single byte over I2C as a slave.
+ * \brief eDMA major loop callback, executed in interrupt context.
  *
- * \details Uses the LPI2C driver function to send a byte from the slave module.
+ * \details Raised when the whole block has been moved while the master keeps
+ *          clocking. The driver configures the channel without disabling its
+ *          request on completion, so the channel is pointed at s_txPad or
+ *          s_rxDiscard: further reads return 0 and further written bytes are
+ *          dropped instead of running past the buffers.
  *
- * \param[in] data The byte to transmit.
+ * \param[in] parameter Unused.
+ * \param[in] status    Unused.
  *
  * \return void.
  */
-void HAL_I2C_SlaveTransmit(uint8_t data)
+static void HAL_I2C_DmaBlockEnd(void *parameter, edma_chn_status_t status)
 {
-    /* Transmit a byte using the driver function */
-    LPI2C_Transmit_SlaveData(I2C_SLAVE_INSTANCE, data);
+    (void)parameter;
+    (void)status;
+
+    s_padLooped = s_blockDone;
+    s_blockDone = true;
+    if (s_txActive)
+    {
+        EDMA_DRV_SetSrcAddr(HAL_DMA_CH_I2C, (uint32_t)&s_txPad);
+        EDMA_DRV_SetSrcOffset(HAL_DMA_CH_I2C, 0);
+        EDMA_DRV_SetSrcLastAddrAdjustment(HAL_DMA_CH_I2C, 0);
+    }
+    else
+    {
+        EDMA_DRV_SetDestAddr(HAL_DMA_CH_I2C, (uint32_t)&s_rxDiscard);
+        EDMA_DRV_SetDestOffset(HAL_DMA_CH_I2C, 0);
+    }
 }
 
 /**
- * \brief Receives a single byte over I2C as a slave.
+ * \brief LPI2C slave driver callback, executed in interrupt context.
  *
- * \details Reads a byte from the I2C slave data register using the driver function.
+ * \details With eDMA transfers the driver only raises events for the address
+ *          match and the end of the transfer:
+ *          - RX_REQ   (address match, write): notify the address, hand over
+ *                     the reception buffer.
+ *          - TX_REQ   (address match, read): notify the address, hand over
+ *                     the block to transmit.
+ *          - STOP     : deliver the received bytes and notify the end of the
+ *                       transfer (also raised on repeated START).
+ *          Each event, including the upper layer handlers, is timed as
+ *          HAL_DWT_STAGE_I2C_ISR when profiling is built in.
+ *
+ * \param[in] event     Slave event reported by the driver.
+ * \param[in] userData  Unused.
+ *
+ * \return void.
+ */
+static void HAL_I2C_SlaveCallback(i2c_slave_event_t event, void *userData)
+{
+    HAL_DWT_BEGIN(start);
+
+    (void)userData;
+
+    switch (event)
+    {
+        case I2C_SLAVE_EVENT_RX_REQ:
+            HAL_I2C_NotifyStart();
+            HAL_I2C_StartRx();
+            break;
+
+        case I2C_SLAVE_EVENT_TX_REQ:
+            HAL_I2C_NotifyStart();
+            HAL_I2C_StartTx();
+            break;
+
+        case I2C_SLAVE_EVENT_STOP:
+            HAL_I2C_EndTransfer();
+            break;
+
+        default:
+            /* Nothing to do */
+            break;
+    }
+
+    HAL_DWT_END(HAL_DWT_STAGE_I2C_ISR, start);
+}
+
+/**
+ * \brief Converts a duration into functional clock cycles.
+ *
+ * \param[in] ns      Duration, in ns (at most 65535).
+ * \param[in] roundUp true to round up, false to round down.
+ *
+ * \return The number of cycles of s_functionalClk.
+ */
+static uint32_t HAL_I2C_NsToCycles(uint32_t ns, bool roundUp)
+{
+    /* kHz * ns stays below 2^32 for any LPI2C clock */
+    uint32_t product = (s_functionalClk / 1000U) * ns;
+
+    return (product + (roundUp ? 999999U : 0U)) / 1000000U;
+}
+
+/**
+ * \brief Computes the SCFGR2 value of a bus mode.
+ *
+ * \details The data valid time is the hard limit: the filters are made as wide
+ *          as tSP requires, but narrowed if they would push the SDA delay past
+ *          tVD;DAT. DATAVD then stretches the delay up to the internal hold
+ *          time, and CLKHOLD keeps SCL low for at least tSU;DAT after the data
+ *          is written when the slave stretches the clock.
+ *
+ * \param[in]  mode   Bus mode.
+ * \param[out] scfgr2 Value to program in SCFGR2.
+ *
+ * \return false if the device does not support the mode or the data valid time
+ *         cannot be met with this clock.
+ */
+static bool HAL_I2C_ComputeTiming(HAL_I2C_BusMode_t mode, uint32_t *scfgr2)
+{
+    const i2c_bus_timing_t *timing = &s_busTimings[mode];
+    uint32_t validCycles = HAL_I2C_NsToCycles(timing->dataValidNs, false);
+    uint32_t holdCycles = HAL_I2C_NsToCycles(timing->holdNs, true);
+    uint32_t setupCycles = HAL_I2C_NsToCycles(timing->setupNs, true);
+    uint32_t filter = HAL_I2C_NsToCycles(I2C_SPIKE_NS, true);
+    uint32_t dataValid = 0U;
+    uint32_t clockHold = 0U;
+
+    if ((s_functionalClk == 0U) || (validCycles < I2C_SLAVE_FIXED_CYCLES))
+    {
+        return false;
+    }
+#if (LPI2C_HAS_FAST_PLUS_MODE == 0U)
+    if (mode == HAL_I2C_MODE_FAST_PLUS)
+    {
+        return false;
+    }
+#endif
+
+    if (filter > I2C_FILTER_MAX)
+    {
+        filter = I2C_FILTER_MAX;
+    }
+    if ((filter + I2C_SLAVE_FIXED_CYCLES) > validCycles)
+    {
+        filter = validCycles - I2C_SLAVE_FIXED_CYCLES;
+    }
+    if (holdCycles > (filter + I2C_SLAVE_FIXED_CYCLES))
+    {
+        dataValid = holdCycles - filter - I2C_SLAVE_FIXED_CYCLES;
+        if ((filter + dataValid + I2C_SLAVE_FIXED_CYCLES) > validCycles)
+        {
+            dataValid = validCycles - filter - I2C_SLAVE_FIXED_CYCLES;
+        }
+        if (dataValid > I2C_DATAVD_MAX)
+        {
+            dataValid = I2C_DATAVD_MAX;
+        }
+    }
+    if (setupCycles > (filter + I2C_SLAVE_FIXED_CYCLES))
+    {
+        clockHold = setupCycles - filter - I2C_SLAVE_FIXED_CYCLES;
+        if (clockHold > I2C_CLKHOLD_MAX)
+        {
+            clockHold = I2C_CLKHOLD_MAX;
+        }
+    }
+
+    *scfgr2 = LPI2C_SCFGR2_FILTSDA(filter) | LPI2C_SCFGR2_FILTSCL(filter) |
+              LPI2C_SCFGR2_DATAVD(dataValid) | LPI2C_SCFGR2_CLKHOLD(clockHold);
+    return true;
+}
+
+/**
+ * \brief Programs the slave timing.
+ *
+ * \details SCFGR2 may only be written while the slave is disabled. The filters
+ *          and the DATAVD/CLKHOLD counters only work with SCR[FILTEN] set.
+ *
+ * \param[in] scfgr2 Value computed by HAL_I2C_ComputeTiming().
+ *
+ * \return void.
+ */
+static void HAL_I2C_ApplyTiming(uint32_t scfgr2)
+{
+    LPI2C_Type *base = LPI2C0;
+
+    LPI2C_Set_SlaveEnable(base, false);
+    base->SCFGR2 = scfgr2;
+    base->SCR |= LPI2C_SCR_FILTEN_MASK;
+    LPI2C_Set_SlaveEnable(base, true);
+}
+
+/**
+ * \brief Enables the secondary slave address comparator.
+ *
+ * \details The driver only programs ADDR0. SAMR and SCFGR1 may only be written
+ *          while the slave is disabled; it is re-enabled by HAL_I2C_ApplyTiming().
+ *
+ * \return void.
+ */
+static void HAL_I2C_EnableSecondaryAddress(void)
+{
+    LPI2C_Type *base = LPI2C0;
+
+    LPI2C_Set_SlaveEnable(base, false);
+    base->SAMR = (base->SAMR & ~LPI2C_SAMR_ADDR1_MASK) |
+                 LPI2C_SAMR_ADDR1((uint32_t)HAL_I2C_SLAVE_ADDRESS_SECONDARY);
+    LPI2C_Set_SlaveAddrConfig(base, LPI2C_SLAVE_ADDR_MATCH_0_7BIT_OR_1_7BIT);
+}
+
+/******************************************************************************/
+/*                      Definition of exported functions                      */
+/******************************************************************************/
+
+/**
+ * \brief Initializes the I2C peripheral in DMA-driven slave mode.
+ *
+ * \details This function takes the board slave configuration (lpi2c0_SlaveConfig0),
+ *          overrides the slave address and installs the local driver callback, then
+ *          initializes LPI2C0 with LPI2C_DRV_SlaveInit(). In listening mode with
+ *          eDMA the driver only enables the address valid, STOP/repeated START and
+ *          error interrupts, and starts HAL_DMA_CH_I2C on every address match;
+ *          LPI2C0_Slave_IRQHandler() dispatches those events to
+ *          LPI2C_DRV_SlaveIRQHandler(), which in turn calls the handlers given here.
+ *          The slave also answers HAL_I2C_SLAVE_ADDRESS_SECONDARY through ADDR1. The
+ *          slave timing is derived from the LPI2C0 functional clock and set
+ *          up for Fast-mode (Standard-mode if the clock is too slow).
+ *
+ * \param[in] callbacks Upper-layer handlers (copied, may be NULL).
+ *
+ * \return void.
+ */
+void HAL_I2C_Init(const HAL_I2C_Callbacks_t *callbacks)
+{
+    lpi2c_slave_user_config_t slaveConfig = lpi2c0_SlaveConfig0;
+    edma_channel_config_t chnConfig = {
+        .channelPriority = EDMA_CHN_DEFAULT_PRIORITY,
+        .virtChnConfig = HAL_DMA_CH_I2C,
+        .source = EDMA_REQ_LPI2C0_RX,
+        .callback = HAL_I2C_DmaBlockEnd,
+        .callbackParam = NULL,
+        .enableTrigger = false
+    };
+    uint32_t scfgr2 = 0U;
+    uint8_t mode;
+
+    s_functionalClk = 0U;
+    (void)CLOCK_SYS_GetFreq(LPI2C0_CLK, &s_functionalClk);
+
+    /* Fastest mode the clock can serve */
+    s_maxBusRate = 0U;
+    for (mode = 0U; mode < (uint8_t)HAL_I2C_MODE_COUNT; mode++)
+    {
+        if (HAL_I2C_ComputeTiming((HAL_I2C_BusMode_t)mode, &scfgr2))
+        {
+            s_maxBusRate = s_busTimings[mode].busRate;
+        }
+    }
+
+    /* Start in Fast-mode, which also serves a Standard-mode master */
+    s_busMode = HAL_I2C_MODE_FAST;
+    if (!HAL_I2C_ComputeTiming(s_busMode, &scfgr2))
+    {
+        s_busMode = HAL_I2C_MODE_STANDARD;
+        scfgr2 = 0U;
+        (void)HAL_I2C_ComputeTiming(s_busMode, &scfgr2);
+    }
+
+    if (callbacks != NULL)
+    {
+        s_callbacks = *callbacks;
+    }
+
+    /* The driver reselects the request source for each transfer direction */
+    (void)EDMA_DRV_ChannelInit(&s_dmaState, &chnConfig);
+
+    /* Always-listening slave, data phases moved by eDMA */
+    slaveConfig.slaveAddress = HAL_I2C_SLAVE_ADDRESS;
+    slaveConfig.slaveListening = true;
+    slaveConfig.operatingMode = s_busTimings[s_busMode].driverMode;
+    slaveConfig.transferType = LPI2C_USING_DMA;
+    slaveConfig.dmaChannel = HAL_DMA_CH_I2C;
+    slaveConfig.slaveCallback = HAL_I2C_SlaveCallback;
+    slaveConfig.callbackParam = NULL;
+
+    (void)LPI2C_DRV_SlaveInit(I2C_SLAVE_INSTANCE, &slaveConfig, &s_slaveState);
+    HAL_I2C_EnableSecondaryAddress();
+    HAL_I2C_ApplyTiming(scfgr2);
+}
+
+/**
+ * \brief Selects the bus mode the slave timing is configured for.
+ *
+ * \details The slave is briefly disabled while SCFGR2 is rewritten, so the
+ *          change is refused while it takes part in a transfer (SSR[SBF]).
+ *          Transfers addressed to other nodes are not disturbed: the slave
+ *          resynchronizes on the next START.
+ *
+ * \param[in] mode Bus mode.
+ *
+ * \return true if the mode is now in effect, false if it is invalid, cannot
+ *         be met with the functional clock, or the slave is busy.
+ */
+bool HAL_I2C_SetBusMode(HAL_I2C_BusMode_t mode)
+{
+    uint32_t scfgr2 = 0U;
+    bool applied = false;
+
+    if ((mode >= HAL_I2C_MODE_COUNT) || !HAL_I2C_ComputeTiming(mode, &scfgr2))
+    {
+        return false;
+    }
+
+    INT_SYS_DisableIRQGlobal();
+    if ((LPI2C0->SSR & LPI2C_SSR_SBF_MASK) == 0U)
+    {
+        HAL_I2C_ApplyTiming(scfgr2);
+        s_busMode = mode;
+        applied = true;
+    }
+    INT_SYS_EnableIRQGlobal();
+
+    return applied;
+}
+
+/**
+ * \brief Returns the bus mode the slave timing is configured for.
+ *
+ * \return The current bus mode.
+ */
+HAL_I2C_BusMode_t HAL_I2C_GetBusMode(void)
+{
+    return s_busMode;
+}
+
+/**
+ * \brief Returns the fastest I2C bus rate the slave supports.
  *
- * \return The received byte.
+ * \return The SCL frequency, in Hz.
  */
-uint8_t HAL_I2C_SlaveReceive(void)
+uint32_t HAL_I2C_GetMaxBusRate(void)
 {
-    /* Read and return a byte received by the I2C slave module */
-    return LPI2C_Get_SlaveData(I2C_SLAVE_INSTANCE);
+    return s_maxBusRate;
 }
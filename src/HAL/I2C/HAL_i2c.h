@@ -5,9 +5,9 @@
 /*   Author:  Pablo Prez Fernndez                                           */
 /*   Date:    30/03/2025                                                      */
 /*                                                                            */
-/*   This module provides basic functions for initializing the I2C          */
-/*   peripheral in slave mode and for transmitting and receiving a single   */
-/*   byte over I2C.                                                           */
+/*   This module provides functions for initializing the I2C peripheral in   */
+/*   DMA-driven slave mode and for registering the handlers that are called   */
+/*   from the slave ISR at the start and at the end of every transfer.        */
 /*                                                                            */
 /*   This software is provided free of charge.                              */
 /*                                                                            */
@@ -18,7 +18,7 @@
  * \brief I2C HAL Interface.
  *
  * This header declares the functions used for initializing the I2C module in
- * slave mode and for simple byte-level communication.
+ * slave mode and the callback types used to hand bytes to the upper layer.
  *
  * \note This implementation uses the LPI2C driver for the S32K144.
  *
@@ -31,31 +31,143 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+/******************************************************************************/
+/*                Definition of exported symbolic constants                 */
+/******************************************************************************/
+/** \brief Index of the primary slave address (ADDR0, register map). */
+#define HAL_I2C_ADDRESS_PRIMARY    0U
+
+/** \brief Index of the secondary slave address (ADDR1, status bank). */
+#define HAL_I2C_ADDRESS_SECONDARY  1U
+
+/** \brief 7-bit primary slave address. Adjust as necessary. */
+#define HAL_I2C_SLAVE_ADDRESS            0x3AU
+
+/** \brief 7-bit secondary slave address. Adjust as necessary. */
+#define HAL_I2C_SLAVE_ADDRESS_SECONDARY  0x3BU
+
+/** \brief Largest number of bytes delivered from one master write. */
+#define HAL_I2C_RX_BLOCK_LEN       32U
+
+/******************************************************************************/
+/*                Definition of exported types                              */
+/******************************************************************************/
+
+/**
+ * \brief I2C bus modes the slave timing can be configured for.
+ */
+typedef enum
+{
+    HAL_I2C_MODE_STANDARD = 0,   /**< Standard-mode, up to 100 kHz. */
+    HAL_I2C_MODE_FAST,           /**< Fast-mode, up to 400 kHz. */
+    HAL_I2C_MODE_FAST_PLUS,      /**< Fast-mode Plus, up to 1 MHz (not on the S32K144). */
+    HAL_I2C_MODE_COUNT
+} HAL_I2C_BusMode_t;
+
+/**
+ * \brief Callback invoked from the I2C slave ISR on address match, before the
+ *        first byte of the transfer.
+ *
+ * \param[in] address Slave address that matched (HAL_I2C_ADDRESS_x).
+ */
+typedef void (*HAL_I2C_StartCallback_t)(uint8_t address);
+
 /**
- * \brief Initializes the I2C peripheral in slave mode.
+ * \brief Callback invoked from the I2C slave ISR for every byte written by the master.
  *
- * \details This function resets the internal logic of the I2C module, sets the slave
- *          address, configures the I2C pins in 2-pin open drain mode, and enables
- *          the I2C module for slave operation.
+ * \details The bytes of a write are received by eDMA and delivered in order
+ *          when the transfer ends, before the stop handler.
  *
- * \return void.
+ * \param[in] data The received byte.
  */
-void HAL_I2C_Init(void);
+typedef void (*HAL_I2C_RxCallback_t)(uint8_t data);
 
 /**
- * \brief Transmits a single byte via I2C as a slave.
+ * \brief Callback invoked from the I2C slave ISR when the master starts a read.
  *
- * \param[in] data The byte to be transmitted.
+ * \details The block is transmitted by eDMA and must stay unchanged until the
+ *          stop handler is called. Bytes read past its end are 0.
+ *
+ * \param[out] block First byte of the block to be transmitted to the master.
+ *
+ * \return The length of the block, in bytes (0 if there is nothing to send).
+ */
+typedef uint32_t (*HAL_I2C_TxCallback_t)(const uint8_t **block);
+
+/**
+ * \brief Callback invoked from the I2C slave ISR on STOP or repeated START.
+ *
+ * \param[in] bytesRead     Number of bytes of the block fetched for the master
+ *                          (0 for a write).
+ * \param[in] repeatedStart true if the transfer ended with a repeated START,
+ *                          false on STOP.
+ */
+typedef void (*HAL_I2C_StopCallback_t)(uint32_t bytesRead, bool repeatedStart);
+
+/**
+ * \brief Set of upper-layer handlers called from the I2C slave interrupt.
+ *
+ * \details Any member may be NULL. All handlers run in interrupt context, on
+ *          address match or at the end of the transfer, and must therefore be
+ *          kept short.
+ */
+typedef struct
+{
+    HAL_I2C_StartCallback_t startCallback; /**< Address match, start of a transfer. */
+    HAL_I2C_RxCallback_t    rxCallback;    /**< Byte received from the master. */
+    HAL_I2C_TxCallback_t    txCallback;    /**< Block requested by the master. */
+    HAL_I2C_StopCallback_t  stopCallback;  /**< End of the current transfer. */
+} HAL_I2C_Callbacks_t;
+
+/******************************************************************************/
+/*                Declaration of exported function prototypes               */
+/******************************************************************************/
+
+/**
+ * \brief Initializes the I2C peripheral in DMA-driven slave mode.
+ *
+ * \details This function initializes LPI2C0 through the SDK slave driver in
+ *          listening mode and registers the given handlers. The data bytes are
+ *          moved by eDMA (HAL_DMA_CH_I2C); only address matches and STOP
+ *          conditions are serviced from the LPI2C slave interrupt. The slave
+ *          answers two addresses, told apart by the start handler. HAL_DMA_Init()
+ *          must have been called before.
+ *
+ * \param[in] callbacks Upper-layer handlers (copied, may be NULL).
  *
  * \return void.
  */
-void HAL_I2C_SlaveTransmit(uint8_t data);
+void HAL_I2C_Init(const HAL_I2C_Callbacks_t *callbacks);
 
 /**
- * \brief Receives a single byte via I2C as a slave.
+ * \brief Selects the bus mode the slave timing is configured for.
+ *
+ * \details Programs the SDA/SCL glitch filters (tSP), the SDA data valid delay
+ *          (internal hold time within tVD;DAT) and the clock hold time (tSU;DAT)
+ *          derived from the LPI2C0 functional clock.
+ *
+ * \param[in] mode Bus mode.
+ *
+ * \return true if the mode is now in effect; false if it is invalid, cannot be
+ *         met with the functional clock, or the slave is in a transfer.
+ */
+bool HAL_I2C_SetBusMode(HAL_I2C_BusMode_t mode);
+
+/**
+ * \brief Returns the bus mode the slave timing is configured for.
+ *
+ * \return The current bus mode.
+ */
+HAL_I2C_BusMode_t HAL_I2C_GetBusMode(void);
+
+/**
+ * \brief Returns the fastest I2C bus rate the slave supports.
+ *
+ * \details Derived in HAL_I2C_Init() from the LPI2C0 functional clock: the
+ *          fastest mode whose data valid time the slave can meet.
  *
- * \return The received byte.
+ * \return The SCL frequency, in Hz (0 if the LPI2C0 clock is not running).
  */
-uint8_t HAL_I2C_SlaveReceive(void);
+uint32_t HAL_I2C_GetMaxBusRate(void);
 
 #endif /* I2C_H */
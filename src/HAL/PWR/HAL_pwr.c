@@ -0,0 +1,77 @@
+/******************************************************************************/
+/*                                                                            */
+/*   S32K144 PWR HAL Module                                                   */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   This module implements the idle policy of the application: WFI in Sleep */
+/*   mode. The core clock is gated while the bus and system clocks keep the   */
+/*   PDB/eDMA ADC scan, LPIT, LPI2C and PORT interrupts running, so every     */
+/*   wake-up source (IC address match, pin change, ADC alarm, timer tick)    */
+/*   keeps working and wakes the core within the interrupt entry latency.     */
+/*   Deeper modes (STOP, VLPS) gate the system clock and would stop the eDMA  */
+/*   scan, so they are not used while it runs.                                */
+/*                                                                            */
+/*   This software is provided free of charge.                              */
+/*                                                                            */
+/******************************************************************************/
+
+#include "HAL_pwr.h"
+#include "interrupt_manager.h"
+#include "S32K144.h"
+
+/******************************************************************************/
+/*                   Definition of local variables                            */
+/******************************************************************************/
+/** \brief Number of times the core has been put to sleep. */
+static uint32_t s_sleepCount = 0U;
+
+/******************************************************************************/
+/*                      Definition of exported functions                      */
+/******************************************************************************/
+
+/**
+ * \brief Initializes the low-power idle.
+ *
+ * \details Clears SLEEPDEEP, so WFI enters Sleep rather than a STOP mode, and
+ *          SLEEPONEXIT, so the core returns to the main loop after each interrupt.
+ *
+ * \return void.
+ */
+void HAL_PWR_Init(void)
+{
+    S32_SCB->SCR &= ~(S32_SCB_SCR_SLEEPDEEP_MASK | S32_SCB_SCR_SLEEPONEXIT_MASK);
+    s_sleepCount = 0U;
+}
+
+/**
+ * \brief Stops the core until the next interrupt, unless work is pending.
+ *
+ * \details WFI wakes up on a pending interrupt even while PRIMASK masks it, so the
+ *          check can be done with interrupts disabled without losing a wake-up.
+ *
+ * \param[in] workPending Function checking for pending work.
+ *
+ * \return void.
+ */
+void HAL_PWR_Idle(HAL_PWR_WorkPending_t workPending)
+{
+    INT_SYS_DisableIRQGlobal();
+    if (!workPending())
+    {
+        s_sleepCount++;
+        STANDBY();
+    }
+    INT_SYS_EnableIRQGlobal();
+}
+
+/**
+ * \brief Returns the number of times the core has been put to sleep.
+ *
+ * \return The number of WFI executed by HAL_PWR_Idle().
+ */
+uint32_t HAL_PWR_GetSleepCount(void)
+{
+    return s_sleepCount;
+}
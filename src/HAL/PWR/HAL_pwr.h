@@ -0,0 +1,66 @@
+/******************************************************************************/
+/*                                                                            */
+/*   S32K144 PWR HAL Module                                                   */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   This module provides the low-power idle used by the main loop when no   */
+/*   task is due: the core is stopped until the next interrupt.               */
+/*                                                                            */
+/*   This software is provided free of charge.                              */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef HAL_PWR_HAL_PWR_H_
+#define HAL_PWR_HAL_PWR_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/*                Definition of exported types                                */
+/******************************************************************************/
+/**
+ * \brief Function telling whether there is work to do before idling.
+ *
+ * \return true if work is pending, so the core must not sleep.
+ */
+typedef bool (*HAL_PWR_WorkPending_t)(void);
+
+/******************************************************************************/
+/*                Declaration of exported function prototypes               */
+/******************************************************************************/
+
+/**
+ * \brief Initializes the low-power idle.
+ *
+ * \details Selects the Sleep mode (core clock gated, peripherals running) for
+ *          WFI.
+ *
+ * \return void.
+ */
+void HAL_PWR_Init(void);
+
+/**
+ * \brief Stops the core until the next interrupt, unless work is pending.
+ *
+ * \details The work check and the WFI are done with interrupts masked, so an
+ *          interrupt that makes work pending right after the check still wakes
+ *          the core and is never slept through. The interrupt is serviced when
+ *          this function returns.
+ *
+ * \param[in] workPending Function checking for pending work.
+ *
+ * \return void.
+ */
+void HAL_PWR_Idle(HAL_PWR_WorkPending_t workPending);
+
+/**
+ * \brief Returns the number of times the core has been put to sleep.
+ *
+ * \return The number of WFI executed by HAL_PWR_Idle().
+ */
+uint32_t HAL_PWR_GetSleepCount(void);
+
+#endif /* HAL_PWR_HAL_PWR_H_ */
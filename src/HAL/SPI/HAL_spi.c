@@ -6,11 +6,18 @@
  *
  *   This module provides basic initialization and communication functions
  *   for the SPI peripheral on the S32K144. The SPI is configured as a master,
- *   using LPSPI0. It is set up for:
- *      - A source clock frequency of 60 MHz.
- *      - A baud rate of 1 MHz.
+ *   using LPSPI0 through the SDK master driver. It is set up for:
+ *      - The LPSPI0 functional clock, as reported by the clock manager.
+ *      - The fastest baud rate it allows within the ISO1H816G SCK limit.
  *      - Mode 3 operation (CPOL = 1, CPHA = 1), 8-bit frames, MSB first.
  *      - Chip Select (PCS) active low.
+ *   Frames are moved between memory and the LPSPI FIFOs by the eDMA, so the
+ *   CPU is only involved at the start and at the end of a transfer. The
+ *   blocking full-duplex transfer is a polled loop that keeps the FIFOs busy
+ *   instead, which is cheaper than setting up the eDMA for a few bytes.
+ *   The chip select stays asserted for the whole of a transfer (continuous
+ *   transfer mode), which is what a daisy chain of ISO1H816G devices needs to
+ *   latch all of its bytes at once.
  *
  *   This software is provided free of charge.
  *
@@ -20,23 +27,200 @@
                            INCLUDE FILES
 ==============================================================================*/
 #include <HAL_spi.h>
-#include "lpspi_hw_access.h"   /* Includes LPSPI driver definitions and functions */
+#include <stddef.h>
+#include <string.h>
+#include "lpspi_master_driver.h"  /* LPSPI master driver (DMA transfers) */
+#include "edma_driver.h"
+#include "HAL_dma.h"
+#include "HAL_tim.h"
+#include "clock_manager.h"
 
 /*==============================================================================
                  LOCAL SYMBOLIC CONSTANTS AND MACROS
 ==============================================================================*/
-/** \brief SPI instance: using LPSPI0 base address */
-#define SPI_INSTANCE    ((LPSPI_Type *)LPSPI0_BASE)
+/** \brief SPI instance: LPSPI0 */
+#define SPI_INSTANCE    0U
 
-/** \brief Source clock frequency for SPI (60 MHz) */
-static const uint32_t srcClk = 60000000U;
-/** \brief Desired SPI baud rate (1 MHz) */
-static const uint32_t baudrate = 1000000U;
+/** \brief SPI base address, for the polled transfers */
+#define SPI_BASE        LPSPI0
+
+/** \brief Timeout of the blocking transfers, in milliseconds */
+#define SPI_TIMEOUT_MS  10U
+
+/** \brief Number of SCK prescaler settings (TCR.PRESCALE: divide by 1..128) */
+#define SPI_PRESCALER_COUNT  8U
+
+/** \brief Largest SCK divider (CCR.SCKDIV + 2) */
+#define SPI_SCKDIV_MAX       257U
 
 /*==============================================================================
                       LOCAL FUNCTION PROTOTYPES
 ==============================================================================*/
-// (None)
+static void HAL_SPI_TransferDone(void *driverState, spi_event_t event, void *userData);
+static void HAL_SPI_InitDmaChannel(edma_chn_state_t *state, uint8_t channel, dma_request_source_t source);
+static uint32_t HAL_SPI_FastestBaudRate(uint32_t srcClk, uint32_t maxHz);
+static uint32_t HAL_SPI_LoadFrame(const uint8_t *txBuffer, uint32_t offset, uint32_t frameBytes);
+static void HAL_SPI_StoreFrame(uint8_t *rxBuffer, uint32_t offset, uint32_t frameBytes, uint32_t data);
+static bool HAL_SPI_Expired(uint32_t start, uint32_t timeout);
+
+/*==============================================================================
+                      LOCAL VARIABLE DEFINITIONS
+==============================================================================*/
+/** \brief Run-time state of the LPSPI master driver */
+static lpspi_state_t s_spiState;
+
+/** \brief Run-time state of the eDMA channels used by the LPSPI */
+static edma_chn_state_t s_spiRxDmaState;
+static edma_chn_state_t s_spiTxDmaState;
+
+/** \brief SCK frequency achieved by HAL_SPI_Init(), in Hz */
+static uint32_t s_baudRate = 0U;
+
+/** \brief Private copy of the data of the asynchronous transfer in progress */
+static uint8_t s_asyncTxBuffer[HAL_SPI_ASYNC_MAX_LEN];
+
+/** \brief Function called when the asynchronous transfer in progress ends */
+static volatile HAL_SPI_Callback_t s_asyncCallback = NULL;
+
+/*==============================================================================
+                      LOCAL FUNCTION DEFINITIONS
+==============================================================================*/
+/**
+ * \brief Transfer complete callback of the LPSPI master driver.
+ *
+ * \details Called from the LPSPI interrupt at the end of every transfer,
+ *          blocking ones included. Only asynchronous transfers register a user
+ *          callback, which is consumed here.
+ *
+ * \return void.
+ */
+static void HAL_SPI_TransferDone(void *driverState, spi_event_t event, void *userData)
+{
+    HAL_SPI_Callback_t callback = s_asyncCallback;
+
+    (void)driverState;
+    (void)userData;
+
+    if ((event == SPI_EVENT_END_TRANSFER) && (callback != NULL))
+    {
+        s_asyncCallback = NULL;
+        callback(LPSPI_DRV_MasterGetTransferStatus(SPI_INSTANCE, NULL) == STATUS_SUCCESS);
+    }
+}
+
+/**
+ * \brief Initializes one of the eDMA channels used by the LPSPI.
+ *
+ * \details The transfer descriptors and the channel callbacks are programmed by
+ *          the LPSPI driver at the start of every transfer.
+ *
+ * \return void.
+ */
+static void HAL_SPI_InitDmaChannel(edma_chn_state_t *state, uint8_t channel, dma_request_source_t source)
+{
+    edma_channel_config_t chnConfig = {
+        .channelPriority = EDMA_CHN_DEFAULT_PRIORITY,
+        .virtChnConfig = channel,
+        .source = source,
+        .callback = NULL,
+        .callbackParam = NULL,
+        .enableTrigger = false
+    };
+
+    (void)EDMA_DRV_ChannelInit(state, &chnConfig);
+}
+
+/**
+ * \brief Returns the fastest SCK frequency not above maxHz.
+ *
+ * \details SCK = srcClk / (2^PRESCALE * (SCKDIV + 2)). The smallest prescaler is
+ *          used, with the smallest divider that keeps SCK within the limit. The
+ *          result is exactly achievable, so the driver programs it without
+ *          rounding up.
+ *
+ * \return The SCK frequency, in Hz, or 0 if srcClk is 0.
+ */
+static uint32_t HAL_SPI_FastestBaudRate(uint32_t srcClk, uint32_t maxHz)
+{
+    uint32_t prescaler;
+
+    for (prescaler = 0U; prescaler < SPI_PRESCALER_COUNT; prescaler++)
+    {
+        uint32_t step = maxHz << prescaler;
+        uint32_t divider = (srcClk + step - 1U) / step;
+
+        if (divider < 2U)
+        {
+            divider = 2U;
+        }
+        if (divider <= SPI_SCKDIV_MAX)
+        {
+            return srcClk / (divider << prescaler);
+        }
+    }
+    return 0U;
+}
+
+/**
+ * \brief Returns the TDR word of the frame starting at offset.
+ *
+ * \details A 4-byte frame is loaded little-endian; the byte swap set in the TCR
+ *          then shifts out the byte at the lowest address first.
+ *
+ * \return The word to write to the TDR.
+ */
+static uint32_t HAL_SPI_LoadFrame(const uint8_t *txBuffer, uint32_t offset, uint32_t frameBytes)
+{
+    uint32_t data = 0U;
+
+    if (txBuffer != NULL)
+    {
+        if (frameBytes == 4U)
+        {
+            data = (uint32_t)txBuffer[offset] |
+                   ((uint32_t)txBuffer[offset + 1U] << 8U) |
+                   ((uint32_t)txBuffer[offset + 2U] << 16U) |
+                   ((uint32_t)txBuffer[offset + 3U] << 24U);
+        }
+        else
+        {
+            data = txBuffer[offset];
+        }
+    }
+    return data;
+}
+
+/**
+ * \brief Stores the RDR word of the frame starting at offset.
+ *
+ * \return void.
+ */
+static void HAL_SPI_StoreFrame(uint8_t *rxBuffer, uint32_t offset, uint32_t frameBytes, uint32_t data)
+{
+    if (rxBuffer != NULL)
+    {
+        rxBuffer[offset] = (uint8_t)data;
+        if (frameBytes == 4U)
+        {
+            rxBuffer[offset + 1U] = (uint8_t)(data >> 8U);
+            rxBuffer[offset + 2U] = (uint8_t)(data >> 16U);
+            rxBuffer[offset + 3U] = (uint8_t)(data >> 24U);
+        }
+    }
+}
+
+/**
+ * \brief Checks whether a polled transfer has run out of time.
+ *
+ * \param[in] start   Timebase value when the transfer started.
+ * \param[in] timeout Time allowed, in timebase ticks.
+ *
+ * \return true once more than timeout ticks have elapsed since start.
+ */
+static bool HAL_SPI_Expired(uint32_t start, uint32_t timeout)
+{
+    return (HAL_TIM_GetTicks() - start) > timeout;
+}
 
 /*==============================================================================
                             GLOBAL FUNCTION DEFINITIONS
@@ -45,71 +229,68 @@ static const uint32_t baudrate = 1000000U;
 /**
  * \brief Initializes the SPI peripheral.
  *
- * \details This function initializes the LPSPI module with the following settings:
- *          - The SPI module is reset to its default state.
- *          - The source clock is set to 60 MHz and the desired baud rate is 1 MHz.
- *          - The SPI operates in master mode with active-low chip select.
- *          - The Transmit Command Register (TCR) is configured for:
- *              - 8-bit frames.
- *              - Mode 3 operation: CPOL = 1 (clock idle high) and CPHA = 1 (data sampled on the second edge).
- *              - MSB first data order.
+ * \details This function initializes the LPSPI master driver with the following
+ *          settings:
+ *          - The source clock is read from the clock manager and the baud
+ *            rate is the fastest one within HAL_SPI_MAX_SCK_HZ.
+ *          - 8-bit frames, MSB first, chip select PCS2 active low.
+ *          - Continuous transfer: the driver sets TCR.CONT (contTransfer) and
+ *            keeps CONTC (contCmd) set while the frames are queued, so PCS2 is
+ *            asserted once per transfer instead of once per frame.
+ *          - Mode 3 operation: CPOL = 1 (clock idle high) and CPHA = 1 (data
+ *            sampled on the second edge).
+ *          - DMA transfers on HAL_DMA_CH_SPI_RX / HAL_DMA_CH_SPI_TX.
  *
  * \return void.
  */
 void HAL_SPI_Init(void)
 {
-    lpspi_init_config_t spiInitConfig;
-    lpspi_tx_cmd_config_t txCmdConfig;
-    uint32_t prescale;
-
-    /* Initialize the LPSPI module to default values */
-    LPSPI_Init(SPI_INSTANCE);
-
-    /* Set up the initialization structure */
-    spiInitConfig.lpspiSrcClk = srcClk;
-    spiInitConfig.baudRate = baudrate;
-    spiInitConfig.lpspiMode = LPSPI_MASTER;
-    spiInitConfig.pcsPol = LPSPI_ACTIVE_LOW; /* Chip select active low */
-
-    /* Configure the baud rate and obtain the prescaler value for TCR */
-    (void)LPSPI_SetBaudRate(SPI_INSTANCE, spiInitConfig.baudRate, spiInitConfig.lpspiSrcClk, &prescale);
-
-    /* Configure the Transmit Command Register (TCR) for:
-       - 8-bit frames.
-       - Single bit transfer (normal mode).
-       - No masking for transmit or receive.
-       - No continuous command or transfer.
-       - Byte swap disabled.
-       - MSB first.
-       - Use PCS2 (ensure it matches your pin mux settings).
-       - Prescaler as obtained.
-       - Mode 3 (CPOL = 1, CPHA = 1) configuration.
-    */
-    txCmdConfig.frameSize = 8U;                      /* 8 bits per frame */
-    txCmdConfig.width = LPSPI_SINGLE_BIT_XFER;       /* Normal 1-bit transfer */
-    txCmdConfig.txMask = false;
-    txCmdConfig.rxMask = false;
-    txCmdConfig.contCmd = false;                     /* No continuous commands */
-    txCmdConfig.contTransfer = false;
-    txCmdConfig.byteSwap = false;
-    txCmdConfig.lsbFirst = false;                    /* MSB first */
-    txCmdConfig.whichPcs = LPSPI_PCS2;               /* Ensure PCS matches your configuration */
-    txCmdConfig.preDiv = prescale;                   /* Prescaler obtained above */
-    txCmdConfig.clkPolarity = LPSPI_SCK_ACTIVE_HIGH; /* Clock idle high (CPOL = 1) */
-    txCmdConfig.clkPhase = LPSPI_CLOCK_PHASE_2ND_EDGE; /* Data captured on second edge (CPHA = 1) */
-
-    /* Apply the TCR configuration */
-    LPSPI_SetTxCommandReg(SPI_INSTANCE, &txCmdConfig);
-
-    /* Enable the SPI module */
-    LPSPI_Enable(SPI_INSTANCE);
+    uint32_t srcClk = 0U;
+
+    (void)CLOCK_SYS_GetFreq(LPSPI0_CLK, &srcClk);
+
+    lpspi_master_config_t spiConfig = {
+        .bitsPerSec = HAL_SPI_FastestBaudRate(srcClk, HAL_SPI_MAX_SCK_HZ),
+        .whichPcs = LPSPI_PCS2,                       /* Ensure PCS matches your pin mux settings */
+        .pcsPolarity = LPSPI_ACTIVE_LOW,              /* Chip select active low */
+        .isPcsContinuous = true,                      /* One CS assertion per transfer */
+        .bitcount = 8U,                               /* 8 bits per frame */
+        .lpspiSrcClk = srcClk,
+        .clkPhase = LPSPI_CLOCK_PHASE_2ND_EDGE,       /* Data captured on second edge (CPHA = 1) */
+        .clkPolarity = LPSPI_SCK_ACTIVE_HIGH,         /* Clock idle high (CPOL = 1) */
+        .lsbFirst = false,                            /* MSB first */
+        .transferType = LPSPI_USING_DMA,
+        .rxDMAChannel = HAL_DMA_CH_SPI_RX,
+        .txDMAChannel = HAL_DMA_CH_SPI_TX,
+        .callback = HAL_SPI_TransferDone,
+        .callbackParam = NULL
+    };
+
+    HAL_SPI_InitDmaChannel(&s_spiRxDmaState, HAL_DMA_CH_SPI_RX, EDMA_REQ_LPSPI0_RX);
+    HAL_SPI_InitDmaChannel(&s_spiTxDmaState, HAL_DMA_CH_SPI_TX, EDMA_REQ_LPSPI0_TX);
+
+    (void)LPSPI_DRV_MasterInit(SPI_INSTANCE, &s_spiState, &spiConfig);
+
+    /* Configure the bus again, only to read back the rate really programmed */
+    s_baudRate = 0U;
+    (void)LPSPI_DRV_MasterConfigureBus(SPI_INSTANCE, &spiConfig, &s_baudRate);
+}
+
+/**
+ * \brief Returns the SCK frequency achieved by HAL_SPI_Init().
+ *
+ * \return The SCK frequency, in Hz.
+ */
+uint32_t HAL_SPI_GetBaudRate(void)
+{
+    return s_baudRate;
 }
 
 /**
  * \brief Transmits a single byte via SPI.
  *
- * \details This function writes a byte to the transmit data register (TDR)
- *          and polls until the transfer is complete.
+ * \details This function starts a one-frame transfer and waits, at most
+ *          SPI_TIMEOUT_MS, until it is complete.
  *
  * \param[in] data  The byte to transmit.
  *
@@ -117,50 +298,197 @@ void HAL_SPI_Init(void)
  */
 void HAL_SPI_Transmit(uint8_t data)
 {
-    /* Write the data to the TDR */
-    LPSPI_WriteData(SPI_INSTANCE, (uint32_t)data);
+    (void)LPSPI_DRV_MasterTransferBlocking(SPI_INSTANCE, &data, NULL, 1U, SPI_TIMEOUT_MS);
+}
 
-    /* Poll until the transfer complete flag is set */
-    while (!LPSPI_GetStatusFlag(SPI_INSTANCE, LPSPI_TRANSFER_COMPLETE))
+/**
+ * \brief Starts a transmit-only SPI transfer and returns immediately.
+ *
+ * \details The received frames are masked (no RX DMA), the transfer ends when
+ *          the TX DMA has emptied the buffer and the LPSPI reports transfer
+ *          complete.
+ *
+ * \param[in] txBuffer  Pointer to the data to transmit.
+ * \param[in] size      Number of bytes to transmit (1..HAL_SPI_ASYNC_MAX_LEN).
+ * \param[in] callback  Function called on completion, or NULL.
+ *
+ * \return true if the transfer was started, false otherwise.
+ */
+bool HAL_SPI_TransmitAsync(const uint8_t *txBuffer, uint32_t size, HAL_SPI_Callback_t callback)
+{
+    if ((txBuffer == NULL) || (size == 0U) || (size > HAL_SPI_ASYNC_MAX_LEN) || HAL_SPI_IsBusy())
     {
-        /* Active waiting */
+        return false;
     }
 
-    /* Optionally, clear the transfer complete flag if required:
-       LPSPI_ClearStatusFlag(SPI_INSTANCE, LPSPI_TRANSFER_COMPLETE);
-    */
+    (void)memcpy(s_asyncTxBuffer, txBuffer, size);
+    s_asyncCallback = callback;
+
+    if (LPSPI_DRV_MasterTransfer(SPI_INSTANCE, s_asyncTxBuffer, NULL, (uint16_t)size) != STATUS_SUCCESS)
+    {
+        s_asyncCallback = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * \brief Updates a bank of daisy-chained ISO1H816G devices.
+ *
+ * \details The bytes are reversed into the private transfer buffer, so that the
+ *          byte of the last device is shifted out first and the byte of device
+ *          0 ends up in device 0, and sent as one continuous transfer.
+ *
+ * \param[in] deviceConfig Output configuration of each device, device 0 first.
+ * \param[in] deviceCount  Number of chained devices (1..HAL_SPI_CHAIN_MAX_DEVICES).
+ * \param[in] callback     Function called on completion, or NULL.
+ *
+ * \return true if the transfer was started, false otherwise.
+ */
+bool HAL_SPI_WriteChainAsync(const uint8_t *deviceConfig, uint8_t deviceCount, HAL_SPI_Callback_t callback)
+{
+    uint8_t chain[HAL_SPI_CHAIN_MAX_DEVICES];
+    uint8_t device;
+
+    if ((deviceConfig == NULL) || (deviceCount == 0U) || (deviceCount > HAL_SPI_CHAIN_MAX_DEVICES))
+    {
+        return false;
+    }
+
+    for (device = 0U; device < deviceCount; device++)
+    {
+        chain[deviceCount - 1U - device] = deviceConfig[device];
+    }
+
+    return HAL_SPI_TransmitAsync(chain, deviceCount, callback);
+}
+
+/**
+ * \brief Checks whether a transfer is in progress.
+ *
+ * \return true while a transfer is in progress.
+ */
+bool HAL_SPI_IsBusy(void)
+{
+    return LPSPI_DRV_MasterGetTransferStatus(SPI_INSTANCE, NULL) == STATUS_BUSY;
 }
 
 /**
  * \brief Performs a full-duplex SPI data transfer.
  *
- * \details This function sends a block of data via SPI and reads the data received
- *          simultaneously. It uses polling for each byte transfer.
+ * \details Polled, FIFO-pipelined transfer that bypasses the eDMA. A new frame
+ *          is written as soon as the TX FIFO has room, as long as fewer than a
+ *          FIFO depth of frames are in flight, so the RX FIFO can never overflow,
+ *          and every received frame is read as soon as the RX FIFO holds it. The
+ *          TCR of the driver is replaced for the duration of the transfer:
+ *          - continuous transfer, so the chip select is asserted once;
+ *          - with HAL_SPI_TRANSFER_PACK32, 32-bit frames with byte swap when the
+ *            size is a multiple of 4, 8-bit frames otherwise.
+ *          It is restored, together with the chip select, once the last frame
+ *          has been received. The whole transfer is bounded by SPI_TIMEOUT_MS:
+ *          the timebase is only read in the passes that move no frame, so the
+ *          pipelined loop keeps its pace. On timeout, the frames still queued
+ *          are flushed before the TCR is restored.
  *
- * \param[in]  txBuffer  Pointer to the buffer containing data to transmit.
- * \param[out] rxBuffer  Pointer to the buffer where received data will be stored.
+ * \param[in]  txBuffer  Pointer to the buffer containing data to transmit, or NULL.
+ * \param[out] rxBuffer  Pointer to the buffer where received data will be stored, or NULL.
  * \param[in]  size      Number of bytes to transfer.
  *
- * \return void.
+ * \return true if the transfer was done, false if the bus is busy or the
+ *         transfer timed out.
  */
-void HAL_SPI_Transfer(uint8_t *txBuffer, uint8_t *rxBuffer, uint32_t size)
+bool HAL_SPI_Transfer(const uint8_t *txBuffer, uint8_t *rxBuffer, uint32_t size)
 {
-    uint32_t i;
+    uint32_t driverTcr = SPI_BASE->TCR;
+    uint32_t frameBytes = 1U;
+    uint32_t txOffset = 0U;
+    uint32_t rxOffset = 0U;
+    uint32_t start = HAL_TIM_GetTicks();
+    uint32_t timeout = (HAL_TIM_GetTickHz() / 1000U) * SPI_TIMEOUT_MS;
+    bool timedOut = false;
+    bool moved;
+    uint8_t fifoSize;
+    lpspi_tx_cmd_config_t txCmdConfig;
 
-    for (i = 0; i < size; i++)
+    if (HAL_SPI_IsBusy() || LPSPI_GetStatusFlag(SPI_BASE, LPSPI_MODULE_BUSY))
+    {
+        return false;
+    }
+    if (size == 0U)
+    {
+        return true;
+    }
+#if (HAL_SPI_TRANSFER_PACK32 != 0)
+    if ((size % 4U) == 0U)
     {
-        /* Transmit the byte from the txBuffer */
-        LPSPI_WriteData(SPI_INSTANCE, (uint32_t)txBuffer[i]);
+        frameBytes = 4U;
+    }
+#endif
+
+    LPSPI_GetFifoSizes(SPI_BASE, &fifoSize);
+    LPSPI_SetFlushFifoCmd(SPI_BASE, true, true);
+    (void)LPSPI_ClearStatusFlag(SPI_BASE, LPSPI_ALL_STATUS);
+
+    /* Same bus settings as the driver, keeping its prescaler */
+    txCmdConfig.frameSize = frameBytes * 8U;
+    txCmdConfig.width = LPSPI_SINGLE_BIT_XFER;
+    txCmdConfig.txMask = false;
+    txCmdConfig.rxMask = false;
+    txCmdConfig.contCmd = false;
+    txCmdConfig.contTransfer = true;                   /* One CS assertion for all frames */
+    txCmdConfig.byteSwap = (frameBytes == 4U);         /* Lowest address shifted out first */
+    txCmdConfig.lsbFirst = false;
+    txCmdConfig.whichPcs = LPSPI_PCS2;
+    txCmdConfig.preDiv = (driverTcr & LPSPI_TCR_PRESCALE_MASK) >> LPSPI_TCR_PRESCALE_SHIFT;
+    txCmdConfig.clkPolarity = LPSPI_SCK_ACTIVE_HIGH;
+    txCmdConfig.clkPhase = LPSPI_CLOCK_PHASE_2ND_EDGE;
+    LPSPI_SetTxCommandReg(SPI_BASE, &txCmdConfig);
 
-        /* Wait until the transfer is complete */
-        while (!LPSPI_GetStatusFlag(SPI_INSTANCE, LPSPI_TRANSFER_COMPLETE))
+    while ((rxOffset < size) && !timedOut)
+    {
+        moved = false;
+        if ((txOffset < size) &&
+            ((txOffset - rxOffset) < (fifoSize * frameBytes)) &&
+            (LPSPI_ReadTxCount(SPI_BASE) < fifoSize))
+        {
+            LPSPI_WriteData(SPI_BASE, HAL_SPI_LoadFrame(txBuffer, txOffset, frameBytes));
+            txOffset += frameBytes;
+            moved = true;
+        }
+        if (LPSPI_ReadRxCount(SPI_BASE) != 0U)
+        {
+            HAL_SPI_StoreFrame(rxBuffer, rxOffset, frameBytes, LPSPI_ReadData(SPI_BASE));
+            rxOffset += frameBytes;
+            moved = true;
+        }
+        if (!moved)
         {
-            /* Active waiting */
+            timedOut = HAL_SPI_Expired(start, timeout);
         }
+    }
+    if (timedOut)
+    {
+        /* Drop the frames still queued, so the command below is not stuck
+           behind them */
+        LPSPI_SetFlushFifoCmd(SPI_BASE, true, true);
+    }
 
-        /* Read the received byte into rxBuffer */
-        rxBuffer[i] = (uint8_t)LPSPI_ReadData(SPI_INSTANCE);
+    /* End the continuous transfer (releases the chip select) and give the
+       TCR back to the driver */
+    txCmdConfig.contTransfer = false;
+    LPSPI_SetTxCommandReg(SPI_BASE, &txCmdConfig);
+    while (!timedOut && LPSPI_GetStatusFlag(SPI_BASE, LPSPI_MODULE_BUSY))
+    {
+        timedOut = HAL_SPI_Expired(start, timeout);
+    }
+    if (timedOut)
+    {
+        LPSPI_SetFlushFifoCmd(SPI_BASE, true, true);
     }
+    SPI_BASE->TCR = driverTcr;
+
+    return !timedOut;
 }
 
 /*******************************************************************************
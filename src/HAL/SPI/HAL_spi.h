@@ -7,10 +7,15 @@
  *   This module provides basic initialization and communication functions for
  *   the SPI peripheral on the S32K144. It configures the SPI to operate in
  *   master mode with the following settings:
- *     - Source clock: 60 MHz
- *     - Baud rate: 1 MHz
+ *     - Source clock: LPSPI0 functional clock, read from the clock manager
+ *     - Baud rate: fastest achievable one not above HAL_SPI_MAX_SCK_HZ
  *     - Mode 3 operation (CPOL = 1, CPHA = 1), 8-bit frames, MSB first
  *     - Active-low Chip Select (PCS)
+ *   Transmissions are moved by the eDMA, either asynchronously with a
+ *   completion callback or blocking; full-duplex transfers are polled with
+ *   the FIFOs kept full. Up to HAL_SPI_CHAIN_MAX_DEVICES daisy-chained
+ *   ISO1H816G devices are updated in one transfer, under a single chip select
+ *   assertion.
  *
  *   This software is provided free of charge.
  *
@@ -23,9 +28,43 @@
 #define HAL_SPI_HAL_SPI_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "device_registers.h"
 #include "lpspi_hw_access.h"
 
+/******************************************************************************/
+/*                Definition of exported symbolic constants               */
+/******************************************************************************/
+/** \brief Maximum SCK frequency of the ISO1H816G serial interface, in Hz. */
+#define HAL_SPI_MAX_SCK_HZ      5000000U
+
+/** \brief Largest transfer accepted by HAL_SPI_TransmitAsync(), in bytes. */
+#define HAL_SPI_ASYNC_MAX_LEN   16U
+
+/** \brief Largest number of daisy-chained ISO1H816G devices (one byte each). */
+#define HAL_SPI_CHAIN_MAX_DEVICES 8U
+
+/**
+ * \brief Set to 1 to let HAL_SPI_Transfer() pack four bytes per 32-bit frame.
+ *
+ * \details Only used for transfers whose size is a multiple of 4. The bytes go
+ *          out in memory order either way, since the chip select is held for the
+ *          whole transfer; packing just divides the FIFO accesses by four.
+ */
+#ifndef HAL_SPI_TRANSFER_PACK32
+#define HAL_SPI_TRANSFER_PACK32 1
+#endif
+
+/******************************************************************************/
+/*                Definition of exported types                                */
+/******************************************************************************/
+/**
+ * \brief Function called from the interrupt when an asynchronous transfer ends.
+ *
+ * \param[in] success false if the transfer was aborted by an eDMA or LPSPI error.
+ */
+typedef void (*HAL_SPI_Callback_t)(bool success);
+
 /******************************************************************************/
 /*                Declaration of exported function prototypes               */
 /******************************************************************************/
@@ -33,19 +72,29 @@
 /**
  * \brief Initializes the SPI peripheral.
  *
- * \details This function configures the SPI peripheral (using LPSPI0) with a
- *          source clock of 60 MHz, a baud rate of 1 MHz, and settings for Mode 3
- *          operation (CPOL=1, CPHA=1). The chip select is active low.
+ * \details This function configures the SPI peripheral (using LPSPI0) with the
+ *          fastest baud rate the LPSPI0 functional clock allows without exceeding
+ *          HAL_SPI_MAX_SCK_HZ, and settings for Mode 3 operation (CPOL=1, CPHA=1). The chip select is active low and held
+ *          for the whole of a transfer. The eDMA
+ *          channels HAL_DMA_CH_SPI_RX and HAL_DMA_CH_SPI_TX are claimed.
  *
  * \return void.
+ *
+ * \note HAL_DMA_Init() must have been called.
  */
 void HAL_SPI_Init(void);
 
+/**
+ * \brief Returns the SCK frequency achieved by HAL_SPI_Init().
+ *
+ * \return The SCK frequency, in Hz (0 if the LPSPI0 clock is not running).
+ */
+uint32_t HAL_SPI_GetBaudRate(void);
+
 /**
  * \brief Transmits a single byte via SPI.
  *
- * \details This function sends one byte by writing to the SPI transmit data register,
- *          and waits until the transfer is complete.
+ * \details This function sends one byte and waits until the transfer is complete.
  *
  * \param[in] data  The byte to transmit.
  *
@@ -53,19 +102,65 @@ void HAL_SPI_Init(void);
  */
 void HAL_SPI_Transmit(uint8_t data);
 
+/**
+ * \brief Starts a transmit-only SPI transfer and returns immediately.
+ *
+ * \details The data is copied into an internal buffer, so the caller's buffer may
+ *          be reused as soon as the function returns. The bytes are moved to the
+ *          TX FIFO by the eDMA and the callback is called from the LPSPI
+ *          interrupt once the last frame has been shifted out.
+ *
+ * \param[in] txBuffer  Pointer to the data to transmit.
+ * \param[in] size      Number of bytes to transmit (1..HAL_SPI_ASYNC_MAX_LEN).
+ * \param[in] callback  Function called on completion, or NULL.
+ *
+ * \return true if the transfer was started, false if the bus is busy or the
+ *         size is out of range.
+ */
+bool HAL_SPI_TransmitAsync(const uint8_t *txBuffer, uint32_t size, HAL_SPI_Callback_t callback);
+
+/**
+ * \brief Updates a bank of daisy-chained ISO1H816G devices.
+ *
+ * \details Device 0 is the one whose SDI is wired to the MCU. The bytes are
+ *          shifted out last device first, as one continuous transfer, so every
+ *          device has latched its own byte when the chip select is released.
+ *          Returns immediately like HAL_SPI_TransmitAsync().
+ *
+ * \param[in] deviceConfig Output configuration of each device, device 0 first.
+ * \param[in] deviceCount  Number of chained devices (1..HAL_SPI_CHAIN_MAX_DEVICES).
+ * \param[in] callback     Function called on completion, or NULL.
+ *
+ * \return true if the transfer was started, false if the bus is busy or the
+ *         device count is out of range.
+ */
+bool HAL_SPI_WriteChainAsync(const uint8_t *deviceConfig, uint8_t deviceCount, HAL_SPI_Callback_t callback);
+
+/**
+ * \brief Checks whether a transfer is in progress.
+ *
+ * \return true while a transfer is in progress.
+ */
+bool HAL_SPI_IsBusy(void);
+
 /**
  * \brief Performs a full-duplex SPI data transfer.
  *
  * \details This function transmits a block of data while simultaneously receiving
- *          data from the SPI peripheral. The function uses polling to wait for each
- *          transfer to complete.
+ *          data from the SPI peripheral. The TX FIFO is kept filled and the RX
+ *          FIFO drained by polling, so the frames go out back to back under a
+ *          single chip select assertion. The function returns when the transfer
+ *          is complete, or after at most 10 ms if the LPSPI stalls.
  *
- * \param[in]  txBuffer  Pointer to the buffer containing data to transmit.
- * \param[out] rxBuffer  Pointer to the buffer where received data will be stored.
+ * \param[in]  txBuffer  Pointer to the buffer containing data to transmit, or
+ *                       NULL to send zeros.
+ * \param[out] rxBuffer  Pointer to the buffer where received data will be stored,
+ *                       or NULL to discard it.
  * \param[in]  size      Number of bytes to transfer.
  *
- * \return void.
+ * \return true if the transfer was done, false if an asynchronous transfer is
+ *         in progress or the transfer timed out.
  */
-void HAL_SPI_Transfer(uint8_t *txBuffer, uint8_t *rxBuffer, uint32_t size);
+bool HAL_SPI_Transfer(const uint8_t *txBuffer, uint8_t *rxBuffer, uint32_t size);
 
 #endif /* HAL_SPI_HAL_SPI_H_ */
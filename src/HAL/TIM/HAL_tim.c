@@ -0,0 +1,151 @@
+/******************************************************************************/
+/*                                                                            */
+/*   S32K144 TIM HAL Module                                                   */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   This module runs LPIT0 channel 0 as a free-running 32-bit down counter   */
+/*   clocked by the LPIT0 functional clock and exposes it as an up-counting   */
+/*   timestamp. Channel 1 generates the periodic tick interrupt. The SDK      */
+/*   snapshot has no LPIT driver, so the timer is programmed through the      */
+/*   device registers.                                                        */
+/*                                                                            */
+/*   This software is provided free of charge.                              */
+/*                                                                            */
+/******************************************************************************/
+
+#include "HAL_tim.h"
+#include <stddef.h>
+#include "clock_manager.h"
+#include "interrupt_manager.h"
+#include "S32K144.h"
+
+/******************************************************************************/
+/*                   Definition of local symbolic constants                 */
+/******************************************************************************/
+/** \brief LPIT0 channel used as the free-running timebase. */
+#define TIM_TIMEBASE_CHANNEL  0U
+
+/** \brief LPIT0 channel used for the periodic tick. */
+#define TIM_TICK_CHANNEL      1U
+
+/**
+ * \brief Functional clock cycles LPIT0 needs after MCR[M_CEN] is set before its
+ *        timer registers can be written.
+ */
+#define TIM_ENABLE_CYCLES     4U
+
+/******************************************************************************/
+/*                   Definition of local variables                            */
+/******************************************************************************/
+/** \brief Frequency of the timebase, read from the clock manager. */
+static uint32_t s_tickHz = 0U;
+
+/** \brief Function called on every periodic tick. */
+static HAL_TIM_TickCallback_t s_tickCallback = NULL;
+
+/******************************************************************************/
+/*                   Declaration of interrupt handlers                        */
+/******************************************************************************/
+void LPIT0_Ch1_IRQHandler(void);
+
+/******************************************************************************/
+/*                      Definition of exported functions                      */
+/******************************************************************************/
+
+/**
+ * \brief Initializes and starts the free-running timebase.
+ *
+ * \details Enables the LPIT0 module (also while debugging, so timestamps stay
+ *          consistent when halted), loads the channel with the largest period
+ *          and starts it in 32-bit periodic counter mode without interrupt.
+ *          Writes to the timer registers are ignored until TIM_ENABLE_CYCLES
+ *          functional clock cycles after the module is enabled, so the core
+ *          waits that long first, as LPIT_Enable() of the SDK does. Each loop
+ *          iteration takes at least one core cycle.
+ *
+ * \return void.
+ */
+void HAL_TIM_Init(void)
+{
+    uint32_t coreHz = 0U;
+    volatile uint32_t delay;
+
+    (void)CLOCK_SYS_GetFreq(LPIT0_CLK, &s_tickHz);
+    (void)CLOCK_SYS_GetFreq(CORE_CLK, &coreHz);
+
+    LPIT0->MCR = LPIT_MCR_M_CEN_MASK | LPIT_MCR_DBG_EN_MASK;
+    delay = (s_tickHz == 0U) ? 0U : (TIM_ENABLE_CYCLES * ((coreHz / s_tickHz) + 1U));
+    while (delay != 0U)
+    {
+        delay--;
+    }
+    LPIT0->TMR[TIM_TIMEBASE_CHANNEL].TCTRL = 0U;
+    LPIT0->TMR[TIM_TIMEBASE_CHANNEL].TVAL = 0xFFFFFFFFUL;
+    LPIT0->TMR[TIM_TIMEBASE_CHANNEL].TCTRL = LPIT_TMR_TCTRL_T_EN_MASK;
+}
+
+/**
+ * \brief Returns the current timestamp.
+ *
+ * \details LPIT counts down from TVAL, so the value is complemented to obtain an
+ *          up-counting timestamp.
+ *
+ * \return The current value of the timebase, in ticks.
+ */
+uint32_t HAL_TIM_GetTicks(void)
+{
+    return ~LPIT0->TMR[TIM_TIMEBASE_CHANNEL].CVAL;
+}
+
+/**
+ * \brief Returns the frequency of the timebase.
+ *
+ * \return Ticks per second.
+ */
+uint32_t HAL_TIM_GetTickHz(void)
+{
+    return s_tickHz;
+}
+
+/**
+ * \brief Starts the periodic tick interrupt.
+ *
+ * \details Loads LPIT0 channel 1 with the period matching the requested rate and
+ *          starts it in 32-bit periodic counter mode with its interrupt enabled.
+ *
+ * \param[in] rateHz   Tick rate, in ticks per second.
+ * \param[in] callback Function called from the interrupt on every tick.
+ *
+ * \return void.
+ */
+void HAL_TIM_StartTick(uint32_t rateHz, HAL_TIM_TickCallback_t callback)
+{
+    DEV_ASSERT((rateHz > 0U) && (rateHz <= s_tickHz));
+    DEV_ASSERT(callback != NULL);
+
+    s_tickCallback = callback;
+
+    LPIT0->TMR[TIM_TICK_CHANNEL].TCTRL = 0U;
+    LPIT0->TMR[TIM_TICK_CHANNEL].TVAL = (s_tickHz / rateHz) - 1U;
+    LPIT0->MSR = LPIT_MSR_TIF1_MASK;
+    LPIT0->MIER |= LPIT_MIER_TIE1_MASK;
+    INT_SYS_EnableIRQ(LPIT0_Ch1_IRQn);
+    LPIT0->TMR[TIM_TICK_CHANNEL].TCTRL = LPIT_TMR_TCTRL_T_EN_MASK;
+}
+
+/******************************************************************************/
+/*                     Definition of interrupt handlers                       */
+/******************************************************************************/
+
+/**
+ * \brief LPIT0 channel 1 interrupt handler (periodic tick).
+ *
+ * \return void.
+ */
+void LPIT0_Ch1_IRQHandler(void)
+{
+    LPIT0->MSR = LPIT_MSR_TIF1_MASK;
+    s_tickCallback();
+}
@@ -0,0 +1,69 @@
+/******************************************************************************/
+/*                                                                            */
+/*   S32K144 TIM HAL Module                                                   */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   This module provides a free-running 32-bit timebase, based on LPIT0,    */
+/*   used to timestamp events captured by the other HAL modules, and a        */
+/*   periodic tick interrupt for work that must run at a fixed rate.          */
+/*                                                                            */
+/*   This software is provided free of charge.                              */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef HAL_TIM_HAL_TIM_H_
+#define HAL_TIM_HAL_TIM_H_
+
+#include <stdint.h>
+
+/******************************************************************************/
+/*                Definition of exported types                                */
+/******************************************************************************/
+/**
+ * \brief Function called from the periodic tick interrupt.
+ */
+typedef void (*HAL_TIM_TickCallback_t)(void);
+
+/******************************************************************************/
+/*                Declaration of exported function prototypes               */
+/******************************************************************************/
+
+/**
+ * \brief Initializes and starts the free-running timebase.
+ *
+ * \return void.
+ */
+void HAL_TIM_Init(void);
+
+/**
+ * \brief Returns the current timestamp.
+ *
+ * \details The counter increments at HAL_TIM_GetTickHz() and wraps around at
+ *          2^32, so intervals must be computed with unsigned subtraction.
+ *
+ * \return The current value of the timebase, in ticks.
+ */
+uint32_t HAL_TIM_GetTicks(void);
+
+/**
+ * \brief Returns the frequency of the timebase.
+ *
+ * \return Ticks per second (LPIT0 functional clock, 8 MHz on this board).
+ */
+uint32_t HAL_TIM_GetTickHz(void);
+
+/**
+ * \brief Starts the periodic tick interrupt.
+ *
+ * \param[in] rateHz   Tick rate, in ticks per second.
+ * \param[in] callback Function called from the interrupt on every tick.
+ *
+ * \return void.
+ *
+ * \note HAL_TIM_Init() must have been called.
+ */
+void HAL_TIM_StartTick(uint32_t rateHz, HAL_TIM_TickCallback_t callback);
+
+#endif /* HAL_TIM_HAL_TIM_H_ */
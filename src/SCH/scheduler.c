@@ -0,0 +1,199 @@
+/*******************************************************************************
+ *   Scheduler Module Implementation
+ *
+ *   Author:  Pablo Prez Fernndez
+ *   Date:    30/03/2025
+ *
+ *   This module implements a cooperative, time-triggered scheduler. The timer
+ *   interrupt only advances the tick counter; tasks run from the main loop,
+ *   so they never preempt each other and need no locking between them. Task
+ *   releases are computed from the previous release (not from the completion
+ *   time), so periods do not drift with the execution time of the tasks.
+ *
+ *   This software is provided free of charge.
+ *
+ ******************************************************************************/
+
+/*==============================================================================
+                                 INCLUDE FILES
+==============================================================================*/
+#include "scheduler.h"
+#include <stddef.h>
+
+/*==============================================================================
+                          LOCAL VARIABLE DECLARATIONS
+==============================================================================*/
+/**
+ * \brief Current scheduler time, in ticks.
+ * \details Written by the timer ISR only.
+ */
+static volatile uint32_t g_ticks = 0U;
+
+/** \brief Task table in priority order. */
+static scheduler_task_t *g_tasks = NULL;
+
+/** \brief Number of tasks in g_tasks. */
+static uint8_t g_taskCount = 0U;
+
+/** \brief Total number of deadline overruns of all tasks. */
+static uint32_t g_overruns = 0U;
+
+/*==============================================================================
+                         LOCAL FUNCTION PROTOTYPES
+==============================================================================*/
+static bool scheduler_reached(uint32_t now, uint32_t tick);
+
+/*==============================================================================
+                            LOCAL FUNCTION DEFINITIONS
+==============================================================================*/
+
+/**
+ * \brief Returns whether a tick has been reached, with wrap-around.
+ *
+ * \param[in] now  Current time, in ticks.
+ * \param[in] tick Time to compare with, in ticks.
+ *
+ * \return true if tick is now or in the past.
+ */
+static bool scheduler_reached(uint32_t now, uint32_t tick)
+{
+    return ((int32_t)(now - tick) >= 0);
+}
+
+/*==============================================================================
+                            GLOBAL FUNCTION DEFINITIONS
+==============================================================================*/
+
+/**
+ * \brief Initializes the scheduler with a task table.
+ *
+ * \param[in,out] tasks Task table, in priority order (highest first).
+ * \param[in]     count Number of tasks in the table.
+ *
+ * \return void.
+ */
+void scheduler_init(scheduler_task_t *tasks, uint8_t count)
+{
+    uint32_t now = g_ticks;
+    uint8_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        tasks[i].nextRelease = now + tasks[i].phaseTicks;
+        tasks[i].maxLateness = 0U;
+        tasks[i].overruns = 0U;
+    }
+
+    g_tasks = tasks;
+    g_taskCount = count;
+    g_overruns = 0U;
+}
+
+/**
+ * \brief Advances the scheduler time by one tick.
+ *
+ * \return void.
+ */
+void scheduler_tick(void)
+{
+    g_ticks++;
+}
+
+/**
+ * \brief Returns the current scheduler time.
+ *
+ * \return The number of ticks since start-up.
+ */
+uint32_t scheduler_getTicks(void)
+{
+    return g_ticks;
+}
+
+/**
+ * \brief Runs every task whose release time has been reached.
+ *
+ * \details For every due task, the lateness (start time minus release time) is
+ *          recorded and the task is run. A job that completes more than
+ *          deadlineTicks after its release counts as an overrun, and so does
+ *          every release skipped because the task fell a whole period behind;
+ *          the task then resumes on its original phase.
+ *
+ * \return true if at least one task ran; false otherwise.
+ */
+bool scheduler_runPending(void)
+{
+    bool ran = false;
+    uint8_t i;
+
+    for (i = 0U; i < g_taskCount; i++)
+    {
+        scheduler_task_t *task = &g_tasks[i];
+        uint32_t release = task->nextRelease;
+        uint32_t start = g_ticks;
+        uint32_t end;
+
+        if (!scheduler_reached(start, release))
+        {
+            continue;
+        }
+
+        if ((start - release) > task->maxLateness)
+        {
+            task->maxLateness = start - release;
+        }
+
+        task->run();
+        end = g_ticks;
+        ran = true;
+
+        if ((end - release) > task->deadlineTicks)
+        {
+            task->overruns++;
+            g_overruns++;
+        }
+
+        /* Next release, skipping the ones that are already a full period late */
+        task->nextRelease = release + task->periodTicks;
+        while (scheduler_reached(end, task->nextRelease + task->periodTicks))
+        {
+            task->nextRelease += task->periodTicks;
+            task->overruns++;
+            g_overruns++;
+        }
+    }
+    return ran;
+}
+
+/**
+ * \brief Returns whether any task has reached its release time.
+ *
+ * \return true if at least one task is due; false otherwise.
+ */
+bool scheduler_hasPending(void)
+{
+    uint32_t now = g_ticks;
+    uint8_t i;
+
+    for (i = 0U; i < g_taskCount; i++)
+    {
+        if (scheduler_reached(now, g_tasks[i].nextRelease))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * \brief Returns the total number of deadline overruns of all tasks.
+ *
+ * \return The number of overruns since start-up.
+ */
+uint32_t scheduler_getOverruns(void)
+{
+    return g_overruns;
+}
+
+/*******************************************************************************
+ *                              EOF
+ ******************************************************************************/
@@ -0,0 +1,113 @@
+/*******************************************************************************
+ *   Scheduler Module
+ *
+ *   Author:  Pablo Prez Fernndez
+ *   Date:    30/03/2025
+ *
+ *   This module provides a small cooperative scheduler. Periodic tasks are
+ *   released by a timer tick and run to completion from the main loop, in
+ *   table order, which is also their priority. Each task has its own period,
+ *   phase and deadline, and deadline overruns are counted.
+ *
+ *   This software is provided free of charge.
+ *
+ ******************************************************************************/
+
+#ifndef SCH_SCHEDULER_H_
+#define SCH_SCHEDULER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/*                Definition of exported symbolic constants               */
+/******************************************************************************/
+/** \brief Scheduler tick rate, in ticks per second (1 ms tick). */
+#define SCHEDULER_TICK_HZ 1000U
+
+/******************************************************************************/
+/*                Definition of exported types                                */
+/******************************************************************************/
+/**
+ * \brief Body of a periodic task.
+ */
+typedef void (*scheduler_task_fn_t)(void);
+
+/**
+ * \brief Periodic task descriptor.
+ *
+ * \details The first block is configured by the application; the second one is
+ *          maintained by the scheduler.
+ */
+typedef struct
+{
+    scheduler_task_fn_t run;    /**< Task body. */
+    uint32_t periodTicks;       /**< Release period, in ticks. */
+    uint32_t phaseTicks;        /**< Offset of the first release, in ticks. */
+    uint32_t deadlineTicks;     /**< Completion deadline after each release, in ticks. */
+
+    uint32_t nextRelease;       /**< Tick of the next release. */
+    uint32_t maxLateness;       /**< Largest delay from release to start, in ticks. */
+    uint32_t overruns;          /**< Jobs completed after their deadline or skipped. */
+} scheduler_task_t;
+
+/******************************************************************************/
+/*         Declaration of exported function prototypes                      */
+/******************************************************************************/
+
+/**
+ * \brief Initializes the scheduler with a task table.
+ *
+ * \details The table is used in place and must stay valid. The first release of
+ *          each task is scheduled phaseTicks after the current tick.
+ *
+ * \param[in,out] tasks Task table, in priority order (highest first).
+ * \param[in]     count Number of tasks in the table.
+ *
+ * \return void.
+ */
+void scheduler_init(scheduler_task_t *tasks, uint8_t count);
+
+/**
+ * \brief Advances the scheduler time by one tick.
+ *
+ * \details Must be called at SCHEDULER_TICK_HZ, from the timer interrupt.
+ *
+ * \return void.
+ */
+void scheduler_tick(void);
+
+/**
+ * \brief Returns the current scheduler time.
+ *
+ * \return The number of ticks since start-up (wraps around at 2^32).
+ */
+uint32_t scheduler_getTicks(void);
+
+/**
+ * \brief Runs every task whose release time has been reached.
+ *
+ * \details Called repeatedly from the main loop. Due tasks run to completion in
+ *          table order.
+ *
+ * \return true if at least one task ran; false otherwise.
+ */
+bool scheduler_runPending(void);
+
+/**
+ * \brief Returns whether any task has reached its release time.
+ *
+ * \details Used by the idle policy: the core may only sleep when it returns false.
+ *
+ * \return true if at least one task is due; false otherwise.
+ */
+bool scheduler_hasPending(void);
+
+/**
+ * \brief Returns the total number of deadline overruns of all tasks.
+ *
+ * \return The number of overruns since start-up.
+ */
+uint32_t scheduler_getOverruns(void);
+
+#endif /* SCH_SCHEDULER_H_ */
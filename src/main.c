@@ -6,9 +6,10 @@
  *
  *   This module contains the user's application code. It initializes the
  *   system clocks, board pins, and peripheral modules (IC, SPI, ADC, etc.).
- *   In the main loop, it updates the registers with GPIO and ADC readings,
- *   processes IC transactions using a polling mechanism, and transmits new SPI
- *   configuration if the configuration register has been modified.
+ *   Periodic tasks, released by a 1 ms timer tick, update the registers with
+ *   GPIO and ADC readings, apply the settings written via IC, and transmit new
+ *   SPI configuration if the configuration register has been modified. IC
+ *   transactions are serviced from the LPI2C slave interrupt.
  *
  *   This software is provided free of charge.
  *
@@ -18,38 +19,317 @@
                            INCLUDE FILES
 ==============================================================================*/
 #include <HAL_adc.h>
+#include <HAL_dma.h>
 #include <HAL_dio.h>
+#include <HAL_dwt.h>
+#include <HAL_pwr.h>
 #include <HAL_spi.h>
+#include <HAL_tim.h>
 #include "sdk_project_config.h"
 #include <stdio.h>
+#include <string.h>
 #include "HAL_i2c.h"
 #include "registers.h"
+#include "scheduler.h"
 #include "pin_mux.h"  /* Includes BOARD_InitPins() generated by the tool */
 
 extern void initialise_monitor_handles(void);
 
+/* The debounce runs from the scheduler tick */
+#if (SCHEDULER_TICK_HZ != HAL_GPIO_DEBOUNCE_TICK_HZ)
+#error "The scheduler tick must match the debounce tick rate"
+#endif
+
+/* Every chained device of the register map must fit in one SPI transfer */
+#if (REG_SPICHAIN_MAX > HAL_SPI_CHAIN_MAX_DEVICES)
+#error "The SPI HAL cannot drive every chained device of the register map"
+#endif
+
+/* Each IC slave address selects the register bank of the same index */
+#if (HAL_I2C_ADDRESS_PRIMARY != REG_BANK_MAP) || (HAL_I2C_ADDRESS_SECONDARY != REG_BANK_STATUS)
+#error "The I2C slave addresses do not match the register banks"
+#endif
+
+/* The diagnostics window shows the statistics of one DWT stage */
+#if (HAL_DWT_STAGE_COUNT != REG_PROF_STAGES) || (HAL_DWT_HIST_BINS != REG_PROF_HIST_BINS)
+#error "The timing diagnostics window does not match the DWT stages"
+#endif
+
+/* The PEC covers the slave address byte */
+#if (HAL_I2C_SLAVE_ADDRESS != REG_BANK_MAP_ADDRESS) || (HAL_I2C_SLAVE_ADDRESS_SECONDARY != REG_BANK_STATUS_ADDRESS)
+#error "The I2C slave addresses do not match the register bank addresses"
+#endif
+
+/*==============================================================================
+                      LOCAL SYMBOLIC CONSTANTS
+==============================================================================*/
+/**
+ * \brief Period of the SPI output update task, in ticks.
+ *
+ * \details Bounds the ISO1H816G update rate to 200 frames/s. Outputs driving
+ *          inductive or lamp loads gain nothing from faster updates; a burst of
+ *          configuration writes within one period collapses into one frame.
+ */
+#define SPI_UPDATE_PERIOD_TICKS 5U
+
+/*==============================================================================
+                      LOCAL FUNCTION PROTOTYPES
+==============================================================================*/
+static void taskSpiUpdate(void);
+static void spiUpdateDone(bool success);
+static void taskI2cConfig(void);
+static void taskGpio(void);
+static void taskAdc(void);
+static void tickHandler(void);
+
+/*==============================================================================
+                      LOCAL VARIABLE DEFINITIONS
+==============================================================================*/
+/**
+ * \brief Handlers called from the IC slave ISR.
+ *
+ * \details The matched slave address selects the register bank, every read
+ *          is served by eDMA from the block returned by registers_readBlock()
+ *          (auto-increment), and on STOP or repeated START the bytes written by
+ *          the master are fed to registers_processByte() before the state
+ *          machine is reset.
+ */
+static const HAL_I2C_Callbacks_t s_i2cCallbacks = {
+    .startCallback = registers_startTransaction,
+    .rxCallback    = registers_processByte,
+    .txCallback    = registers_readBlock,
+    .stopCallback  = registers_endTransaction
+};
+
+/** \brief Configuration write count already handled by taskSpiUpdate(). */
+static uint32_t s_spiWritesHandled = 0U;
+
+/** \brief Configuration update count already handled by taskSpiUpdate(). */
+static uint32_t s_spiUpdatesHandled = 0U;
+
+/** \brief Chain configuration of the last frame handed to the SPI. */
+static uint8_t s_spiLastFrame[REG_SPICHAIN_MAX];
+
+/** \brief Number of devices of s_spiLastFrame (0: nothing sent yet). */
+static uint8_t s_spiLastDevices = 0U;
+
+/** \brief true if the last frame must be sent again (set by the SPI ISR on failure). */
+static volatile bool s_spiResend = false;
+
+/** \brief SPI output update counters, modulo 256 (REG_SPI_SENT/COALESCED/SKIPPED). */
+static uint8_t s_spiSent = 0U;
+static uint8_t s_spiCoalesced = 0U;
+static uint8_t s_spiSkipped = 0U;
+
+/**
+ * \brief Periodic tasks, in priority order (1 tick = 1 ms).
+ *
+ * \details The acquisition tasks share the same release so that each published
+ *          frame holds GPIO and ADC values of the same cycle; the configuration
+ *          task is shifted by half a period to spread the load.
+ */
+static scheduler_task_t s_tasks[] = {
+    { .run = taskSpiUpdate, .periodTicks = SPI_UPDATE_PERIOD_TICKS, .phaseTicks = 0U, .deadlineTicks = 2U },
+    { .run = taskGpio,      .periodTicks = 10U, .phaseTicks = 0U, .deadlineTicks = 5U },
+    { .run = taskAdc,       .periodTicks = 10U, .phaseTicks = 0U, .deadlineTicks = 5U },
+    { .run = taskI2cConfig, .periodTicks = 10U, .phaseTicks = 5U, .deadlineTicks = 10U }
+};
+
 /*==============================================================================
                       LOCAL FUNCTION DEFINITIONS
 ==============================================================================*/
 /**
- * \brief Polls for IC transactions.
+ * \brief Transmits the SPI configuration when it has been modified via IC.
+ *
+ * \details Coalescing dispatcher with latest-value semantics. The configuration
+ *          write counter tells whether writes arrived since the last release;
+ *          only the current values are sent, and the updates (committed IC
+ *          transactions) they supersede are counted as coalesced. An update identical to the last frame sent is
+ *          skipped. All chained ISO1H816G devices are updated by one transfer,
+ *          under a single chip select assertion, handed over to the eDMA. While
+ *          a previous transfer is still in progress nothing is consumed, so the
+ *          latest values go out on a later release. A frame the SPI reports as
+ *          failed is sent again.
+ *
+ * \return void.
+ */
+static void taskSpiUpdate(void)
+{
+    HAL_DWT_BEGIN(start);
+    uint32_t writes = registers_getConfigWrites();
+    uint32_t pending = writes - s_spiWritesHandled;
+    uint32_t updates;
+    uint8_t chainConfig[REG_SPICHAIN_MAX];
+    uint8_t devices;
+
+    if (((pending != 0U) || s_spiResend) && !HAL_SPI_IsBusy())
+    {
+        /* Writes arriving from now on are handled on a later release */
+        s_spiWritesHandled = writes;
+        updates = registers_getConfigUpdates() - s_spiUpdatesHandled;
+        s_spiUpdatesHandled += updates;
+        devices = registers_getChainConfig(chainConfig);
+        if (updates > 1U)
+        {
+            s_spiCoalesced = (uint8_t)(s_spiCoalesced + (updates - 1U));
+        }
+
+        if (!s_spiResend && (devices == s_spiLastDevices) &&
+            (memcmp(chainConfig, s_spiLastFrame, devices) == 0))
+        {
+            s_spiSkipped++;
+        }
+        else
+        {
+            /* Cleared before the start: a transfer failing at once sets it
+             * again from the SPI interrupt */
+            s_spiResend = false;
+            memcpy(s_spiLastFrame, chainConfig, devices);
+            s_spiLastDevices = devices;
+            if (HAL_SPI_WriteChainAsync(chainConfig, devices, spiUpdateDone))
+            {
+                s_spiSent++;
+            }
+            else
+            {
+                s_spiResend = true;
+            }
+        }
+
+        registers_updateSpiStats(s_spiSent, s_spiCoalesced, s_spiSkipped);
+    }
+
+    HAL_DWT_END(HAL_DWT_STAGE_SPI, start);
+}
+
+/**
+ * \brief End of an SPI configuration frame, called from the SPI interrupt.
+ *
+ * \param[in] success false if the transfer failed.
+ *
+ * \return void.
+ */
+static void spiUpdateDone(bool success)
+{
+    if (!success)
+    {
+        s_spiResend = true;
+    }
+}
+
+/**
+ * \brief Applies the ADC and input settings modified via IC.
  *
- * \details This function calls HAL_I2C_SlaveReceive() and, if a non-zero byte is
- *          received, passes it to registers_processByte() to process the incoming
- *          IC transaction.
+ * \details Handles the ADC noise reduction mode (REG_ADCMODE_x matches
+ *          HAL_ADC_Mode_t), the threshold alarms (REG_ALARMCFG_x matches
+ *          HAL_ADC_AlarmMode_t), the debounce configuration and the IC bus
+ *          mode (REG_I2CMODE_x matches HAL_I2C_BusMode_t).
  *
  * \return void.
  */
-void processI2CTransactionPolling(void)
+static void taskI2cConfig(void)
 {
-    uint8_t byteReceived = HAL_I2C_SlaveReceive();
+    HAL_DWT_BEGIN(start);
+
+    if (registers_adcModeChanged())
+    {
+        registers_clearADCModeFlag();
+        HAL_ADC_SetMode((HAL_ADC_Mode_t)registers_getADCMode());
+    }
+
+    if (registers_alarmConfigChanged())
+    {
+        registers_clearAlarmConfigFlag();
+        for (uint8_t channel = 0U; channel < REG_ALARM_CHANNELS; channel++)
+        {
+            uint16_t low;
+            uint16_t high;
+            uint8_t mode = registers_getADCAlarm(channel, &low, &high);
+            HAL_ADC_SetAlarm(channel, (HAL_ADC_AlarmMode_t)mode, low, high);
+        }
+    }
+
+    if (registers_debounceConfigChanged())
+    {
+        registers_clearDebounceConfigFlag();
+        HAL_GPIO_SetDigitalFilter(registers_getDigitalFilter());
+        HAL_GPIO_SetDebounceSamples(registers_getDebounceSamples());
+    }
 
-    /* We assume that 0 is not a valid data byte. In a real application, a
-       mechanism should be implemented to differentiate "no data" from a valid 0x00 */
-    if (byteReceived != 0U)
+    if (registers_i2cModeChanged())
     {
-        registers_processByte(byteReceived);
+        registers_clearI2CModeFlag();
+        if (!HAL_I2C_SetBusMode((HAL_I2C_BusMode_t)registers_getI2CMode()))
+        {
+            /* Refused (clock too slow or slave busy): report the mode in effect */
+            registers_setI2CMode((uint8_t)HAL_I2C_GetBusMode());
+        }
     }
+
+    HAL_DWT_END(HAL_DWT_STAGE_I2C_CONFIG, start);
+}
+
+/**
+ * \brief Updates the GPIO register with the current state of the 8 inputs.
+ *
+ * \return void.
+ */
+static void taskGpio(void)
+{
+    HAL_DWT_BEGIN(start);
+
+    registers_updateGPIO(HAL_GPIO_ReadInputs());
+
+    HAL_DWT_END(HAL_DWT_STAGE_GPIO, start);
+}
+
+/**
+ * \brief Updates the ADC registers and publishes the acquisition cycle.
+ *
+ * \details Fetches the current samples of ADC channels 0 and 1, filtered by the
+ *          selected mode, stores their full 12-bit (14-bit when oversampling)
+ *          values, then publishes the cycle, together with the scheduler overrun
+ *          count and the timing statistics of the stage selected by
+ *          REG_PROF_STAGE, as one coherent frame for IC reads.
+ *
+ * \return void.
+ */
+static void taskAdc(void)
+{
+    HAL_DWT_BEGIN(start);
+    uint16_t adcVal0 = HAL_ADC_GetSample(0);
+    uint16_t adcVal1 = HAL_ADC_GetSample(1);
+    uint8_t adcBits = HAL_ADC_GetSampleBits();
+
+    registers_updateADC(0, adcVal0, adcBits);
+    registers_updateADC(1, adcVal1, adcBits);
+    registers_updateOverruns((uint8_t)scheduler_getOverruns());
+#if (HAL_DWT_PROFILING != 0)
+    HAL_DWT_Stats_t stats;
+
+    if (HAL_DWT_GetStats(registers_getProfileStage(), &stats))
+    {
+        registers_updateProfile(stats.count, stats.minCycles, stats.maxCycles,
+                                stats.meanCycles, stats.histogram);
+    }
+#endif
+    registers_publish();
+
+    HAL_DWT_END(HAL_DWT_STAGE_ADC, start);
+}
+
+/**
+ * \brief Periodic timer interrupt handler (SCHEDULER_TICK_HZ).
+ *
+ * \details Runs the input debounce, which must be sampled at an exact rate, and
+ *          releases the scheduler tasks.
+ *
+ * \return void.
+ */
+static void tickHandler(void)
+{
+    HAL_GPIO_DebounceTick();
+    scheduler_tick();
 }
 
 
@@ -61,13 +341,16 @@ void processI2CTransactionPolling(void)
 /**
  * \brief Main entry point of the application.
  *
- * \details Initializes system clocks, board pins, and peripheral modules.
- *          The main loop performs the following tasks:
+ * \details Initializes system clocks, board pins, and peripheral modules, then
+ *          runs the periodic tasks from the scheduler:
  *          - Updates the GPIO register with the current state of 8 GPIO inputs.
- *          - Reads two ADC channels and updates the corresponding registers.
- *          - Processes incoming IC transactions using a simple polling mechanism.
+ *          - Fetches the samples of the two scanned ADC channels, updates the
+ *            corresponding registers and publishes them for IC reads.
+ *          - Applies the ADC noise reduction mode, threshold alarms and input
+ *            debounce settings selected via IC.
  *          - If the SPI configuration register is modified via IC, transmits the new
  *            configuration via SPI.
+ *          IC transactions are processed asynchronously by the LPI2C slave ISR.
  *
  * \return Returns 0 upon successful execution.
  */
@@ -81,46 +364,45 @@ int main(void)
     /* Initialize board pins */
     BOARD_InitPins();
 
+    /* Initialize the registers module before the IC ISR can reach it */
+    registers_init();
+
     /* Initialize peripheral modules */
-    HAL_I2C_Init();   /* Initialize IC in slave mode */
-    HAL_SPI_Init();   /* Initialize SPI for communication with ISO1H816G */
+#if (HAL_DWT_PROFILING != 0)
+    HAL_DWT_Init();   /* Cycle counter for the timing diagnostics */
+#endif
+    HAL_DMA_Init();   /* Initialize eDMA controller shared by the HAL modules */
+    HAL_I2C_Init(&s_i2cCallbacks);   /* Initialize IC in DMA-driven slave mode */
+    HAL_SPI_Init();   /* Initialize SPI (DMA driven) for communication with ISO1H816G */
     HAL_ADC_Init();   /* Initialize ADC module */
-
-    /* Initialize the registers module */
-    registers_init();
+    HAL_ADC_SetAlarmCallback(registers_latchAlarm);   /* Latch threshold alarms in REG_ALARM */
+    HAL_ADC_StartScan(HAL_ADC_SCAN_RATE_HZ);   /* PDB-triggered DMA scan of both channels */
+    HAL_TIM_Init();   /* Free-running timebase for event timestamps */
+    HAL_GPIO_StartEdgeCapture(registers_pushEdge);   /* Queue input edges for IC */
+    HAL_GPIO_SetDigitalFilter(registers_getDigitalFilter());   /* PORT glitch filter */
+    HAL_GPIO_StartDebounce(registers_getDebounceSamples(), registers_updateDebounced);
+    /* Report the bus rates and IC mode derived from the clock tree */
+    registers_updateBusRates(HAL_SPI_GetBaudRate(), HAL_I2C_GetMaxBusRate());
+    registers_setI2CMode((uint8_t)HAL_I2C_GetBusMode());
 
     /* Initialize semihosting for printf output */
     initialise_monitor_handles();
 
     printf("System initialized.\r\n");
 
-    /* Main loop */
+    /* Start the scheduler tick, which also drives the debounce */
+    scheduler_init(s_tasks, (uint8_t)(sizeof(s_tasks) / sizeof(s_tasks[0])));
+    HAL_TIM_StartTick(SCHEDULER_TICK_HZ, tickHandler);
+    HAL_PWR_Init();
+
+    /* Main loop: run the tasks as they are released and sleep in between.
+       Any interrupt (tick, IC, pin change, ADC alarm) wakes the core up. */
     while (1)
     {
-        /* Update the GPIO register with the current 8-bit value from the GPIO inputs */
-        registers_updateGPIO(HAL_GPIO_ReadInputs());
-
-        /* Read ADC channels (0 and 1) and update the corresponding registers.
-           The ADC values are truncated to 8 bits. Adjust scaling as necessary. */
-        uint16_t adcVal0 = HAL_ADC_ReadChannel(0);
-        uint16_t adcVal1 = HAL_ADC_ReadChannel(1);
-        registers_updateADC(0, (uint8_t)adcVal0);
-        registers_updateADC(1, (uint8_t)adcVal1);
-
-        /* Process any received IC transaction using a polling method */
-        processI2CTransactionPolling();
-
-        /* If the configuration register has been modified via IC,
-           transmit the new configuration value to the ISO1H816G via SPI */
-        if (registers_configChanged())
+        if (!scheduler_runPending())
         {
-            uint8_t configValue = registers_getConfig();
-            HAL_SPI_Transmit(configValue);
-            registers_clearConfigFlag();
+            HAL_PWR_Idle(scheduler_hasPending);
         }
-
-        /* Simple delay loop */
-        for (volatile int i = 0; i < 1000000; i++);
     }
 
     /* Although this point is never reached, return 0 */
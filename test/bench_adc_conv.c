@@ -0,0 +1,214 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host benchmark of the millivolt conversion                               */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Times the fixed-point conversion of HAL_adc.c, per sample and through    */
+/*   its block variant, against the float conversion it replaced (two float   */
+/*   divisions per sample) and against a float version of the same single     */
+/*   multiplication. Reports time-stamp counter cycles per sample on x86      */
+/*   hosts, nanoseconds elsewhere. Host figures only compare the kernels;     */
+/*   they are not Cortex-M4 cycle counts.                                     */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+/* The module is included to reach its conversion factors */
+#include "../src/HAL/ADC/HAL_adc.c"
+#include "mock/mock_platform.c"
+#include "mock/mock_adc.c"
+#include <stdio.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/******************************************************************************/
+/*                   Definition of local symbolic constants                 */
+/******************************************************************************/
+/** \brief Samples per block, a full scan ring of one channel and more. */
+#define BENCH_BLOCK_LEN 256U
+
+/** \brief Number of blocks converted per measurement. */
+#define BENCH_ROUNDS    20000U
+
+/** \brief Channel converted. */
+#define BENCH_CHANNEL   0U
+
+/******************************************************************************/
+/*                   Definition of local variables                            */
+/******************************************************************************/
+/** \brief Samples and results of the kernels. */
+static uint16_t s_samples[BENCH_BLOCK_LEN];
+static uint16_t s_millivolts[BENCH_BLOCK_LEN];
+static float s_volts[BENCH_BLOCK_LEN];
+
+/** \brief Millivolts per code of the float version of the fixed-point kernel. */
+static float s_mvPerCode = 0.0f;
+
+/** \brief Sink keeping the results alive. */
+static volatile uint32_t s_sink = 0U;
+
+/******************************************************************************/
+/*                   Definition of local functions                            */
+/******************************************************************************/
+
+/**
+ * \brief Returns the time-stamp counter on x86 hosts, the monotonic time in
+ *        nanoseconds elsewhere.
+ */
+static uint64_t bench_now(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+#endif
+}
+
+/**
+ * \brief Conversion before the fixed-point kernel: code to volts with the
+ *        constants of the board, two float divisions per sample.
+ */
+static void bench_floatDivide(const uint16_t *adcValues, float *volts, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        float v_adc = ((float)adcValues[i] / (float)HAL_ADC_GetFullScale()) * 3.3f;
+        volts[i] = v_adc / 0.15f;
+    }
+}
+
+/**
+ * \brief Float version of the fixed-point kernel: one float multiplication by
+ *        the millivolts per code, rounded to nearest.
+ */
+static void bench_floatScale(const uint16_t *adcValues, uint16_t *millivolts, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        millivolts[i] = (uint16_t)(((float)adcValues[i] * s_mvPerCode) + 0.5f);
+    }
+}
+
+/**
+ * \brief Fixed-point kernel called once per sample.
+ */
+static void bench_fixedSample(const uint16_t *adcValues, uint16_t *millivolts, uint32_t count)
+{
+    uint8_t sampleBits = HAL_ADC_GetSampleBits();
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        millivolts[i] = HAL_ADC_ConvertToMillivolts(BENCH_CHANNEL, adcValues[i], sampleBits);
+    }
+}
+
+/**
+ * \brief Changes one sample per round, so the conversions are not hoisted out
+ *        of the measurement loop.
+ */
+static void bench_perturb(uint32_t round)
+{
+    uint32_t index = round % BENCH_BLOCK_LEN;
+
+    s_samples[index] = (uint16_t)((s_samples[index] + round) & ADC_FULL_SCALE_12BIT);
+}
+
+/**
+ * \brief Prints the time per sample of one kernel.
+ */
+static void bench_report(const char *name, uint64_t elapsed)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    static const char unit[] = "TSC cycles/sample";
+#else
+    static const char unit[] = "ns/sample";
+#endif
+
+    printf("%-32s %8.2f %s\n", name, (double)elapsed / ((double)BENCH_ROUNDS * BENCH_BLOCK_LEN), unit);
+}
+
+/******************************************************************************/
+/*                   Definition of exported functions                         */
+/******************************************************************************/
+
+int main(void)
+{
+    uint64_t start;
+    uint32_t round;
+    uint32_t i;
+
+    mock_adcReset();
+    HAL_ADC_Init();
+    s_mvPerCode = (float)s_scaleQ16[BENCH_CHANNEL] / 65536.0f;
+    for (i = 0U; i < BENCH_BLOCK_LEN; i++)
+    {
+        s_samples[i] = (uint16_t)(((i * 1237U) + 91U) & ADC_FULL_SCALE_12BIT);
+    }
+
+    /* The kernels agree to the millivolt before they are timed */
+    bench_floatDivide(s_samples, s_volts, BENCH_BLOCK_LEN);
+    HAL_ADC_ConvertBlockToMillivolts(BENCH_CHANNEL, s_samples, s_millivolts, BENCH_BLOCK_LEN,
+                                     HAL_ADC_GetSampleBits());
+    for (i = 0U; i < BENCH_BLOCK_LEN; i++)
+    {
+        float error = ((float)s_millivolts[i] - (s_volts[i] * 1000.0f));
+
+        if ((error > 1.0f) || (error < -1.0f))
+        {
+            printf("kernels disagree on code %u\n", s_samples[i]);
+            return 1;
+        }
+    }
+
+    start = bench_now();
+    for (round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        bench_perturb(round);
+        bench_floatDivide(s_samples, s_volts, BENCH_BLOCK_LEN);
+        s_sink += (uint32_t)s_volts[round % BENCH_BLOCK_LEN];
+    }
+    bench_report("float, two divisions", bench_now() - start);
+
+    start = bench_now();
+    for (round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        bench_perturb(round);
+        bench_floatScale(s_samples, s_millivolts, BENCH_BLOCK_LEN);
+        s_sink += s_millivolts[round % BENCH_BLOCK_LEN];
+    }
+    bench_report("float, one multiplication", bench_now() - start);
+
+    start = bench_now();
+    for (round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        bench_perturb(round);
+        bench_fixedSample(s_samples, s_millivolts, BENCH_BLOCK_LEN);
+        s_sink += s_millivolts[round % BENCH_BLOCK_LEN];
+    }
+    bench_report("fixed, ConvertToMillivolts", bench_now() - start);
+
+    start = bench_now();
+    for (round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        bench_perturb(round);
+        HAL_ADC_ConvertBlockToMillivolts(BENCH_CHANNEL, s_samples, s_millivolts, BENCH_BLOCK_LEN,
+                                         HAL_ADC_GetSampleBits());
+        s_sink += s_millivolts[round % BENCH_BLOCK_LEN];
+    }
+    bench_report("fixed, ConvertBlockToMillivolts", bench_now() - start);
+
+    return 0;
+}
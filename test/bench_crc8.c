@@ -0,0 +1,149 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host benchmark of the PEC kernel                                         */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Times the table-driven CRC-8 of registers.c against the bitwise          */
+/*   reference on blocks of the size of the register map, and the whole PEC   */
+/*   read path (registers_readBlock() of the timing window). Host timings     */
+/*   only compare the kernels; they are not Cortex-M4 cycle counts.           */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+/* The module is included to reach its PEC table */
+#include "../src/CONF/registers.c"
+#include <stdio.h>
+#include <time.h>
+
+/******************************************************************************/
+/*                   Definition of local symbolic constants                 */
+/******************************************************************************/
+/** \brief Number of blocks processed per measurement. */
+#define BENCH_ROUNDS 200000U
+
+/******************************************************************************/
+/*                   Definition of local variables                            */
+/******************************************************************************/
+/** \brief Sink keeping the results alive. */
+static volatile uint8_t s_sink = 0U;
+
+/******************************************************************************/
+/*                   Definition of local functions                            */
+/******************************************************************************/
+
+/**
+ * \brief Returns the monotonic time, in nanoseconds.
+ */
+static double bench_now(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((double)now.tv_sec * 1e9) + (double)now.tv_nsec;
+}
+
+/**
+ * \brief Bitwise CRC-8, polynomial 0x07: eight shifts per byte.
+ */
+static uint8_t bench_crcBitwise(const uint8_t *data, uint32_t length)
+{
+    uint8_t crc = 0U;
+    uint32_t i;
+    uint8_t bit;
+
+    for (i = 0U; i < length; i++)
+    {
+        crc ^= data[i];
+        for (bit = 0U; bit < 8U; bit++)
+        {
+            crc = (uint8_t)(((uint32_t)crc << 1U) ^ (((crc & 0x80U) != 0U) ? 0x07U : 0x00U));
+        }
+    }
+    return crc;
+}
+
+/**
+ * \brief Table CRC-8, the kernel of registers.c: one lookup per byte.
+ */
+static uint8_t bench_crcTable(const uint8_t *data, uint32_t length)
+{
+    uint8_t crc = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < length; i++)
+    {
+        crc = g_crc8Table[crc ^ data[i]];
+    }
+    return crc;
+}
+
+/**
+ * \brief Prints the time per byte of one kernel.
+ */
+static void bench_report(const char *name, double elapsed, uint32_t bytesPerRound)
+{
+    printf("%-28s %8.3f ns/byte\n", name, elapsed / ((double)BENCH_ROUNDS * bytesPerRound));
+}
+
+/******************************************************************************/
+/*                   Definition of exported functions                         */
+/******************************************************************************/
+
+int main(void)
+{
+    uint8_t block[NUM_REGISTERS];
+    uint8_t index = REG_PROF_WINDOW;
+    const uint8_t *served;
+    uint32_t length;
+    double start;
+    uint32_t round;
+    uint32_t i;
+
+    for (i = 0U; i < NUM_REGISTERS; i++)
+    {
+        block[i] = (uint8_t)((i * 37U) + 11U);
+    }
+    if (bench_crcBitwise(block, NUM_REGISTERS) != bench_crcTable(block, NUM_REGISTERS))
+    {
+        printf("kernels disagree\n");
+        return 1;
+    }
+
+    start = bench_now();
+    for (round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        block[round % NUM_REGISTERS] ^= (uint8_t)round;
+        s_sink ^= bench_crcBitwise(block, NUM_REGISTERS);
+    }
+    bench_report("bitwise CRC-8", bench_now() - start, NUM_REGISTERS);
+
+    start = bench_now();
+    for (round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        block[round % NUM_REGISTERS] ^= (uint8_t)round;
+        s_sink ^= bench_crcTable(block, NUM_REGISTERS);
+    }
+    bench_report("table CRC-8", bench_now() - start, NUM_REGISTERS);
+
+    /* Whole read path: combined read of the timing window with its PEC */
+    registers_init();
+    registers_write(REG_PEC, REG_PEC_ON);
+    start = bench_now();
+    for (round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        registers_startTransaction(REG_BANK_MAP);
+        registers_processByte(index);
+        registers_endTransaction(0U, true);
+        registers_startTransaction(REG_BANK_MAP);
+        length = registers_readBlock(&served);
+        s_sink ^= served[length - 1U];
+        registers_endTransaction(length, false);
+    }
+    bench_report("readBlock with PEC (window)", bench_now() - start, REG_PROF_WINDOW_LEN + 1U);
+
+    return 0;
+}
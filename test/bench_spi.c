@@ -0,0 +1,145 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host benchmark of the polled SPI transfer                                */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Runs HAL_SPI_Transfer() against the cycle model of the LPSPI0 FIFOs      */
+/*   (mock/mock_lpspi.c) and compares it with the loop it replaced, which     */
+/*   kept a single 8-bit frame in flight. Reports core cycles per byte and    */
+/*   the share of the transfer during which SCK is running, at the 4 MHz SCK  */
+/*   of the board. The figures come from the model, not from the host clock.  */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+/* The module is included to reach its frame helpers */
+#include "../src/HAL/SPI/HAL_spi.c"
+#include "mock/mock_platform.c"
+#include "mock/mock_lpspi.c"
+#include <stdio.h>
+
+/******************************************************************************/
+/*                   Definition of local symbolic constants                 */
+/******************************************************************************/
+/** \brief Largest transfer measured, in bytes. */
+#define BENCH_MAX_SIZE 256U
+
+/******************************************************************************/
+/*                   Definition of local functions                            */
+/******************************************************************************/
+
+/**
+ * \brief Transfer loop before the pipelining: each frame is written, then
+ *        waited for and read before the next one is written.
+ *
+ * \return true if the transfer was done.
+ */
+static bool bench_perByte(const uint8_t *txBuffer, uint8_t *rxBuffer, uint32_t size)
+{
+    uint32_t driverTcr = SPI_BASE->TCR;
+    lpspi_tx_cmd_config_t txCmdConfig;
+    uint32_t i;
+
+    LPSPI_SetFlushFifoCmd(SPI_BASE, true, true);
+    (void)LPSPI_ClearStatusFlag(SPI_BASE, LPSPI_ALL_STATUS);
+
+    txCmdConfig.frameSize = 8U;
+    txCmdConfig.width = LPSPI_SINGLE_BIT_XFER;
+    txCmdConfig.txMask = false;
+    txCmdConfig.rxMask = false;
+    txCmdConfig.contCmd = false;
+    txCmdConfig.contTransfer = true;
+    txCmdConfig.byteSwap = false;
+    txCmdConfig.lsbFirst = false;
+    txCmdConfig.whichPcs = LPSPI_PCS2;
+    txCmdConfig.preDiv = (driverTcr & LPSPI_TCR_PRESCALE_MASK) >> LPSPI_TCR_PRESCALE_SHIFT;
+    txCmdConfig.clkPolarity = LPSPI_SCK_ACTIVE_HIGH;
+    txCmdConfig.clkPhase = LPSPI_CLOCK_PHASE_2ND_EDGE;
+    LPSPI_SetTxCommandReg(SPI_BASE, &txCmdConfig);
+
+    for (i = 0U; i < size; i++)
+    {
+        LPSPI_WriteData(SPI_BASE, txBuffer[i]);
+        while (LPSPI_ReadRxCount(SPI_BASE) == 0U)
+        {
+            /* Active waiting */
+        }
+        rxBuffer[i] = (uint8_t)LPSPI_ReadData(SPI_BASE);
+    }
+
+    txCmdConfig.contTransfer = false;
+    LPSPI_SetTxCommandReg(SPI_BASE, &txCmdConfig);
+    while (LPSPI_GetStatusFlag(SPI_BASE, LPSPI_MODULE_BUSY))
+    {
+        /* Active waiting */
+    }
+    SPI_BASE->TCR = driverTcr;
+
+    return true;
+}
+
+/**
+ * \brief Times one transfer on the model and checks the looped-back data.
+ *
+ * \return Core cycles taken, or 0 if the data or the FIFOs went wrong.
+ */
+static uint64_t bench_measure(bool pipelined, uint32_t size)
+{
+    uint8_t txBuffer[BENCH_MAX_SIZE];
+    uint8_t rxBuffer[BENCH_MAX_SIZE];
+    uint64_t start;
+    bool done;
+    uint32_t i;
+
+    for (i = 0U; i < size; i++)
+    {
+        txBuffer[i] = (uint8_t)((i * 37U) + 11U);
+        rxBuffer[i] = 0U;
+    }
+    mock_lpspiReset();
+    mock_lpspi0.TCR = LPSPI_TCR_CONT_MASK | 7U;
+
+    start = mock_cycles;
+    done = pipelined ? HAL_SPI_Transfer(txBuffer, rxBuffer, size) : bench_perByte(txBuffer, rxBuffer, size);
+    if (!done || (mock_lpspiOverruns != 0U) || (memcmp(txBuffer, rxBuffer, size) != 0) ||
+        (mock_lpspi0.TCR != (LPSPI_TCR_CONT_MASK | 7U)))
+    {
+        return 0U;
+    }
+    return mock_cycles - start;
+}
+
+/******************************************************************************/
+/*                   Definition of exported functions                         */
+/******************************************************************************/
+
+int main(void)
+{
+    static const uint32_t sizes[] = { 1U, 3U, 4U, 16U, 63U, 64U, 256U };
+    uint64_t perByte;
+    uint64_t pipelined;
+    double sck;
+    uint32_t i;
+
+    printf("%6s  %22s  %22s\n", "bytes", "per-byte loop", "pipelined loop");
+    printf("%6s  %11s %10s  %11s %10s\n", "", "cycles/byte", "SCK busy", "cycles/byte", "SCK busy");
+    for (i = 0U; i < (sizeof(sizes) / sizeof(sizes[0])); i++)
+    {
+        perByte = bench_measure(false, sizes[i]);
+        pipelined = bench_measure(true, sizes[i]);
+        if ((perByte == 0U) || (pipelined == 0U))
+        {
+            printf("%u-byte transfer failed on the model\n", sizes[i]);
+            return 1;
+        }
+        sck = (double)sizes[i] * 8.0 * mock_cyclesPerBit;
+        printf("%6u  %11.1f %9.1f%%  %11.1f %9.1f%%\n", sizes[i],
+               (double)perByte / sizes[i], (100.0 * sck) / (double)perByte,
+               (double)pipelined / sizes[i], (100.0 * sck) / (double)pipelined);
+    }
+
+    return 0;
+}
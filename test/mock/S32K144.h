@@ -0,0 +1,19 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host stand-in of the S32K144 device header                               */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   The peripheral register layouts are those of device_registers.h.         */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef MOCK_S32K144_H_
+#define MOCK_S32K144_H_
+
+#include "device_registers.h"
+
+#endif /* MOCK_S32K144_H_ */
@@ -0,0 +1,114 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host stand-in of the ADC driver                                          */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Same types and prototypes as the SDK header, for the functions used by   */
+/*   HAL_adc.c. They are implemented by mock_adc.c.                           */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef MOCK_ADC_DRIVER_H_
+#define MOCK_ADC_DRIVER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "devassert.h"
+#include "device_registers.h"
+
+/******************************************************************************/
+/*                Definition of exported types                                */
+/******************************************************************************/
+typedef enum
+{
+    ADC_RESOLUTION_8BIT  = 0x00U,
+    ADC_RESOLUTION_12BIT = 0x01U,
+    ADC_RESOLUTION_10BIT = 0x02U
+} adc_resolution_t;
+
+typedef enum
+{
+    ADC_TRIGGER_SOFTWARE = 0x00U,
+    ADC_TRIGGER_HARDWARE = 0x01U
+} adc_trigger_t;
+
+typedef enum
+{
+    ADC_PRETRIGGER_SEL_PDB    = 0x00U,
+    ADC_PRETRIGGER_SEL_TRGMUX = 0x01U,
+    ADC_PRETRIGGER_SEL_SW     = 0x02U
+} adc_pretrigger_sel_t;
+
+typedef enum
+{
+    ADC_TRIGGER_SEL_PDB    = 0x00U,
+    ADC_TRIGGER_SEL_TRGMUX = 0x01U
+} adc_trigger_sel_t;
+
+typedef enum
+{
+    ADC_SW_PRETRIGGER_DISABLED = 0x00U,
+    ADC_SW_PRETRIGGER_0        = 0x04U
+} adc_sw_pretrigger_t;
+
+typedef enum
+{
+    ADC_VOLTAGEREF_VREF = 0x00U,
+    ADC_VOLTAGEREF_VALT = 0x01U
+} adc_voltage_reference_t;
+
+typedef enum
+{
+    ADC_AVERAGE_4  = 0x00U,
+    ADC_AVERAGE_8  = 0x01U,
+    ADC_AVERAGE_16 = 0x02U,
+    ADC_AVERAGE_32 = 0x03U
+} adc_average_t;
+
+typedef uint32_t adc_inputchannel_t;
+
+/** \brief Converter configuration: the fields the HAL sets. */
+typedef struct
+{
+    adc_resolution_t resolution;
+    adc_trigger_t trigger;
+    adc_pretrigger_sel_t pretriggerSel;
+    adc_trigger_sel_t triggerSel;
+    bool dmaEnable;
+    adc_voltage_reference_t voltageRef;
+    bool continuousConvEnable;
+} adc_converter_config_t;
+
+typedef struct
+{
+    bool hwAvgEnable;
+    adc_average_t hwAverage;
+} adc_average_config_t;
+
+typedef struct
+{
+    bool interruptEnable;
+    adc_inputchannel_t channel;
+} adc_chan_config_t;
+
+/******************************************************************************/
+/*                Declaration of exported function prototypes               */
+/******************************************************************************/
+void ADC_DRV_InitConverterStruct(adc_converter_config_t * const config);
+void ADC_DRV_ConfigConverter(const uint32_t instance, const adc_converter_config_t * const config);
+void ADC_DRV_InitHwAverageStruct(adc_average_config_t * const config);
+void ADC_DRV_ConfigHwAverage(const uint32_t instance, const adc_average_config_t * const config);
+void ADC_DRV_InitChanStruct(adc_chan_config_t * const config);
+void ADC_DRV_ConfigChan(const uint32_t instance, const uint8_t chanIndex,
+                        const adc_chan_config_t * const config);
+void ADC_DRV_SetSwPretrigger(const uint32_t instance, const adc_sw_pretrigger_t swPretrigger);
+void ADC_DRV_WaitConvDone(const uint32_t instance);
+void ADC_DRV_GetChanResult(const uint32_t instance, const uint8_t chanIndex, uint16_t * const result);
+void ADC_DRV_AutoCalibration(const uint32_t instance);
+
+#endif /* MOCK_ADC_DRIVER_H_ */
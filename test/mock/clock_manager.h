@@ -0,0 +1,48 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host stand-in of the clock manager                                       */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Frequencies of the board clocks, as set by the clock configuration of    */
+/*   the firmware (board/clock_config.c).                                     */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef MOCK_CLOCK_MANAGER_H_
+#define MOCK_CLOCK_MANAGER_H_
+
+#include <stdint.h>
+#include "status.h"
+
+/******************************************************************************/
+/*                Definition of exported symbolic constants               */
+/******************************************************************************/
+/** \brief Board clocks (board/clock_config.c), in Hz. */
+#define MOCK_CORE_HZ          48000000U
+#define MOCK_BUS_HZ           48000000U
+#define MOCK_LPSPI_CLK_HZ     8000000U
+#define MOCK_LPIT_HZ          8000000U
+#define MOCK_LPI2C_CLK_HZ     8000000U
+
+/******************************************************************************/
+/*                Definition of exported types                                */
+/******************************************************************************/
+typedef enum
+{
+    CORE_CLK = 0U,
+    LPSPI0_CLK,
+    LPIT0_CLK,
+    LPI2C0_CLK,
+    BUS_CLK
+} clock_names_t;
+
+/******************************************************************************/
+/*                Declaration of exported function prototypes               */
+/******************************************************************************/
+status_t CLOCK_SYS_GetFreq(clock_names_t clockName, uint32_t *frequency);
+
+#endif /* MOCK_CLOCK_MANAGER_H_ */
@@ -0,0 +1,134 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host stand-in of the S32K144 device registers                            */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Only the registers the host tests reach through a peripheral base        */
+/*   pointer. The peripherals are plain RAM, or simulated by the mock of the  */
+/*   matching driver (mock_lpspi.c, mock_lpi2c.c, mock_adc.c).                */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef MOCK_DEVICE_REGISTERS_H_
+#define MOCK_DEVICE_REGISTERS_H_
+
+#include <stdint.h>
+
+/******************************************************************************/
+/*                Definition of exported types                                */
+/******************************************************************************/
+/** \brief LPSPI registers: only the TCR is kept, the FIFOs are simulated. */
+typedef struct
+{
+    volatile uint32_t TCR;
+} LPSPI_Type;
+
+/** \brief LPI2C registers: only the slave registers written by the HAL. */
+typedef struct
+{
+    volatile uint32_t SCR;
+    volatile uint32_t SSR;
+    volatile uint32_t SCFGR1;
+    volatile uint32_t SCFGR2;
+    volatile uint32_t SAMR;
+} LPI2C_Type;
+
+/** \brief ADC registers: control channels, results and compare values. */
+typedef struct
+{
+    volatile uint32_t SC1[16];
+    volatile uint32_t CFG1;
+    volatile uint32_t CFG2;
+    volatile uint32_t R[16];
+    volatile uint32_t CV[2];
+    volatile uint32_t SC2;
+    volatile uint32_t SC3;
+} ADC_Type;
+
+/** \brief PDB registers: counter, modulus and pre-trigger channels. */
+typedef struct
+{
+    volatile uint32_t SC;
+    volatile uint32_t MOD;
+    volatile uint32_t CNT;
+    volatile uint32_t IDLY;
+    struct
+    {
+        volatile uint32_t C1;
+        volatile uint32_t S;
+        volatile uint32_t DLY[8];
+    } CH[2];
+} PDB_Type;
+
+/******************************************************************************/
+/*                Definition of exported symbolic constants               */
+/******************************************************************************/
+#define LPSPI_TCR_FRAMESZ_MASK   0xFFFU
+#define LPSPI_TCR_CONT_MASK      0x200000U
+#define LPSPI_TCR_BYSW_MASK      0x400000U
+#define LPSPI_TCR_PRESCALE_MASK  0x38000000U
+#define LPSPI_TCR_PRESCALE_SHIFT 27U
+
+#define LPI2C_HAS_FAST_PLUS_MODE (0U)
+
+#define LPI2C_SCR_SEN_MASK          0x1U
+#define LPI2C_SCR_FILTEN_MASK       0x10U
+#define LPI2C_SCR_RTF_MASK          0x100U
+#define LPI2C_SSR_TDF_MASK          0x1U
+#define LPI2C_SSR_SBF_MASK          0x1000000U
+#define LPI2C_SCFGR1_ADDRCFG_MASK   0x70000U
+#define LPI2C_SCFGR1_ADDRCFG_SHIFT  16U
+#define LPI2C_SCFGR2_CLKHOLD_MASK   0xFU
+#define LPI2C_SCFGR2_CLKHOLD_SHIFT  0U
+#define LPI2C_SCFGR2_CLKHOLD(x)     (((uint32_t)(((uint32_t)(x))<<LPI2C_SCFGR2_CLKHOLD_SHIFT))&LPI2C_SCFGR2_CLKHOLD_MASK)
+#define LPI2C_SCFGR2_DATAVD_MASK    0x3F00U
+#define LPI2C_SCFGR2_DATAVD_SHIFT   8U
+#define LPI2C_SCFGR2_DATAVD(x)      (((uint32_t)(((uint32_t)(x))<<LPI2C_SCFGR2_DATAVD_SHIFT))&LPI2C_SCFGR2_DATAVD_MASK)
+#define LPI2C_SCFGR2_FILTSCL_MASK   0xF0000U
+#define LPI2C_SCFGR2_FILTSCL_SHIFT  16U
+#define LPI2C_SCFGR2_FILTSCL(x)     (((uint32_t)(((uint32_t)(x))<<LPI2C_SCFGR2_FILTSCL_SHIFT))&LPI2C_SCFGR2_FILTSCL_MASK)
+#define LPI2C_SCFGR2_FILTSDA_MASK   0xF000000U
+#define LPI2C_SCFGR2_FILTSDA_SHIFT  24U
+#define LPI2C_SCFGR2_FILTSDA(x)     (((uint32_t)(((uint32_t)(x))<<LPI2C_SCFGR2_FILTSDA_SHIFT))&LPI2C_SCFGR2_FILTSDA_MASK)
+#define LPI2C_SAMR_ADDR1_MASK       0x7FE0000U
+#define LPI2C_SAMR_ADDR1_SHIFT      17U
+#define LPI2C_SAMR_ADDR1(x)         (((uint32_t)(((uint32_t)(x))<<LPI2C_SAMR_ADDR1_SHIFT))&LPI2C_SAMR_ADDR1_MASK)
+
+#define ADC_SC1_ADCH_MASK           0x3FU
+#define ADC_SC2_ACFE_MASK           0x20U
+
+#define PDB_SC_LDOK(x)              (((uint32_t)(x) << 0U) & 0x1U)
+#define PDB_SC_CONT(x)              (((uint32_t)(x) << 1U) & 0x2U)
+#define PDB_SC_MULT(x)              (((uint32_t)(x) << 2U) & 0xCU)
+#define PDB_SC_PDBEN(x)             (((uint32_t)(x) << 7U) & 0x80U)
+#define PDB_SC_TRGSEL(x)            (((uint32_t)(x) << 8U) & 0xF00U)
+#define PDB_SC_PRESCALER_MASK       0x7000U
+#define PDB_SC_PRESCALER_SHIFT      12U
+#define PDB_SC_PRESCALER(x)         (((uint32_t)(x) << PDB_SC_PRESCALER_SHIFT) & PDB_SC_PRESCALER_MASK)
+#define PDB_SC_SWTRIG(x)            (((uint32_t)(x) << 16U) & 0x10000U)
+#define PDB_MOD_MOD_MASK            0xFFFFU
+#define PDB_MOD_MOD(x)              ((uint32_t)(x) & PDB_MOD_MOD_MASK)
+#define PDB_IDLY_IDLY(x)            ((uint32_t)(x) & 0xFFFFU)
+#define PDB_DLY_DLY(x)              ((uint32_t)(x) & 0xFFFFU)
+#define PDB_C1_EN(x)                (((uint32_t)(x) << 0U) & 0xFFU)
+#define PDB_C1_TOS(x)               (((uint32_t)(x) << 8U) & 0xFF00U)
+#define PDB_C1_BB(x)                (((uint32_t)(x) << 16U) & 0xFF0000U)
+
+/******************************************************************************/
+/*                Declaration of exported variables                           */
+/******************************************************************************/
+extern LPSPI_Type mock_lpspi0;
+extern LPI2C_Type mock_lpi2c0;
+extern ADC_Type mock_adc0;
+extern PDB_Type mock_pdb0;
+
+#define LPSPI0 (&mock_lpspi0)
+#define LPI2C0 (&mock_lpi2c0)
+#define ADC0   (&mock_adc0)
+#define PDB0   (&mock_pdb0)
+
+#endif /* MOCK_DEVICE_REGISTERS_H_ */
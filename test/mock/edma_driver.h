@@ -0,0 +1,132 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host stand-in of the eDMA driver                                         */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Same types and prototypes as the SDK header, for the functions used by   */
+/*   the HAL modules under test.                                              */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef MOCK_EDMA_DRIVER_H_
+#define MOCK_EDMA_DRIVER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "status.h"
+
+/******************************************************************************/
+/*                Definition of exported types                                */
+/******************************************************************************/
+typedef enum
+{
+    EDMA_CHN_DEFAULT_PRIORITY = 255U
+} edma_channel_priority_t;
+
+typedef enum
+{
+    EDMA_REQ_LPI2C0_RX = 10U,
+    EDMA_REQ_LPI2C0_TX = 11U,
+    EDMA_REQ_LPSPI0_RX = 14U,
+    EDMA_REQ_LPSPI0_TX = 15U,
+    EDMA_REQ_ADC0      = 42U
+} dma_request_source_t;
+
+typedef enum
+{
+    EDMA_CHN_NORMAL = 0U,
+    EDMA_CHN_ERROR
+} edma_chn_status_t;
+
+typedef enum
+{
+    EDMA_CHN_ERR_INT = 0U,
+    EDMA_CHN_HALF_MAJOR_LOOP_INT,
+    EDMA_CHN_MAJOR_LOOP_INT
+} edma_channel_interrupt_t;
+
+typedef enum
+{
+    EDMA_TRANSFER_SIZE_1B = 0x0U,
+    EDMA_TRANSFER_SIZE_2B = 0x1U,
+    EDMA_TRANSFER_SIZE_4B = 0x2U
+} edma_transfer_size_t;
+
+typedef enum
+{
+    EDMA_MODULO_OFF = 0U,
+    EDMA_MODULO_2B,
+    EDMA_MODULO_4B,
+    EDMA_MODULO_8B
+} edma_modulo_t;
+
+typedef void (*edma_callback_t)(void *parameter, edma_chn_status_t status);
+
+typedef struct
+{
+    uint8_t virtChn;
+    edma_callback_t callback;
+    void *parameter;
+} edma_chn_state_t;
+
+typedef struct
+{
+    edma_channel_priority_t channelPriority;
+    uint8_t virtChnConfig;
+    dma_request_source_t source;
+    edma_callback_t callback;
+    void *callbackParam;
+    bool enableTrigger;
+} edma_channel_config_t;
+
+typedef struct
+{
+    uint32_t majorLoopIterationCount;
+    bool srcOffsetEnable;
+    bool dstOffsetEnable;
+    int32_t minorLoopOffset;
+    bool minorLoopChnLinkEnable;
+    uint8_t minorLoopChnLinkNumber;
+    bool majorLoopChnLinkEnable;
+    uint8_t majorLoopChnLinkNumber;
+} edma_loop_transfer_config_t;
+
+typedef struct
+{
+    uint32_t srcAddr;
+    uint32_t destAddr;
+    edma_transfer_size_t srcTransferSize;
+    edma_transfer_size_t destTransferSize;
+    int16_t srcOffset;
+    int16_t destOffset;
+    int32_t srcLastAddrAdjust;
+    int32_t destLastAddrAdjust;
+    edma_modulo_t srcModulo;
+    edma_modulo_t destModulo;
+    uint32_t minorByteTransferCount;
+    bool scatterGatherEnable;
+    uint32_t scatterGatherNextDescAddr;
+    bool interruptEnable;
+    edma_loop_transfer_config_t *loopTransferConfig;
+} edma_transfer_config_t;
+
+/******************************************************************************/
+/*                Declaration of exported function prototypes               */
+/******************************************************************************/
+status_t EDMA_DRV_ChannelInit(edma_chn_state_t *edmaChannelState,
+                              const edma_channel_config_t *edmaChannelConfig);
+void EDMA_DRV_SetSrcAddr(uint8_t virtualChannel, uint32_t address);
+void EDMA_DRV_SetSrcOffset(uint8_t virtualChannel, int16_t offset);
+void EDMA_DRV_SetSrcLastAddrAdjustment(uint8_t virtualChannel, int32_t adjust);
+void EDMA_DRV_SetDestAddr(uint8_t virtualChannel, uint32_t address);
+void EDMA_DRV_SetDestOffset(uint8_t virtualChannel, int16_t offset);
+uint32_t EDMA_DRV_GetRemainingMajorIterationsCount(uint8_t virtualChannel);
+status_t EDMA_DRV_ConfigLoopTransfer(uint8_t virtualChannel, const edma_transfer_config_t *transferConfig);
+void EDMA_DRV_ConfigureInterrupt(uint8_t virtualChannel, edma_channel_interrupt_t intSrc, bool enable);
+status_t EDMA_DRV_StartChannel(uint8_t virtualChannel);
+
+#endif /* MOCK_EDMA_DRIVER_H_ */
@@ -0,0 +1,24 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host stand-in of the interrupt manager                                   */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Same prototypes as the SDK header, for the functions used by the HAL     */
+/*   modules under test. They are implemented by mock_platform.c.             */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef MOCK_INTERRUPT_MANAGER_H_
+#define MOCK_INTERRUPT_MANAGER_H_
+
+/******************************************************************************/
+/*                Declaration of exported function prototypes               */
+/******************************************************************************/
+void INT_SYS_EnableIRQGlobal(void);
+void INT_SYS_DisableIRQGlobal(void);
+
+#endif /* MOCK_INTERRUPT_MANAGER_H_ */
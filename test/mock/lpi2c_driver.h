@@ -0,0 +1,71 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host stand-in of the LPI2C driver                                        */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Same types and prototypes as the SDK header, for the slave functions     */
+/*   used by HAL_i2c.c. They are implemented by mock_lpi2c.c.                 */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef MOCK_LPI2C_DRIVER_H_
+#define MOCK_LPI2C_DRIVER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "status.h"
+#include "callbacks.h"
+#include "device_registers.h"
+
+/******************************************************************************/
+/*                Definition of exported types                                */
+/******************************************************************************/
+typedef enum
+{
+    LPI2C_STANDARD_MODE = 0x0U,
+    LPI2C_FAST_MODE     = 0x1U
+} lpi2c_mode_t;
+
+typedef enum
+{
+    LPI2C_USING_DMA        = 0,
+    LPI2C_USING_INTERRUPTS = 1
+} lpi2c_transfer_type_t;
+
+typedef struct
+{
+    uint16_t slaveAddress;
+    bool is10bitAddr;
+    lpi2c_mode_t operatingMode;
+    bool slaveListening;
+    lpi2c_transfer_type_t transferType;
+    uint8_t dmaChannel;
+    i2c_slave_callback_t slaveCallback;
+    void *callbackParam;
+} lpi2c_slave_user_config_t;
+
+/** \brief Slave state: the fields the HAL and the mock use. */
+typedef struct
+{
+    uint32_t txSize;
+    uint32_t rxSize;
+    const uint8_t *txBuff;
+    uint8_t *rxBuff;
+    uint8_t repeatedStarts;
+    i2c_slave_callback_t slaveCallback;
+    void *callbackParam;
+} lpi2c_slave_state_t;
+
+/******************************************************************************/
+/*                Declaration of exported function prototypes               */
+/******************************************************************************/
+status_t LPI2C_DRV_SlaveInit(uint32_t instance, const lpi2c_slave_user_config_t *userConfigPtr,
+                             lpi2c_slave_state_t *slave);
+status_t LPI2C_DRV_SlaveSetTxBuffer(uint32_t instance, const uint8_t *txBuff, uint32_t txSize);
+status_t LPI2C_DRV_SlaveSetRxBuffer(uint32_t instance, uint8_t *rxBuff, uint32_t rxSize);
+
+#endif /* MOCK_LPI2C_DRIVER_H_ */
@@ -0,0 +1,40 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host stand-in of the LPI2C register access layer                         */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Same types and prototypes as the SDK header, for the functions used by   */
+/*   HAL_i2c.c. They are implemented by mock_lpi2c.c instead of inline        */
+/*   register accesses.                                                       */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef MOCK_LPI2C_HW_ACCESS_H_
+#define MOCK_LPI2C_HW_ACCESS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "device_registers.h"
+
+/******************************************************************************/
+/*                Definition of exported types                                */
+/******************************************************************************/
+typedef enum
+{
+    LPI2C_SLAVE_ADDR_MATCH_0_7BIT            = 0U,
+    LPI2C_SLAVE_ADDR_MATCH_0_10BIT           = 1U,
+    LPI2C_SLAVE_ADDR_MATCH_0_7BIT_OR_1_7BIT  = 2U
+} lpi2c_slave_addr_config_t;
+
+/******************************************************************************/
+/*                Declaration of exported function prototypes               */
+/******************************************************************************/
+void LPI2C_Set_SlaveEnable(LPI2C_Type *baseAddr, bool enable);
+void LPI2C_Set_SlaveAddrConfig(LPI2C_Type *baseAddr, lpi2c_slave_addr_config_t configuration);
+uint16_t LPI2C_Get_SlaveReceivedAddr(const LPI2C_Type *baseAddr);
+
+#endif /* MOCK_LPI2C_HW_ACCESS_H_ */
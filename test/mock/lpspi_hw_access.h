@@ -0,0 +1,96 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host stand-in of the LPSPI register access layer                         */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Same types and prototypes as the SDK header, for the functions used by   */
+/*   HAL_spi.c. They are implemented by the FIFO model of mock_lpspi.c        */
+/*   instead of inline register accesses.                                     */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef MOCK_LPSPI_HW_ACCESS_H_
+#define MOCK_LPSPI_HW_ACCESS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "status.h"
+#include "device_registers.h"
+
+/******************************************************************************/
+/*                Definition of exported types                                */
+/******************************************************************************/
+typedef enum
+{
+    LPSPI_PCS0 = 0U,
+    LPSPI_PCS1 = 1U,
+    LPSPI_PCS2 = 2U,
+    LPSPI_PCS3 = 3U
+} lpspi_which_pcs_t;
+
+typedef enum
+{
+    LPSPI_ACTIVE_HIGH = 1U,
+    LPSPI_ACTIVE_LOW  = 0U
+} lpspi_signal_polarity_t;
+
+typedef enum
+{
+    LPSPI_CLOCK_PHASE_1ST_EDGE = 0U,
+    LPSPI_CLOCK_PHASE_2ND_EDGE = 1U
+} lpspi_clock_phase_t;
+
+typedef enum
+{
+    LPSPI_SCK_ACTIVE_HIGH = 0U,
+    LPSPI_SCK_ACTIVE_LOW  = 1U
+} lpspi_sck_polarity_t;
+
+typedef enum
+{
+    LPSPI_SINGLE_BIT_XFER = 0U,
+    LPSPI_TWO_BIT_XFER    = 1U,
+    LPSPI_FOUR_BIT_XFER   = 2U
+} lpspi_transfer_width_t;
+
+typedef enum
+{
+    LPSPI_RECEIVE_ERROR = 12U,
+    LPSPI_MODULE_BUSY   = 24U,
+    LPSPI_ALL_STATUS    = 0x00003F00U
+} lpspi_status_flag_t;
+
+typedef struct
+{
+    uint32_t frameSize;
+    lpspi_transfer_width_t width;
+    bool txMask;
+    bool rxMask;
+    bool contCmd;
+    bool contTransfer;
+    bool byteSwap;
+    bool lsbFirst;
+    lpspi_which_pcs_t whichPcs;
+    uint32_t preDiv;
+    lpspi_clock_phase_t clkPhase;
+    lpspi_sck_polarity_t clkPolarity;
+} lpspi_tx_cmd_config_t;
+
+/******************************************************************************/
+/*                Declaration of exported function prototypes               */
+/******************************************************************************/
+void LPSPI_GetFifoSizes(const LPSPI_Type *base, uint8_t *fifoSize);
+void LPSPI_SetFlushFifoCmd(LPSPI_Type *base, bool flushTxFifo, bool flushRxFifo);
+bool LPSPI_GetStatusFlag(const LPSPI_Type *base, lpspi_status_flag_t statusFlag);
+status_t LPSPI_ClearStatusFlag(LPSPI_Type *base, lpspi_status_flag_t statusFlag);
+void LPSPI_SetTxCommandReg(LPSPI_Type *base, const lpspi_tx_cmd_config_t *txCmdCfgSet);
+void LPSPI_WriteData(LPSPI_Type *base, uint32_t data);
+uint32_t LPSPI_ReadData(const LPSPI_Type *base);
+uint32_t LPSPI_ReadTxCount(const LPSPI_Type *base);
+uint32_t LPSPI_ReadRxCount(const LPSPI_Type *base);
+
+#endif /* MOCK_LPSPI_HW_ACCESS_H_ */
@@ -0,0 +1,72 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host stand-in of the LPSPI master driver                                 */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Same types and prototypes as the SDK header, for the functions used by   */
+/*   HAL_spi.c. They are implemented by mock_lpspi.c.                         */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef MOCK_LPSPI_MASTER_DRIVER_H_
+#define MOCK_LPSPI_MASTER_DRIVER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "status.h"
+#include "callbacks.h"
+#include "lpspi_hw_access.h"
+
+/******************************************************************************/
+/*                Definition of exported types                                */
+/******************************************************************************/
+typedef enum
+{
+    LPSPI_USING_DMA        = 0,
+    LPSPI_USING_INTERRUPTS
+} lpspi_transfer_type;
+
+typedef struct
+{
+    uint32_t bitsPerSec;
+    lpspi_which_pcs_t whichPcs;
+    lpspi_signal_polarity_t pcsPolarity;
+    bool isPcsContinuous;
+    uint16_t bitcount;
+    uint32_t lpspiSrcClk;
+    lpspi_clock_phase_t clkPhase;
+    lpspi_sck_polarity_t clkPolarity;
+    bool lsbFirst;
+    lpspi_transfer_type transferType;
+    uint8_t rxDMAChannel;
+    uint8_t txDMAChannel;
+    spi_callback_t callback;
+    void *callbackParam;
+} lpspi_master_config_t;
+
+/** \brief Driver state: only the callback is kept by the mock. */
+typedef struct
+{
+    spi_callback_t callback;
+    void *callbackParam;
+} lpspi_state_t;
+
+/******************************************************************************/
+/*                Declaration of exported function prototypes               */
+/******************************************************************************/
+status_t LPSPI_DRV_MasterInit(uint32_t instance, lpspi_state_t *lpspiState,
+                              const lpspi_master_config_t *spiConfig);
+status_t LPSPI_DRV_MasterConfigureBus(uint32_t instance, const lpspi_master_config_t *spiConfig,
+                                      uint32_t *calculatedBaudRate);
+status_t LPSPI_DRV_MasterTransferBlocking(uint32_t instance, const uint8_t *sendBuffer,
+                                          uint8_t *receiveBuffer, uint16_t transferByteCount,
+                                          uint32_t timeout);
+status_t LPSPI_DRV_MasterTransfer(uint32_t instance, const uint8_t *sendBuffer,
+                                  uint8_t *receiveBuffer, uint16_t transferByteCount);
+status_t LPSPI_DRV_MasterGetTransferStatus(uint32_t instance, uint32_t *bytesRemained);
+
+#endif /* MOCK_LPSPI_MASTER_DRIVER_H_ */
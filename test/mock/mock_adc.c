@@ -0,0 +1,148 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host simulation of ADC0 and of its driver                                */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Stand-ins of the ADC driver and the ADC0 and PDB0 registers. A           */
+/*   conversion of a control channel samples mock_adcInput[] for the input    */
+/*   channel selected in its SC1 register and stores the code, truncated to   */
+/*   the configured resolution, in its result register R. The hardware        */
+/*   compare unit is not modelled: the HAL does not use it, and SC2[ACFE]     */
+/*   stays clear unless a test sets it.                                       */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#include <string.h>
+#include "adc_driver.h"
+#include "peripherals_adc_config_1.h"
+
+/******************************************************************************/
+/*                   Definition of exported variables                         */
+/******************************************************************************/
+/** \brief Registers of ADC0 and PDB0. */
+ADC_Type mock_adc0;
+PDB_Type mock_pdb0;
+
+/** \brief Converter configuration of the board (12-bit). */
+adc_converter_config_t adc_config_1_ConvConfig0 = {
+    .resolution = ADC_RESOLUTION_12BIT,
+    .trigger = ADC_TRIGGER_SOFTWARE,
+    .pretriggerSel = ADC_PRETRIGGER_SEL_PDB,
+    .triggerSel = ADC_TRIGGER_SEL_PDB,
+    .dmaEnable = false,
+    .voltageRef = ADC_VOLTAGEREF_VREF,
+    .continuousConvEnable = false
+};
+
+/** \brief Last configuration passed to ADC_DRV_ConfigConverter(). */
+adc_converter_config_t mock_adcConverter;
+
+/** \brief Last configuration passed to ADC_DRV_ConfigHwAverage(). */
+adc_average_config_t mock_adcAverage;
+
+/** \brief Input of each analog channel, as a 12-bit code. */
+uint16_t mock_adcInput[16];
+
+/** \brief Calls of ADC_DRV_AutoCalibration(). */
+uint32_t mock_adcCalibrations = 0U;
+
+/******************************************************************************/
+/*                   Definition of exported functions                         */
+/******************************************************************************/
+
+/** \brief Clears the registers, the inputs and the records. */
+void mock_adcReset(void)
+{
+    memset(&mock_adc0, 0, sizeof(mock_adc0));
+    memset(&mock_pdb0, 0, sizeof(mock_pdb0));
+    memset(&mock_adcConverter, 0, sizeof(mock_adcConverter));
+    memset(&mock_adcAverage, 0, sizeof(mock_adcAverage));
+    memset(mock_adcInput, 0, sizeof(mock_adcInput));
+    mock_adcCalibrations = 0U;
+}
+
+/** \brief Converts a control channel: samples its input into its R register. */
+void mock_adcConvert(uint8_t chanIndex)
+{
+    uint32_t input = mock_adcInput[mock_adc0.SC1[chanIndex] & ADC_SC1_ADCH_MASK] & 0xFFFU;
+
+    switch (mock_adcConverter.resolution)
+    {
+        case ADC_RESOLUTION_8BIT:
+            mock_adc0.R[chanIndex] = input >> 4U;
+            break;
+        case ADC_RESOLUTION_10BIT:
+            mock_adc0.R[chanIndex] = input >> 2U;
+            break;
+        default:
+            mock_adc0.R[chanIndex] = input;
+            break;
+    }
+}
+
+/* Stand-ins of the ADC driver, declared by the headers of this directory */
+
+void ADC_DRV_InitConverterStruct(adc_converter_config_t * const config)
+{
+    memset(config, 0, sizeof(*config));
+    config->resolution = ADC_RESOLUTION_8BIT;
+}
+
+void ADC_DRV_ConfigConverter(const uint32_t instance, const adc_converter_config_t * const config)
+{
+    (void)instance;
+    mock_adcConverter = *config;
+}
+
+void ADC_DRV_InitHwAverageStruct(adc_average_config_t * const config)
+{
+    config->hwAvgEnable = false;
+    config->hwAverage = ADC_AVERAGE_4;
+}
+
+void ADC_DRV_ConfigHwAverage(const uint32_t instance, const adc_average_config_t * const config)
+{
+    (void)instance;
+    mock_adcAverage = *config;
+}
+
+void ADC_DRV_InitChanStruct(adc_chan_config_t * const config)
+{
+    config->interruptEnable = false;
+    config->channel = 0x3FU;
+}
+
+void ADC_DRV_ConfigChan(const uint32_t instance, const uint8_t chanIndex,
+                        const adc_chan_config_t * const config)
+{
+    (void)instance;
+    mock_adc0.SC1[chanIndex] = config->channel & ADC_SC1_ADCH_MASK;
+}
+
+void ADC_DRV_SetSwPretrigger(const uint32_t instance, const adc_sw_pretrigger_t swPretrigger)
+{
+    (void)instance;
+    (void)swPretrigger;
+}
+
+void ADC_DRV_WaitConvDone(const uint32_t instance)
+{
+    (void)instance;
+    mock_adcConvert(0U);
+}
+
+void ADC_DRV_GetChanResult(const uint32_t instance, const uint8_t chanIndex, uint16_t * const result)
+{
+    (void)instance;
+    *result = (uint16_t)mock_adc0.R[chanIndex];
+}
+
+void ADC_DRV_AutoCalibration(const uint32_t instance)
+{
+    (void)instance;
+    mock_adcCalibrations++;
+}
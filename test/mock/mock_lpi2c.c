@@ -0,0 +1,218 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host simulation of the LPI2C0 slave and of its driver                    */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Stand-ins of the slave driver in listening mode with eDMA transfers and  */
+/*   helpers playing the master. On an address match the driver raises        */
+/*   TX_REQ or RX_REQ, then starts the eDMA channel (mock_platform.c) on its  */
+/*   transmit buffer if it holds one, on its receive buffer otherwise. During */
+/*   a master read eDMA loads STDR one byte ahead of the master: the byte     */
+/*   loaded last is still in STDR, with SSR[TDF] clear, unless the request    */
+/*   for it was not served yet. A repeated START is counted in the driver     */
+/*   state and reported as a STOP, as the SDK driver does.                    */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "lpi2c_driver.h"
+#include "lpi2c_hw_access.h"
+#include "peripherals_lpi2c_config_1.h"
+
+/******************************************************************************/
+/*                   Definition of exported variables                         */
+/******************************************************************************/
+/** \brief Slave registers of LPI2C0. */
+LPI2C_Type mock_lpi2c0;
+
+/** \brief Slave configuration of the board. */
+lpi2c_slave_user_config_t lpi2c0_SlaveConfig0 = {
+    .slaveAddress = 0x00U,
+    .is10bitAddr = false,
+    .operatingMode = LPI2C_STANDARD_MODE,
+    .slaveListening = true,
+    .transferType = LPI2C_USING_INTERRUPTS,
+    .dmaChannel = 0U,
+    .slaveCallback = NULL,
+    .callbackParam = NULL
+};
+
+/** \brief Configuration passed to LPI2C_DRV_SlaveInit(). */
+lpi2c_slave_user_config_t mock_lpi2cConfig;
+
+/** \brief Received address: 7-bit address and R/W bit, as in SASR[RADDR]. */
+uint16_t mock_lpi2cReceivedAddr = 0U;
+
+/** \brief true if the driver started a transmit transfer on the last address. */
+bool mock_lpi2cTransmitting = false;
+
+/******************************************************************************/
+/*                   Definition of local variables                            */
+/******************************************************************************/
+/** \brief Driver state given to LPI2C_DRV_SlaveInit(). */
+static lpi2c_slave_state_t *s_mockSlave = NULL;
+
+/******************************************************************************/
+/*                   Declaration of mock_platform.c functions                 */
+/******************************************************************************/
+void mock_edmaStart(uint32_t majorCount);
+void mock_edmaIteration(void);
+extern uint32_t mock_edmaMajorCount;
+extern uint32_t mock_edmaRemaining;
+extern uint32_t mock_edmaMajorLoops;
+
+/******************************************************************************/
+/*                   Definition of local functions                            */
+/******************************************************************************/
+
+/** \brief Calls the slave callback installed by LPI2C_DRV_SlaveInit(). */
+static void mock_lpi2cEvent(i2c_slave_event_t event)
+{
+    if ((s_mockSlave != NULL) && (s_mockSlave->slaveCallback != NULL))
+    {
+        s_mockSlave->slaveCallback(event, s_mockSlave->callbackParam);
+    }
+}
+
+/******************************************************************************/
+/*                   Definition of exported functions                         */
+/******************************************************************************/
+
+/** \brief Clears the registers and the records of the driver stand-ins. */
+void mock_lpi2cReset(void)
+{
+    memset(&mock_lpi2c0, 0, sizeof(mock_lpi2c0));
+    memset(&mock_lpi2cConfig, 0, sizeof(mock_lpi2cConfig));
+    mock_lpi2cReceivedAddr = 0U;
+    mock_lpi2cTransmitting = false;
+    s_mockSlave = NULL;
+    mock_edmaStart(0U);
+}
+
+/**
+ * \brief The master addresses the slave: START (or repeated START), address
+ *        and R/W bit.
+ */
+void mock_lpi2cAddress(uint8_t address, bool read)
+{
+    mock_lpi2cReceivedAddr = (uint16_t)(((uint16_t)address << 1U) | (read ? 1U : 0U));
+    mock_lpi2c0.SSR |= LPI2C_SSR_TDF_MASK;
+    mock_lpi2cEvent(read ? I2C_SLAVE_EVENT_TX_REQ : I2C_SLAVE_EVENT_RX_REQ);
+
+    mock_lpi2cTransmitting = (s_mockSlave->txSize != 0U);
+    mock_edmaStart(mock_lpi2cTransmitting ? s_mockSlave->txSize : s_mockSlave->rxSize);
+}
+
+/**
+ * \brief The master reads bytes; stdrLoaded tells whether eDMA has already
+ *        loaded the next byte into STDR when the transfer ends.
+ */
+void mock_lpi2cMasterRead(uint32_t bytes, bool stdrLoaded)
+{
+    uint32_t loads = bytes + (stdrLoaded ? 1U : 0U);
+    uint32_t i;
+
+    for (i = 0U; i < loads; i++)
+    {
+        mock_edmaIteration();
+    }
+    if (stdrLoaded)
+    {
+        mock_lpi2c0.SSR &= ~LPI2C_SSR_TDF_MASK;
+    }
+    else
+    {
+        mock_lpi2c0.SSR |= LPI2C_SSR_TDF_MASK;
+    }
+}
+
+/**
+ * \brief The master writes bytes: eDMA stores them in the receive buffer until
+ *        its major loop ends, then drops them.
+ */
+void mock_lpi2cMasterWrite(const uint8_t *data, uint32_t length)
+{
+    uint32_t i;
+
+    for (i = 0U; i < length; i++)
+    {
+        if (mock_edmaMajorLoops == 0U)
+        {
+            s_mockSlave->rxBuff[mock_edmaMajorCount - mock_edmaRemaining] = data[i];
+        }
+        mock_edmaIteration();
+    }
+}
+
+/** \brief The master ends the transfer with a STOP. */
+void mock_lpi2cStop(void)
+{
+    mock_lpi2cEvent(I2C_SLAVE_EVENT_STOP);
+}
+
+/** \brief The master ends the transfer with a repeated START. */
+void mock_lpi2cRepeatedStart(void)
+{
+    s_mockSlave->repeatedStarts++;
+    mock_lpi2cEvent(I2C_SLAVE_EVENT_STOP);
+}
+
+/* Stand-ins of the LPI2C driver, declared by the headers of this directory */
+
+status_t LPI2C_DRV_SlaveInit(uint32_t instance, const lpi2c_slave_user_config_t *userConfigPtr,
+                             lpi2c_slave_state_t *slave)
+{
+    (void)instance;
+    mock_lpi2cConfig = *userConfigPtr;
+    memset(slave, 0, sizeof(*slave));
+    slave->slaveCallback = userConfigPtr->slaveCallback;
+    slave->callbackParam = userConfigPtr->callbackParam;
+    s_mockSlave = slave;
+    mock_lpi2c0.SCR |= LPI2C_SCR_SEN_MASK;
+    return STATUS_SUCCESS;
+}
+
+status_t LPI2C_DRV_SlaveSetTxBuffer(uint32_t instance, const uint8_t *txBuff, uint32_t txSize)
+{
+    (void)instance;
+    s_mockSlave->txBuff = txBuff;
+    s_mockSlave->txSize = txSize;
+    return STATUS_SUCCESS;
+}
+
+status_t LPI2C_DRV_SlaveSetRxBuffer(uint32_t instance, uint8_t *rxBuff, uint32_t rxSize)
+{
+    (void)instance;
+    s_mockSlave->rxBuff = rxBuff;
+    s_mockSlave->rxSize = rxSize;
+    return STATUS_SUCCESS;
+}
+
+void LPI2C_Set_SlaveEnable(LPI2C_Type *baseAddr, bool enable)
+{
+    if (enable)
+    {
+        baseAddr->SCR |= LPI2C_SCR_SEN_MASK;
+    }
+    else
+    {
+        baseAddr->SCR &= ~LPI2C_SCR_SEN_MASK;
+    }
+}
+
+void LPI2C_Set_SlaveAddrConfig(LPI2C_Type *baseAddr, lpi2c_slave_addr_config_t configuration)
+{
+    baseAddr->SCFGR1 = (baseAddr->SCFGR1 & ~LPI2C_SCFGR1_ADDRCFG_MASK) |
+                       (((uint32_t)configuration << LPI2C_SCFGR1_ADDRCFG_SHIFT) & LPI2C_SCFGR1_ADDRCFG_MASK);
+}
+
+uint16_t LPI2C_Get_SlaveReceivedAddr(const LPI2C_Type *baseAddr)
+{
+    (void)baseAddr;
+    return mock_lpi2cReceivedAddr;
+}
@@ -0,0 +1,356 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host simulation of LPSPI0 and of its master driver                       */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Cycle model of the LPSPI0 FIFOs on a virtual core clock, for the polled  */
+/*   transfer of HAL_spi.c, and stand-ins of the driver calls, for its        */
+/*   asynchronous transfers. SDO is looped back to SDI: every frame shifted   */
+/*   out is received unchanged. Every register access costs                   */
+/*   MOCK_ACCESS_CYCLES; a frame leaves the TX FIFO one functional clock after*/
+/*   it is written and reaches the RX FIFO one functional clock after it has  */
+/*   been shifted, as on the S32K144.                                         */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#include <string.h>
+#include "lpspi_master_driver.h"
+#include "clock_manager.h"
+#include "HAL_tim.h"
+
+/******************************************************************************/
+/*                   Definition of local symbolic constants                 */
+/******************************************************************************/
+/** \brief Depth of the LPSPI FIFOs, in frames. */
+#define MOCK_LPSPI_FIFO_SIZE  4U
+
+/** \brief Core cycles of one LPSPI or LPIT register access (peripheral bridge). */
+#define MOCK_ACCESS_CYCLES    3U
+
+/** \brief Core cycles of one LPSPI functional clock. */
+#define MOCK_LPSPI_LATENCY    (MOCK_CORE_HZ / MOCK_LPSPI_CLK_HZ)
+
+/** \brief Largest transfer recorded by the driver stand-ins, in bytes. */
+#define MOCK_LPSPI_MAX_SENT   64U
+
+/******************************************************************************/
+/*                   Definition of exported variables                         */
+/******************************************************************************/
+/** \brief Registers of LPSPI0 (only the TCR). */
+LPSPI_Type mock_lpspi0;
+
+/** \brief Virtual core clock, in cycles. */
+uint64_t mock_cycles = 0U;
+
+/** \brief SCK period, in core cycles (4 MHz, the SCK of HAL_SPI_Init()). */
+uint32_t mock_cyclesPerBit = 12U;
+
+/** \brief Set to stop the shifter, as a module stuck by a hardware fault. */
+bool mock_lpspiStalled = false;
+
+/** \brief Frames received with the RX FIFO full. */
+uint32_t mock_lpspiOverruns = 0U;
+
+/** \brief Status reported by LPSPI_DRV_MasterGetTransferStatus(). */
+status_t mock_lpspiStatus = STATUS_SUCCESS;
+
+/** \brief Result of the next LPSPI_DRV_MasterTransfer() that finds the driver idle. */
+status_t mock_lpspiStartStatus = STATUS_SUCCESS;
+
+/** \brief Number of transfers started through the driver. */
+uint32_t mock_lpspiTransfers = 0U;
+
+/** \brief Buffer and bytes of the last transfer started through the driver. */
+const uint8_t *mock_lpspiSendBuffer = NULL;
+uint8_t mock_lpspiSent[MOCK_LPSPI_MAX_SENT];
+uint16_t mock_lpspiSentLength = 0U;
+
+/******************************************************************************/
+/*                   Definition of local variables                            */
+/******************************************************************************/
+/** \brief TX FIFO: frames and the cycle at which each was written. */
+static uint32_t s_mockTxData[MOCK_LPSPI_FIFO_SIZE];
+static uint64_t s_mockTxTime[MOCK_LPSPI_FIFO_SIZE];
+static uint32_t s_mockTxHead = 0U;
+static uint32_t s_mockTxCount = 0U;
+
+/** \brief RX FIFO. */
+static uint32_t s_mockRxData[MOCK_LPSPI_FIFO_SIZE];
+static uint32_t s_mockRxHead = 0U;
+static uint32_t s_mockRxCount = 0U;
+
+/** \brief Shifter: frame in flight and the cycle at which its shift ends. */
+static bool s_mockShifting = false;
+static uint32_t s_mockShiftData = 0U;
+static uint64_t s_mockShiftEnd = 0U;
+
+/** \brief Frame size programmed in the TCR, in bits. */
+static uint32_t s_mockFrameBits = 8U;
+
+/** \brief Transfer complete callback registered with the driver. */
+static spi_callback_t s_mockCallback = NULL;
+static void *s_mockCallbackParam = NULL;
+
+/******************************************************************************/
+/*                   Definition of local functions                            */
+/******************************************************************************/
+
+/**
+ * \brief Moves the frames through the shifter up to the current cycle.
+ */
+static void mock_lpspiRun(void)
+{
+    uint64_t start;
+
+    for (;;)
+    {
+        if (s_mockShifting && ((s_mockShiftEnd + MOCK_LPSPI_LATENCY) <= mock_cycles))
+        {
+            if (s_mockRxCount < MOCK_LPSPI_FIFO_SIZE)
+            {
+                s_mockRxData[(s_mockRxHead + s_mockRxCount) % MOCK_LPSPI_FIFO_SIZE] = s_mockShiftData;
+                s_mockRxCount++;
+            }
+            else
+            {
+                mock_lpspiOverruns++;
+            }
+            s_mockShifting = false;
+        }
+        if (s_mockShifting || mock_lpspiStalled || (s_mockTxCount == 0U))
+        {
+            break;
+        }
+        start = s_mockTxTime[s_mockTxHead] + MOCK_LPSPI_LATENCY;
+        start = (start > s_mockShiftEnd) ? start : s_mockShiftEnd;
+        if (start > mock_cycles)
+        {
+            break;
+        }
+        s_mockShiftData = s_mockTxData[s_mockTxHead];
+        s_mockShiftEnd = start + ((uint64_t)s_mockFrameBits * mock_cyclesPerBit);
+        s_mockShifting = true;
+        s_mockTxHead = (s_mockTxHead + 1U) % MOCK_LPSPI_FIFO_SIZE;
+        s_mockTxCount--;
+    }
+}
+
+/**
+ * \brief Accounts for one register access.
+ */
+static void mock_access(void)
+{
+    mock_cycles += MOCK_ACCESS_CYCLES;
+    mock_lpspiRun();
+}
+
+/******************************************************************************/
+/*                   Definition of exported functions                         */
+/******************************************************************************/
+
+/**
+ * \brief Empties the FIFOs, stops the shifter and forgets the driver state.
+ */
+void mock_lpspiReset(void)
+{
+    memset(&mock_lpspi0, 0, sizeof(mock_lpspi0));
+    mock_lpspiStalled = false;
+    mock_lpspiOverruns = 0U;
+    mock_lpspiStatus = STATUS_SUCCESS;
+    mock_lpspiStartStatus = STATUS_SUCCESS;
+    mock_lpspiTransfers = 0U;
+    mock_lpspiSendBuffer = NULL;
+    mock_lpspiSentLength = 0U;
+    s_mockTxCount = 0U;
+    s_mockRxCount = 0U;
+    s_mockShifting = false;
+    s_mockShiftEnd = mock_cycles;
+}
+
+/**
+ * \brief Ends the transfer started through the driver, as its interrupt does.
+ *
+ * \param[in] success Result of the transfer.
+ */
+void mock_lpspiEndTransfer(bool success)
+{
+    mock_lpspiStatus = success ? STATUS_SUCCESS : STATUS_ERROR;
+    if (s_mockCallback != NULL)
+    {
+        s_mockCallback(NULL, SPI_EVENT_END_TRANSFER, s_mockCallbackParam);
+    }
+}
+
+/** \brief Timebase of HAL_tim.c, driven by the virtual core clock. */
+uint32_t HAL_TIM_GetTicks(void)
+{
+    mock_access();
+    return (uint32_t)(mock_cycles / (MOCK_CORE_HZ / MOCK_LPIT_HZ));
+}
+
+uint32_t HAL_TIM_GetTickHz(void)
+{
+    return MOCK_LPIT_HZ;
+}
+
+/* Stand-ins of the LPSPI driver, declared by the headers of this directory */
+
+status_t LPSPI_DRV_MasterInit(uint32_t instance, lpspi_state_t *lpspiState,
+                              const lpspi_master_config_t *spiConfig)
+{
+    (void)instance;
+    lpspiState->callback = spiConfig->callback;
+    lpspiState->callbackParam = spiConfig->callbackParam;
+    s_mockCallback = spiConfig->callback;
+    s_mockCallbackParam = spiConfig->callbackParam;
+    mock_lpspi0.TCR = LPSPI_TCR_CONT_MASK | (7U & LPSPI_TCR_FRAMESZ_MASK);
+    return STATUS_SUCCESS;
+}
+
+status_t LPSPI_DRV_MasterConfigureBus(uint32_t instance, const lpspi_master_config_t *spiConfig,
+                                      uint32_t *calculatedBaudRate)
+{
+    (void)instance;
+    *calculatedBaudRate = spiConfig->bitsPerSec;
+    return STATUS_SUCCESS;
+}
+
+status_t LPSPI_DRV_MasterTransfer(uint32_t instance, const uint8_t *sendBuffer,
+                                  uint8_t *receiveBuffer, uint16_t transferByteCount)
+{
+    (void)instance;
+    (void)receiveBuffer;
+    if (mock_lpspiStatus == STATUS_BUSY)
+    {
+        return STATUS_BUSY;
+    }
+    if (mock_lpspiStartStatus != STATUS_SUCCESS)
+    {
+        return mock_lpspiStartStatus;
+    }
+    mock_lpspiTransfers++;
+    mock_lpspiSendBuffer = sendBuffer;
+    mock_lpspiSentLength = (transferByteCount < MOCK_LPSPI_MAX_SENT) ? transferByteCount : MOCK_LPSPI_MAX_SENT;
+    memcpy(mock_lpspiSent, sendBuffer, mock_lpspiSentLength);
+    mock_lpspiStatus = STATUS_BUSY;
+    return STATUS_SUCCESS;
+}
+
+status_t LPSPI_DRV_MasterTransferBlocking(uint32_t instance, const uint8_t *sendBuffer,
+                                          uint8_t *receiveBuffer, uint16_t transferByteCount,
+                                          uint32_t timeout)
+{
+    (void)instance;
+    (void)receiveBuffer;
+    (void)timeout;
+    if (mock_lpspiStatus == STATUS_BUSY)
+    {
+        return STATUS_BUSY;
+    }
+    mock_lpspiTransfers++;
+    mock_lpspiSentLength = (transferByteCount < MOCK_LPSPI_MAX_SENT) ? transferByteCount : MOCK_LPSPI_MAX_SENT;
+    memcpy(mock_lpspiSent, sendBuffer, mock_lpspiSentLength);
+    mock_lpspiEndTransfer(true);
+    return STATUS_SUCCESS;
+}
+
+status_t LPSPI_DRV_MasterGetTransferStatus(uint32_t instance, uint32_t *bytesRemained)
+{
+    (void)instance;
+    (void)bytesRemained;
+    return mock_lpspiStatus;
+}
+
+void LPSPI_GetFifoSizes(const LPSPI_Type *base, uint8_t *fifoSize)
+{
+    (void)base;
+    *fifoSize = MOCK_LPSPI_FIFO_SIZE;
+}
+
+void LPSPI_SetFlushFifoCmd(LPSPI_Type *base, bool flushTxFifo, bool flushRxFifo)
+{
+    (void)base;
+    mock_access();
+    if (flushTxFifo)
+    {
+        s_mockTxCount = 0U;
+    }
+    if (flushRxFifo)
+    {
+        s_mockRxCount = 0U;
+    }
+}
+
+bool LPSPI_GetStatusFlag(const LPSPI_Type *base, lpspi_status_flag_t statusFlag)
+{
+    (void)base;
+    mock_access();
+    if (statusFlag == LPSPI_MODULE_BUSY)
+    {
+        return s_mockShifting || (s_mockTxCount != 0U);
+    }
+    return (statusFlag == LPSPI_RECEIVE_ERROR) && (mock_lpspiOverruns != 0U);
+}
+
+status_t LPSPI_ClearStatusFlag(LPSPI_Type *base, lpspi_status_flag_t statusFlag)
+{
+    (void)base;
+    (void)statusFlag;
+    mock_access();
+    return STATUS_SUCCESS;
+}
+
+void LPSPI_SetTxCommandReg(LPSPI_Type *base, const lpspi_tx_cmd_config_t *txCmdCfgSet)
+{
+    mock_access();
+    s_mockFrameBits = txCmdCfgSet->frameSize;
+    base->TCR = ((txCmdCfgSet->frameSize - 1U) & LPSPI_TCR_FRAMESZ_MASK) |
+                (txCmdCfgSet->contTransfer ? LPSPI_TCR_CONT_MASK : 0U) |
+                (txCmdCfgSet->byteSwap ? LPSPI_TCR_BYSW_MASK : 0U) |
+                ((txCmdCfgSet->preDiv << LPSPI_TCR_PRESCALE_SHIFT) & LPSPI_TCR_PRESCALE_MASK);
+}
+
+void LPSPI_WriteData(LPSPI_Type *base, uint32_t data)
+{
+    (void)base;
+    mock_access();
+    if (s_mockTxCount < MOCK_LPSPI_FIFO_SIZE)
+    {
+        s_mockTxData[(s_mockTxHead + s_mockTxCount) % MOCK_LPSPI_FIFO_SIZE] = data;
+        s_mockTxTime[(s_mockTxHead + s_mockTxCount) % MOCK_LPSPI_FIFO_SIZE] = mock_cycles;
+        s_mockTxCount++;
+    }
+}
+
+uint32_t LPSPI_ReadData(const LPSPI_Type *base)
+{
+    uint32_t data = 0U;
+
+    (void)base;
+    mock_access();
+    if (s_mockRxCount != 0U)
+    {
+        data = s_mockRxData[s_mockRxHead];
+        s_mockRxHead = (s_mockRxHead + 1U) % MOCK_LPSPI_FIFO_SIZE;
+        s_mockRxCount--;
+    }
+    return data;
+}
+
+uint32_t LPSPI_ReadTxCount(const LPSPI_Type *base)
+{
+    (void)base;
+    mock_access();
+    return s_mockTxCount;
+}
+
+uint32_t LPSPI_ReadRxCount(const LPSPI_Type *base)
+{
+    (void)base;
+    mock_access();
+    return s_mockRxCount;
+}
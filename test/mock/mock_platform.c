@@ -0,0 +1,190 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host stand-ins of the SDK platform services                              */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Clock manager, interrupt manager and eDMA driver calls shared by the HAL */
+/*   modules under test. The eDMA channel only counts its major loop: each    */
+/*   mock_edmaIteration() is one request served, and the end of the major     */
+/*   loop reloads the count and calls the channel callback, as the channels   */
+/*   of the HAL that are left running on completion do; so does the half of   */
+/*   the major loop, once its interrupt is enabled. The addresses given to    */
+/*   the channel are only recorded.                                           */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#include <stddef.h>
+#include "clock_manager.h"
+#include "interrupt_manager.h"
+#include "edma_driver.h"
+
+/******************************************************************************/
+/*                   Definition of exported variables                         */
+/******************************************************************************/
+/** \brief Major iteration count of the transfer started on the channel. */
+uint32_t mock_edmaMajorCount = 0U;
+
+/** \brief Major iterations left before the end of the major loop. */
+uint32_t mock_edmaRemaining = 0U;
+
+/** \brief Major loops completed since the transfer was started. */
+uint32_t mock_edmaMajorLoops = 0U;
+
+/** \brief true if the half major loop interrupt is enabled. */
+bool mock_edmaHalfInterrupt = false;
+
+/** \brief true once the channel has been started. */
+bool mock_edmaStarted = false;
+
+/** \brief Last addresses and offsets written to the channel. */
+uint32_t mock_edmaSrcAddr = 0U;
+int16_t mock_edmaSrcOffset = 0;
+int32_t mock_edmaSrcLastAdjust = 0;
+uint32_t mock_edmaDestAddr = 0U;
+int16_t mock_edmaDestOffset = 0;
+
+/** \brief Nesting of INT_SYS_DisableIRQGlobal(). */
+uint32_t mock_irqDisabled = 0U;
+
+/******************************************************************************/
+/*                   Definition of local variables                            */
+/******************************************************************************/
+/** \brief State of the channel, holding its callback. */
+static edma_chn_state_t *s_mockEdmaState = NULL;
+
+/******************************************************************************/
+/*                   Definition of exported functions                         */
+/******************************************************************************/
+
+/** \brief Starts a transfer of majorCount iterations on the channel. */
+void mock_edmaStart(uint32_t majorCount)
+{
+    mock_edmaMajorCount = majorCount;
+    mock_edmaRemaining = majorCount;
+    mock_edmaMajorLoops = 0U;
+}
+
+/** \brief Serves one request: one major iteration of the channel. */
+void mock_edmaIteration(void)
+{
+    if (mock_edmaRemaining > 0U)
+    {
+        mock_edmaRemaining--;
+    }
+    if (mock_edmaHalfInterrupt && (mock_edmaRemaining != 0U) &&
+        (mock_edmaRemaining == (mock_edmaMajorCount / 2U)))
+    {
+        if ((s_mockEdmaState != NULL) && (s_mockEdmaState->callback != NULL))
+        {
+            s_mockEdmaState->callback(s_mockEdmaState->parameter, EDMA_CHN_NORMAL);
+        }
+    }
+    if (mock_edmaRemaining == 0U)
+    {
+        mock_edmaRemaining = mock_edmaMajorCount;
+        mock_edmaMajorLoops++;
+        if ((s_mockEdmaState != NULL) && (s_mockEdmaState->callback != NULL))
+        {
+            s_mockEdmaState->callback(s_mockEdmaState->parameter, EDMA_CHN_NORMAL);
+        }
+    }
+}
+
+/* Stand-ins of the SDK functions, declared by the headers of this directory */
+
+status_t CLOCK_SYS_GetFreq(clock_names_t clockName, uint32_t *frequency)
+{
+    static const uint32_t frequencies[] = { MOCK_CORE_HZ, MOCK_LPSPI_CLK_HZ, MOCK_LPIT_HZ,
+                                            MOCK_LPI2C_CLK_HZ, MOCK_BUS_HZ };
+
+    *frequency = frequencies[clockName];
+    return STATUS_SUCCESS;
+}
+
+void INT_SYS_EnableIRQGlobal(void)
+{
+    mock_irqDisabled--;
+}
+
+void INT_SYS_DisableIRQGlobal(void)
+{
+    mock_irqDisabled++;
+}
+
+status_t EDMA_DRV_ChannelInit(edma_chn_state_t *edmaChannelState,
+                              const edma_channel_config_t *edmaChannelConfig)
+{
+    edmaChannelState->virtChn = edmaChannelConfig->virtChnConfig;
+    edmaChannelState->callback = edmaChannelConfig->callback;
+    edmaChannelState->parameter = edmaChannelConfig->callbackParam;
+    s_mockEdmaState = edmaChannelState;
+    return STATUS_SUCCESS;
+}
+
+void EDMA_DRV_SetSrcAddr(uint8_t virtualChannel, uint32_t address)
+{
+    (void)virtualChannel;
+    mock_edmaSrcAddr = address;
+}
+
+void EDMA_DRV_SetSrcOffset(uint8_t virtualChannel, int16_t offset)
+{
+    (void)virtualChannel;
+    mock_edmaSrcOffset = offset;
+}
+
+void EDMA_DRV_SetSrcLastAddrAdjustment(uint8_t virtualChannel, int32_t adjust)
+{
+    (void)virtualChannel;
+    mock_edmaSrcLastAdjust = adjust;
+}
+
+void EDMA_DRV_SetDestAddr(uint8_t virtualChannel, uint32_t address)
+{
+    (void)virtualChannel;
+    mock_edmaDestAddr = address;
+}
+
+void EDMA_DRV_SetDestOffset(uint8_t virtualChannel, int16_t offset)
+{
+    (void)virtualChannel;
+    mock_edmaDestOffset = offset;
+}
+
+uint32_t EDMA_DRV_GetRemainingMajorIterationsCount(uint8_t virtualChannel)
+{
+    (void)virtualChannel;
+    return mock_edmaRemaining;
+}
+
+status_t EDMA_DRV_ConfigLoopTransfer(uint8_t virtualChannel, const edma_transfer_config_t *transferConfig)
+{
+    (void)virtualChannel;
+    mock_edmaSrcAddr = transferConfig->srcAddr;
+    mock_edmaSrcOffset = transferConfig->srcOffset;
+    mock_edmaSrcLastAdjust = transferConfig->srcLastAddrAdjust;
+    mock_edmaDestAddr = transferConfig->destAddr;
+    mock_edmaDestOffset = transferConfig->destOffset;
+    mock_edmaStart(transferConfig->loopTransferConfig->majorLoopIterationCount);
+    return STATUS_SUCCESS;
+}
+
+void EDMA_DRV_ConfigureInterrupt(uint8_t virtualChannel, edma_channel_interrupt_t intSrc, bool enable)
+{
+    (void)virtualChannel;
+    if (intSrc == EDMA_CHN_HALF_MAJOR_LOOP_INT)
+    {
+        mock_edmaHalfInterrupt = enable;
+    }
+}
+
+status_t EDMA_DRV_StartChannel(uint8_t virtualChannel)
+{
+    (void)virtualChannel;
+    mock_edmaStarted = true;
+    return STATUS_SUCCESS;
+}
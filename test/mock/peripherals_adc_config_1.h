@@ -0,0 +1,25 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host stand-in of the ADC configuration                                   */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Converter configuration of the board, defined by mock_adc.c. It is not   */
+/*   const, so a test can select another resolution.                          */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef MOCK_PERIPHERALS_ADC_CONFIG_1_H_
+#define MOCK_PERIPHERALS_ADC_CONFIG_1_H_
+
+#include "adc_driver.h"
+
+/******************************************************************************/
+/*                Declaration of exported variables                           */
+/******************************************************************************/
+extern adc_converter_config_t adc_config_1_ConvConfig0;
+
+#endif /* MOCK_PERIPHERALS_ADC_CONFIG_1_H_ */
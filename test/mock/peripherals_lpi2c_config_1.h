@@ -0,0 +1,24 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host stand-in of the LPI2C configuration                                 */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Slave configuration of the board, defined by mock_lpi2c.c.               */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef MOCK_PERIPHERALS_LPI2C_CONFIG_1_H_
+#define MOCK_PERIPHERALS_LPI2C_CONFIG_1_H_
+
+#include "lpi2c_driver.h"
+
+/******************************************************************************/
+/*                Declaration of exported variables                           */
+/******************************************************************************/
+extern lpi2c_slave_user_config_t lpi2c0_SlaveConfig0;
+
+#endif /* MOCK_PERIPHERALS_LPI2C_CONFIG_1_H_ */
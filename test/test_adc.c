@@ -0,0 +1,314 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host test of the ADC scan threshold alarms                               */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Runs the DMA scan of HAL_adc.c against the stand-ins of the ADC driver   */
+/*   and of the eDMA channel (mock/mock_adc.c, mock/mock_platform.c). Each    */
+/*   conversion samples the simulated inputs into the ADC result register of  */
+/*   its control channel, and the test moves the result into the scan ring as */
+/*   eDMA would. Checks the trip condition of every alarm mode at its         */
+/*   thresholds, the half of the ring checked by each eDMA interrupt, and the */
+/*   alarm latency, at most half a ring of conversions.                       */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+/* The module is included to reach its scan ring and alarm checks */
+#include "../src/HAL/ADC/HAL_adc.c"
+#include "mock/mock_platform.c"
+#include "mock/mock_adc.c"
+#include "test_common.h"
+
+/******************************************************************************/
+/*                   Definition of local symbolic constants                 */
+/******************************************************************************/
+/** \brief Input code inside every alarm window used by the tests. */
+#define TEST_NORMAL  2000U
+
+/** \brief Thresholds used by the tests, in codes. */
+#define TEST_LOW     1000U
+#define TEST_HIGH    3000U
+
+/******************************************************************************/
+/*                   Definition of local variables                            */
+/******************************************************************************/
+/** \brief Conversions done since the scan was started. */
+static uint32_t s_conversions = 0U;
+
+/** \brief Calls of the alarm callback, last mask and conversion count then. */
+static uint32_t s_alarms = 0U;
+static uint8_t s_alarmMask = 0U;
+static uint32_t s_alarmConversion = 0U;
+
+/******************************************************************************/
+/*                   Definition of local functions                            */
+/******************************************************************************/
+
+/** \brief Alarm callback: records the mask and when it was called. */
+static void test_alarm(uint8_t channelMask)
+{
+    s_alarms++;
+    s_alarmMask = channelMask;
+    s_alarmConversion = s_conversions;
+}
+
+/**
+ * \brief Resets the stand-ins and starts the scan at the default rate, with
+ *        both inputs at TEST_NORMAL and the alarms off.
+ */
+static void test_reset(void)
+{
+    uint8_t channel;
+
+    mock_adcReset();
+    mock_edmaHalfInterrupt = false;
+    HAL_ADC_Init();
+    for (channel = 0U; channel < HAL_ADC_NUM_CHANNELS; channel++)
+    {
+        HAL_ADC_SetAlarm(channel, HAL_ADC_ALARM_OFF, 0U, 0U);
+        mock_adcInput[channel] = TEST_NORMAL;
+    }
+    HAL_ADC_SetAlarmCallback(test_alarm);
+    HAL_ADC_StartScan(HAL_ADC_SCAN_RATE_HZ);
+    s_conversions = 0U;
+    s_alarms = 0U;
+    s_alarmMask = 0U;
+    s_alarmConversion = 0U;
+}
+
+/**
+ * \brief One conversion of the scan: the PDB pre-trigger of the next control
+ *        channel converts it, eDMA moves its result register into the ring.
+ */
+static void test_convert(void)
+{
+    uint32_t next = ADC_SCAN_BUFFER_LEN - mock_edmaRemaining;
+    uint8_t chanIndex = (uint8_t)(next % HAL_ADC_NUM_CHANNELS);
+
+    mock_adcConvert(chanIndex);
+    s_scanBuffer[next] = (uint16_t)mock_adc0.R[chanIndex];
+    s_conversions++;
+    mock_edmaIteration();
+}
+
+/**
+ * \brief Trip condition of each mode at and around its thresholds.
+ */
+static void test_tripped(void)
+{
+    adc_channel_alarm_t alarm = { HAL_ADC_ALARM_OFF, TEST_LOW, TEST_HIGH };
+
+    TEST_CHECK(!HAL_ADC_AlarmTripped(&alarm, 0U));
+    TEST_CHECK(!HAL_ADC_AlarmTripped(&alarm, 4095U));
+
+    alarm.mode = HAL_ADC_ALARM_HIGH;
+    TEST_CHECK(!HAL_ADC_AlarmTripped(&alarm, 0U));
+    TEST_CHECK(!HAL_ADC_AlarmTripped(&alarm, TEST_HIGH));
+    TEST_CHECK(HAL_ADC_AlarmTripped(&alarm, TEST_HIGH + 1U));
+    TEST_CHECK(HAL_ADC_AlarmTripped(&alarm, 4095U));
+
+    alarm.mode = HAL_ADC_ALARM_LOW;
+    TEST_CHECK(HAL_ADC_AlarmTripped(&alarm, 0U));
+    TEST_CHECK(HAL_ADC_AlarmTripped(&alarm, TEST_LOW - 1U));
+    TEST_CHECK(!HAL_ADC_AlarmTripped(&alarm, TEST_LOW));
+    TEST_CHECK(!HAL_ADC_AlarmTripped(&alarm, 4095U));
+
+    alarm.mode = HAL_ADC_ALARM_WINDOW;
+    TEST_CHECK(HAL_ADC_AlarmTripped(&alarm, TEST_LOW - 1U));
+    TEST_CHECK(!HAL_ADC_AlarmTripped(&alarm, TEST_LOW));
+    TEST_CHECK(!HAL_ADC_AlarmTripped(&alarm, TEST_NORMAL));
+    TEST_CHECK(!HAL_ADC_AlarmTripped(&alarm, TEST_HIGH));
+    TEST_CHECK(HAL_ADC_AlarmTripped(&alarm, TEST_HIGH + 1U));
+
+    /* An empty window trips on every sample */
+    alarm.low = TEST_HIGH;
+    alarm.high = TEST_LOW;
+    TEST_CHECK(HAL_ADC_AlarmTripped(&alarm, TEST_NORMAL));
+
+    /* HAL_ADC_SetAlarm() turns invalid modes and channels into no alarm */
+    test_reset();
+    HAL_ADC_SetAlarm(0U, (HAL_ADC_AlarmMode_t)7, TEST_LOW, TEST_HIGH);
+    TEST_CHECK_EQ(s_alarm[0].mode, HAL_ADC_ALARM_OFF);
+    TEST_CHECK_EQ(s_alarm[0].low, TEST_LOW);
+    HAL_ADC_SetAlarm(HAL_ADC_NUM_CHANNELS, HAL_ADC_ALARM_HIGH, TEST_LOW, TEST_HIGH);
+    TEST_CHECK_EQ(s_alarm[1].mode, HAL_ADC_ALARM_OFF);
+}
+
+/**
+ * \brief The scan programs a looping channel with the half interrupt and
+ *        leaves the ADC compare unit off.
+ */
+static void test_scanSetup(void)
+{
+    test_reset();
+    TEST_CHECK(mock_edmaStarted);
+    TEST_CHECK(mock_edmaHalfInterrupt);
+    TEST_CHECK_EQ(mock_edmaMajorCount, ADC_SCAN_BUFFER_LEN);
+    TEST_CHECK_EQ(mock_adc0.SC1[0], 0U);
+    TEST_CHECK_EQ(mock_adc0.SC1[1], 1U);
+    TEST_CHECK(mock_adcConverter.dmaEnable);
+    TEST_CHECK_EQ(mock_adcConverter.trigger, ADC_TRIGGER_HARDWARE);
+    TEST_CHECK_EQ(mock_adc0.SC2 & ADC_SC2_ACFE_MASK, 0U);
+}
+
+/**
+ * \brief Each interrupt checks the half eDMA has just filled: the half
+ *        interrupt the first half, the complete interrupt the second one.
+ */
+static void test_halves(void)
+{
+    uint32_t i;
+
+    test_reset();
+    HAL_ADC_SetAlarm(0U, HAL_ADC_ALARM_HIGH, TEST_LOW, TEST_HIGH);
+
+    /* Out-of-range sample in the first half only */
+    for (i = 0U; i < ADC_SCAN_BUFFER_LEN; i++)
+    {
+        mock_adcInput[0] = (i == 4U) ? (TEST_HIGH + 1U) : TEST_NORMAL;
+        test_convert();
+        if (i == (ADC_SCAN_HALF_LEN - 1U))
+        {
+            TEST_CHECK_EQ(s_alarms, 1U);
+        }
+    }
+    TEST_CHECK_EQ(s_alarms, 1U);
+    TEST_CHECK_EQ(s_alarmMask, 0x1U);
+    TEST_CHECK_EQ(s_alarmConversion, ADC_SCAN_HALF_LEN);
+
+    /* Out-of-range sample in the second half only: the stale first half of
+     * the previous pass has been overwritten by then */
+    for (i = 0U; i < ADC_SCAN_BUFFER_LEN; i++)
+    {
+        mock_adcInput[0] = (i == (ADC_SCAN_HALF_LEN + 2U)) ? (TEST_HIGH + 1U) : TEST_NORMAL;
+        test_convert();
+        if (i == (ADC_SCAN_HALF_LEN - 1U))
+        {
+            TEST_CHECK_EQ(s_alarms, 1U);
+        }
+    }
+    TEST_CHECK_EQ(s_alarms, 2U);
+    TEST_CHECK_EQ(s_alarmConversion, 2U * ADC_SCAN_BUFFER_LEN);
+
+    /* A clean pass raises nothing */
+    for (i = 0U; i < ADC_SCAN_BUFFER_LEN; i++)
+    {
+        test_convert();
+    }
+    TEST_CHECK_EQ(s_alarms, 2U);
+}
+
+/**
+ * \brief For every mode and every ring entry, a sample out of range is
+ *        reported once, for its own channel, within half a ring of
+ *        conversions; one in range is not reported.
+ */
+static void test_latency(void)
+{
+    static const uint16_t levels[] = { TEST_LOW - 1U, TEST_LOW, TEST_HIGH, TEST_HIGH + 1U };
+    HAL_ADC_AlarmMode_t mode;
+    adc_channel_alarm_t alarm;
+    uint32_t position;
+    uint32_t level;
+    uint32_t i;
+    uint32_t worst = 0U;
+    uint8_t channel;
+    bool trips;
+
+    for (mode = HAL_ADC_ALARM_OFF; mode <= HAL_ADC_ALARM_WINDOW; mode++)
+    {
+        alarm.mode = mode;
+        alarm.low = TEST_LOW;
+        alarm.high = TEST_HIGH;
+        for (level = 0U; level < (sizeof(levels) / sizeof(levels[0])); level++)
+        {
+            trips = HAL_ADC_AlarmTripped(&alarm, levels[level]);
+            for (position = 0U; position < ADC_SCAN_BUFFER_LEN; position++)
+            {
+                channel = (uint8_t)(position % HAL_ADC_NUM_CHANNELS);
+                test_reset();
+                HAL_ADC_SetAlarm(0U, mode, TEST_LOW, TEST_HIGH);
+                HAL_ADC_SetAlarm(1U, mode, TEST_LOW, TEST_HIGH);
+                for (i = 0U; i < (2U * ADC_SCAN_BUFFER_LEN); i++)
+                {
+                    mock_adcInput[channel] = (i == position) ? levels[level] : TEST_NORMAL;
+                    test_convert();
+                }
+                TEST_CHECK_EQ(s_alarms, trips ? 1U : 0U);
+                if (trips)
+                {
+                    TEST_CHECK_EQ(s_alarmMask, 1U << channel);
+                    TEST_CHECK(s_alarmConversion > position);
+                    TEST_CHECK((s_alarmConversion - position) <= ADC_SCAN_HALF_LEN);
+                    if ((s_alarmConversion - position) > worst)
+                    {
+                        worst = s_alarmConversion - position;
+                    }
+                }
+            }
+        }
+    }
+    /* The last entry of a half is reported at once, the first one last */
+    TEST_CHECK_EQ(worst, ADC_SCAN_HALF_LEN);
+    printf("worst alarm latency: %u conversions, %.1f ms at %u Hz\n", worst,
+           (1000.0 * worst) / (HAL_ADC_NUM_CHANNELS * HAL_ADC_SCAN_RATE_HZ), HAL_ADC_SCAN_RATE_HZ);
+}
+
+/**
+ * \brief Both channels tripping in the same half give one call with both bits;
+ *        error interrupts and a missing callback give none.
+ */
+static void test_mask(void)
+{
+    uint32_t i;
+
+    test_reset();
+    HAL_ADC_SetAlarm(0U, HAL_ADC_ALARM_HIGH, TEST_LOW, TEST_HIGH);
+    HAL_ADC_SetAlarm(1U, HAL_ADC_ALARM_LOW, TEST_LOW, TEST_HIGH);
+    mock_adcInput[0] = TEST_HIGH + 1U;
+    mock_adcInput[1] = TEST_LOW - 1U;
+    for (i = 0U; i < ADC_SCAN_HALF_LEN; i++)
+    {
+        test_convert();
+    }
+    TEST_CHECK_EQ(s_alarms, 1U);
+    TEST_CHECK_EQ(s_alarmMask, 0x3U);
+
+    /* Each channel is held to its own mode */
+    mock_adcInput[0] = TEST_LOW - 1U;
+    mock_adcInput[1] = TEST_HIGH + 1U;
+    for (i = 0U; i < ADC_SCAN_HALF_LEN; i++)
+    {
+        test_convert();
+    }
+    TEST_CHECK_EQ(s_alarms, 1U);
+
+    mock_adcInput[0] = TEST_HIGH + 1U;
+    HAL_ADC_ScanDmaCallback(NULL, EDMA_CHN_ERROR);
+    TEST_CHECK_EQ(s_alarms, 1U);
+    HAL_ADC_SetAlarmCallback(NULL);
+    for (i = 0U; i < ADC_SCAN_BUFFER_LEN; i++)
+    {
+        test_convert();
+    }
+    TEST_CHECK_EQ(s_alarms, 1U);
+}
+
+/******************************************************************************/
+/*                   Definition of exported functions                         */
+/******************************************************************************/
+
+int main(void)
+{
+    test_tripped();
+    test_scanSetup();
+    test_halves();
+    test_latency();
+    test_mask();
+
+    return TEST_RESULT("test_adc");
+}
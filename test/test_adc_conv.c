@@ -0,0 +1,207 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host test of the ADC millivolt conversion kernel                         */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Compares the fixed-point conversion of HAL_adc_conv.h against a          */
+/*   double-precision reference for every code of 12-, 13- and 14-bit         */
+/*   samples, with several gain and offset trims, and checks the saturation   */
+/*   of results past 65535 mV. HAL_adc.c is built against the stand-ins of    */
+/*   mock/ to check the full scale of each converter resolution and the       */
+/*   conversion of 8-, 10- and 12-bit samples through it.                     */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#include <math.h>
+#include <stdint.h>
+/* The module is included to reach its conversion factors */
+#include "../src/HAL/ADC/HAL_adc.c"
+#include "mock/mock_platform.c"
+#include "mock/mock_adc.c"
+#include "test_common.h"
+
+/******************************************************************************/
+/*                   Definition of local symbolic constants                 */
+/******************************************************************************/
+/** \brief ADC reference voltage of the board, in millivolts (HAL_adc.c). */
+#define TEST_VREF_MV        3300U
+
+/** \brief Full-scale code at the native resolution (HAL_adc.c). */
+#define TEST_FULL_SCALE     4095U
+
+/** \brief Divider ratio of the board inputs, 15/100 (HAL_adc.c). */
+#define TEST_DIVIDER_NUM    15U
+#define TEST_DIVIDER_DEN    100U
+
+/******************************************************************************/
+/*                   Definition of local functions                            */
+/******************************************************************************/
+
+/**
+ * \brief Checks the kernel against the double-precision reference.
+ *
+ * \details The error is bounded by the rounding of the result (0.5 mV) plus
+ *          the rounding of the Q16 factor (0.5 / 65536 mV per native code).
+ *
+ * \param[in] gainQ16 Gain correction, Q16.
+ * \param[in] offset  Offset, in native codes.
+ *
+ * \return The largest error found, in millivolts.
+ */
+static double test_sweep(uint32_t gainQ16, int32_t offset)
+{
+    uint32_t scaleQ16 = HAL_ADC_ComputeScaleQ16(gainQ16, TEST_DIVIDER_NUM, TEST_DIVIDER_DEN,
+                                                TEST_VREF_MV, TEST_FULL_SCALE);
+    double mvPerCode = ((double)gainQ16 / 65536.0) * TEST_VREF_MV * TEST_DIVIDER_DEN /
+                       ((double)TEST_FULL_SCALE * TEST_DIVIDER_NUM);
+    double tolerance = 0.5 + ((TEST_FULL_SCALE + 1.0) * 0.5 / 65536.0);
+    double worst = 0.0;
+    double code;
+    double expected;
+    double error;
+    uint8_t sampleBits;
+    uint8_t extra;
+    uint32_t adcValue;
+    uint16_t millivolts;
+
+    /* The factor itself is the rounded exact ratio */
+    TEST_CHECK(fabs((double)scaleQ16 - (mvPerCode * 65536.0)) <= 0.5);
+
+    for (sampleBits = HAL_ADC_NATIVE_BITS;
+         sampleBits <= (HAL_ADC_NATIVE_BITS + HAL_ADC_OVERSAMPLE_EXTRA_BITS); sampleBits++)
+    {
+        extra = HAL_ADC_ExtraBits(sampleBits);
+        for (adcValue = 0U; adcValue < (1UL << sampleBits); adcValue++)
+        {
+            code = ((double)adcValue / (double)(1UL << extra)) - offset;
+            expected = (code > 0.0) ? (code * mvPerCode) : 0.0;
+            if (expected > 65535.0)
+            {
+                expected = 65535.0;
+            }
+            millivolts = HAL_ADC_ScaleToMillivolts((uint16_t)adcValue, offset, scaleQ16, extra);
+            error = fabs((double)millivolts - expected);
+            if (error > worst)
+            {
+                worst = error;
+            }
+            if (error > tolerance)
+            {
+                TEST_CHECK(error <= tolerance);
+                printf("  %u-bit code %u: %u mV, expected %.3f mV\n",
+                       sampleBits, adcValue, millivolts, expected);
+            }
+        }
+    }
+    return worst;
+}
+
+/**
+ * \brief Converts every code of a converter resolution through HAL_adc.c.
+ *
+ * \details HAL_ADC_Init() takes the resolution of the board configuration and
+ *          folds its full scale into the conversion factors, so a code is
+ *          converted with the full scale returned by HAL_ADC_GetFullScale().
+ *          A converted input reads the same voltage at every resolution, to
+ *          the quantization step of the resolution.
+ *
+ * \param[in] resolution Converter resolution.
+ * \param[in] fullScale  Full-scale code expected for it.
+ */
+static void test_resolution(adc_resolution_t resolution, uint16_t fullScale)
+{
+    double mvPerCode = ((double)TEST_VREF_MV * TEST_DIVIDER_DEN) / ((double)fullScale * TEST_DIVIDER_NUM);
+    double tolerance = 0.5 + ((fullScale + 1.0) * 0.5 / 65536.0);
+    double error;
+    uint32_t code;
+    uint16_t millivolts;
+    uint8_t channel;
+
+    mock_adcReset();
+    adc_config_1_ConvConfig0.resolution = resolution;
+    HAL_ADC_Init();
+    TEST_CHECK_EQ(mock_adcConverter.resolution, resolution);
+    TEST_CHECK_EQ(HAL_ADC_GetFullScale(), fullScale);
+
+    for (channel = 0U; channel < HAL_ADC_NUM_CHANNELS; channel++)
+    {
+        for (code = 0U; code <= fullScale; code++)
+        {
+            millivolts = HAL_ADC_ConvertToMillivolts(channel, (uint16_t)code, HAL_ADC_GetSampleBits());
+            error = fabs((double)millivolts - (code * mvPerCode));
+            if (error > tolerance)
+            {
+                TEST_CHECK(error <= tolerance);
+                printf("  %u-bit full scale, code %u: %u mV, expected %.3f mV\n",
+                       fullScale, code, millivolts, code * mvPerCode);
+            }
+        }
+        TEST_CHECK_EQ(HAL_ADC_ConvertToMillivolts(channel, fullScale, HAL_ADC_GetSampleBits()), 22000U);
+    }
+
+    /* End to end: a 12-bit input read back at this resolution */
+    mock_adcInput[0] = 2048U;
+    code = HAL_ADC_ReadChannel(0U);
+    TEST_CHECK_EQ(code, (2048U * (fullScale + 1U)) / 4096U);
+    millivolts = HAL_ADC_ConvertToMillivolts(0U, (uint16_t)code, HAL_ADC_GetSampleBits());
+    TEST_CHECK(fabs((double)millivolts - (2048.0 * 22000.0 / 4095.0)) <= (mvPerCode + 1.0));
+}
+
+/******************************************************************************/
+/*                   Definition of exported functions                         */
+/******************************************************************************/
+
+int main(void)
+{
+    static const uint32_t gains[] = { 62259U, 65536U, 68813U };  /* 0.95, 1.0, 1.05 */
+    static const int32_t offsets[] = { 0, 7, -5 };
+    uint32_t scaleQ16 = HAL_ADC_ComputeScaleQ16(65536U, TEST_DIVIDER_NUM, TEST_DIVIDER_DEN,
+                                                TEST_VREF_MV, TEST_FULL_SCALE);
+    double worst = 0.0;
+    double error;
+    uint32_t g;
+    uint32_t o;
+
+    for (g = 0U; g < (sizeof(gains) / sizeof(gains[0])); g++)
+    {
+        for (o = 0U; o < (sizeof(offsets) / sizeof(offsets[0])); o++)
+        {
+            error = test_sweep(gains[g], offsets[o]);
+            worst = (error > worst) ? error : worst;
+        }
+    }
+    printf("largest error against the reference: %.3f mV\n", worst);
+
+    /* Extra bits follow the sample resolution and are capped */
+    TEST_CHECK_EQ(HAL_ADC_ExtraBits(8U), 0U);
+    TEST_CHECK_EQ(HAL_ADC_ExtraBits(12U), 0U);
+    TEST_CHECK_EQ(HAL_ADC_ExtraBits(13U), 1U);
+    TEST_CHECK_EQ(HAL_ADC_ExtraBits(14U), 2U);
+    TEST_CHECK_EQ(HAL_ADC_ExtraBits(16U), HAL_ADC_OVERSAMPLE_EXTRA_BITS);
+
+    /* Full scale is 3.3 V / (15/100) = 22 V, also for 14-bit samples whose
+     * product with the factor exceeds 32 bits */
+    TEST_CHECK_EQ(HAL_ADC_ScaleToMillivolts(4095U, 0, scaleQ16, 0U), 22000U);
+    TEST_CHECK((16383ULL * scaleQ16) > 0xFFFFFFFFULL);
+    TEST_CHECK_EQ(HAL_ADC_ScaleToMillivolts(16383U, 0, scaleQ16, 2U), 22004U);
+    TEST_CHECK_EQ(HAL_ADC_ScaleToMillivolts(16380U, 0, scaleQ16, 2U), 22000U);
+
+    /* Results past 16 bits saturate instead of wrapping */
+    TEST_CHECK_EQ(HAL_ADC_ScaleToMillivolts(16383U, 0, 0xFFFFFFFFU, 2U), 0xFFFFU);
+    TEST_CHECK_EQ(HAL_ADC_ScaleToMillivolts(4095U, 0, 0xFFFFFFFFU, 0U), 0xFFFFU);
+
+    /* Codes below the offset clamp at 0 */
+    TEST_CHECK_EQ(HAL_ADC_ScaleToMillivolts(3U, 4, scaleQ16, 0U), 0U);
+    TEST_CHECK_EQ(HAL_ADC_ScaleToMillivolts(15U, 4, scaleQ16, 2U), 0U);
+
+    /* Full scale and conversion at each converter resolution */
+    test_resolution(ADC_RESOLUTION_8BIT, 255U);
+    test_resolution(ADC_RESOLUTION_10BIT, 1023U);
+    test_resolution(ADC_RESOLUTION_12BIT, 4095U);
+
+    return TEST_RESULT("test_adc_conv");
+}
@@ -0,0 +1,59 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host test helpers                                                        */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Minimal check macros shared by the host tests. Every failed check is     */
+/*   printed with its location; TEST_RESULT() turns the tally into the exit   */
+/*   status of the test program.                                              */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef TEST_TEST_COMMON_H_
+#define TEST_TEST_COMMON_H_
+
+#include <stdio.h>
+
+/** \brief Number of checks evaluated by the test program. */
+static unsigned int s_testChecks = 0U;
+
+/** \brief Number of checks that failed. */
+static unsigned int s_testFailures = 0U;
+
+/** \brief Checks a condition. */
+#define TEST_CHECK(cond)                                                        \
+    do                                                                          \
+    {                                                                           \
+        s_testChecks++;                                                         \
+        if (!(cond))                                                            \
+        {                                                                       \
+            s_testFailures++;                                                   \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);     \
+        }                                                                       \
+    } while (0)
+
+/** \brief Checks that two integer values are equal, printing both if not. */
+#define TEST_CHECK_EQ(actual, expected)                                         \
+    do                                                                          \
+    {                                                                           \
+        long long actualValue = (long long)(actual);                            \
+        long long expectedValue = (long long)(expected);                        \
+        s_testChecks++;                                                         \
+        if (actualValue != expectedValue)                                       \
+        {                                                                       \
+            s_testFailures++;                                                   \
+            printf("%s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__,    \
+                   #actual, actualValue, expectedValue);                        \
+        }                                                                       \
+    } while (0)
+
+/** \brief Prints the tally and returns the exit status of the test program. */
+#define TEST_RESULT(name)                                                       \
+    (printf("%s: %u checks, %u failed\n", (name), s_testChecks, s_testFailures), \
+     (s_testFailures == 0U) ? 0 : 1)
+
+#endif /* TEST_TEST_COMMON_H_ */
@@ -0,0 +1,270 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host test of the DWT cycle statistics                                    */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Builds HAL_dwt.c with its DWT registers replaced by variables, so the    */
+/*   test sets the cycle counter, and with its compiler barrier replaced by a */
+/*   hook that can record a stage where an interrupt could. Checks the        */
+/*   counter enable, the histogram bin edges, the minimum, maximum and mean,  */
+/*   the saturation of the histogram and the retry of HAL_DWT_GetStats()      */
+/*   when a record interleaves with its copy.                                 */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/******************************************************************************/
+/*                   Definition of local symbolic constants                 */
+/******************************************************************************/
+/** \brief Stage the injected records go to. */
+#define TEST_STAGE  HAL_DWT_STAGE_I2C_ISR
+
+/******************************************************************************/
+/*                   Definition of local variables                            */
+/******************************************************************************/
+/** \brief DWT registers of the host build. */
+static volatile uint32_t s_dwtDemcr = 0U;
+static volatile uint32_t s_dwtCtrl = 0U;
+static volatile uint32_t s_dwtCyccnt = 0U;
+
+/** \brief Number of barriers passed. */
+static uint32_t s_barriers = 0U;
+
+/** \brief Records still to inject from the barrier hook. */
+static uint32_t s_injections = 0U;
+
+/** \brief Duration recorded by each injection. */
+static uint32_t s_injectedCycles = 0U;
+
+/** \brief Set while an injected record runs. */
+static bool s_inInjection = false;
+
+static void test_barrier(void);
+
+#define DWT_DEMCR               s_dwtDemcr
+#define DWT_CTRL                s_dwtCtrl
+#define DWT_CYCCNT              s_dwtCyccnt
+#define DWT_COMPILER_BARRIER()  test_barrier()
+
+/* The module is included to reach its histogram bins */
+#include "../src/HAL/DWT/HAL_dwt.c"
+#include "test_common.h"
+
+/******************************************************************************/
+/*                   Definition of local functions                            */
+/******************************************************************************/
+
+/**
+ * \brief Compiler barrier of the host build.
+ *
+ * \details While injections are pending, records a duration of TEST_STAGE at
+ *          the barrier, as an interrupt preempting the code there would.
+ */
+static void test_barrier(void)
+{
+    __asm volatile ("" ::: "memory");
+    s_barriers++;
+    if ((s_injections != 0U) && !s_inInjection)
+    {
+        s_injections--;
+        s_inInjection = true;
+        HAL_DWT_Record(TEST_STAGE, s_injectedCycles);
+        s_inInjection = false;
+    }
+}
+
+/**
+ * \brief Returns the sum of the histogram bins of a copy.
+ */
+static uint32_t test_histogramSum(const HAL_DWT_Stats_t *stats)
+{
+    uint32_t sum = 0U;
+    uint8_t bin;
+
+    for (bin = 0U; bin < HAL_DWT_HIST_BINS; bin++)
+    {
+        sum += stats->histogram[bin];
+    }
+    return sum;
+}
+
+/**
+ * \brief Init enables the counter; the cycles and the instrumentation
+ *        macros read it, across its wrap-around.
+ */
+static void test_counter(void)
+{
+    HAL_DWT_Stats_t stats;
+
+    s_dwtDemcr = 0U;
+    s_dwtCtrl = 0U;
+    s_dwtCyccnt = 12345U;
+    HAL_DWT_Init();
+    TEST_CHECK_EQ(s_dwtDemcr & DWT_DEMCR_TRCENA_MASK, DWT_DEMCR_TRCENA_MASK);
+    TEST_CHECK_EQ(s_dwtCtrl & DWT_CTRL_CYCCNTENA_MASK, DWT_CTRL_CYCCNTENA_MASK);
+    TEST_CHECK_EQ(s_dwtCyccnt, 0U);
+
+    s_dwtCyccnt = 0xDEADBEEFU;
+    TEST_CHECK_EQ(HAL_DWT_GetCycles(), 0xDEADBEEFU);
+
+    s_dwtCyccnt = 0xFFFFFFF0U;
+    {
+        HAL_DWT_BEGIN(start);
+        s_dwtCyccnt = 0x00000030U;
+        HAL_DWT_END(HAL_DWT_STAGE_GPIO, start);
+    }
+    TEST_CHECK(HAL_DWT_GetStats(HAL_DWT_STAGE_GPIO, &stats));
+    TEST_CHECK_EQ(stats.count, 1U);
+    TEST_CHECK_EQ(stats.minCycles, 0x40U);
+    TEST_CHECK_EQ(stats.maxCycles, 0x40U);
+}
+
+/**
+ * \brief Bin 0 ends at 31 cycles, each bin doubles and bin 15 starts at 2^19.
+ */
+static void test_bins(void)
+{
+    uint8_t bin;
+
+    TEST_CHECK_EQ(HAL_DWT_Bin(0U), 0U);
+    TEST_CHECK_EQ(HAL_DWT_Bin(31U), 0U);
+    TEST_CHECK_EQ(HAL_DWT_Bin(32U), 1U);
+    TEST_CHECK_EQ(HAL_DWT_Bin(63U), 1U);
+    TEST_CHECK_EQ(HAL_DWT_Bin(64U), 2U);
+    for (bin = 1U; bin < (HAL_DWT_HIST_BINS - 1U); bin++)
+    {
+        TEST_CHECK_EQ(HAL_DWT_Bin(1UL << (bin + 4U)), bin);
+        TEST_CHECK_EQ(HAL_DWT_Bin((1UL << (bin + 5U)) - 1U), bin);
+    }
+    TEST_CHECK_EQ(HAL_DWT_Bin((1UL << 19U) - 1U), 14U);
+    TEST_CHECK_EQ(HAL_DWT_Bin(1UL << 19U), 15U);
+    TEST_CHECK_EQ(HAL_DWT_Bin(1UL << 31U), 15U);
+    TEST_CHECK_EQ(HAL_DWT_Bin(0xFFFFFFFFU), 15U);
+}
+
+/**
+ * \brief Minimum, maximum, mean rounded down and histogram of a few records;
+ *        an empty stage reads as zeros and bad stages are rejected.
+ */
+static void test_statistics(void)
+{
+    HAL_DWT_Stats_t stats;
+
+    HAL_DWT_Init();
+    TEST_CHECK(HAL_DWT_GetStats(HAL_DWT_STAGE_ADC, &stats));
+    TEST_CHECK_EQ(stats.count, 0U);
+    TEST_CHECK_EQ(stats.minCycles, 0U);
+    TEST_CHECK_EQ(stats.maxCycles, 0U);
+    TEST_CHECK_EQ(stats.meanCycles, 0U);
+    TEST_CHECK_EQ(test_histogramSum(&stats), 0U);
+
+    HAL_DWT_Record(HAL_DWT_STAGE_ADC, 100U);
+    HAL_DWT_Record(HAL_DWT_STAGE_ADC, 31U);
+    HAL_DWT_Record(HAL_DWT_STAGE_ADC, 600000U);
+    HAL_DWT_Record(HAL_DWT_STAGE_ADC, 100U);
+    TEST_CHECK(HAL_DWT_GetStats(HAL_DWT_STAGE_ADC, &stats));
+    TEST_CHECK_EQ(stats.count, 4U);
+    TEST_CHECK_EQ(stats.minCycles, 31U);
+    TEST_CHECK_EQ(stats.maxCycles, 600000U);
+    TEST_CHECK_EQ(stats.meanCycles, 150057U);     /* 600231 / 4, rounded down */
+    TEST_CHECK_EQ(stats.histogram[0], 1U);
+    TEST_CHECK_EQ(stats.histogram[2], 2U);
+    TEST_CHECK_EQ(stats.histogram[15], 1U);
+    TEST_CHECK_EQ(test_histogramSum(&stats), 4U);
+
+    /* The total is 64-bit: no overflow past 2^32 cycles */
+    HAL_DWT_Record(HAL_DWT_STAGE_SPI, 0xFFFFFFFFU);
+    HAL_DWT_Record(HAL_DWT_STAGE_SPI, 0xFFFFFFFFU);
+    TEST_CHECK(HAL_DWT_GetStats(HAL_DWT_STAGE_SPI, &stats));
+    TEST_CHECK_EQ(stats.meanCycles, 0xFFFFFFFFU);
+
+    /* Other stages are untouched, out-of-range ones ignored */
+    TEST_CHECK(HAL_DWT_GetStats(HAL_DWT_STAGE_GPIO, &stats));
+    TEST_CHECK_EQ(stats.count, 0U);
+    HAL_DWT_Record(HAL_DWT_STAGE_COUNT, 100U);
+    TEST_CHECK(!HAL_DWT_GetStats(HAL_DWT_STAGE_COUNT, &stats));
+}
+
+/**
+ * \brief The histogram saturates at 0xFFFF while the count goes on.
+ */
+static void test_saturation(void)
+{
+    HAL_DWT_Stats_t stats;
+    uint32_t i;
+
+    HAL_DWT_Init();
+    for (i = 0U; i < 0x10004U; i++)
+    {
+        HAL_DWT_Record(HAL_DWT_STAGE_I2C_CONFIG, 40U);
+    }
+    HAL_DWT_Record(HAL_DWT_STAGE_I2C_CONFIG, 10U);
+    TEST_CHECK(HAL_DWT_GetStats(HAL_DWT_STAGE_I2C_CONFIG, &stats));
+    TEST_CHECK_EQ(stats.count, 0x10005U);
+    TEST_CHECK_EQ(stats.histogram[1], 0xFFFFU);
+    TEST_CHECK_EQ(stats.histogram[0], 1U);
+    TEST_CHECK_EQ(stats.minCycles, 10U);
+}
+
+/**
+ * \brief A record interleaving with the copy makes HAL_DWT_GetStats() copy
+ *        again, so the copy always matches its count.
+ */
+static void test_retry(void)
+{
+    HAL_DWT_Stats_t stats;
+    uint32_t barriers;
+
+    HAL_DWT_Init();
+    HAL_DWT_Record(TEST_STAGE, 1000U);
+
+    /* Without interleaving: one pass, two barriers */
+    s_barriers = 0U;
+    TEST_CHECK(HAL_DWT_GetStats(TEST_STAGE, &stats));
+    TEST_CHECK_EQ(s_barriers, 2U);
+
+    /* Records after the count is read and after the copy: one more pass */
+    s_injectedCycles = 5000U;
+    s_injections = 2U;
+    s_barriers = 0U;
+    TEST_CHECK(HAL_DWT_GetStats(TEST_STAGE, &stats));
+    barriers = s_barriers;
+    TEST_CHECK_EQ(s_injections, 0U);
+    TEST_CHECK(barriers >= 4U);
+    TEST_CHECK_EQ(stats.count, 3U);
+    TEST_CHECK_EQ(test_histogramSum(&stats), 3U);
+    TEST_CHECK_EQ(stats.minCycles, 1000U);
+    TEST_CHECK_EQ(stats.maxCycles, 5000U);
+    TEST_CHECK_EQ(stats.meanCycles, 3666U);      /* 11000 / 3, rounded down */
+
+    /* A record on every pass keeps retrying until a pass is left alone */
+    s_injectedCycles = 20U;
+    s_injections = 5U;
+    TEST_CHECK(HAL_DWT_GetStats(TEST_STAGE, &stats));
+    TEST_CHECK_EQ(s_injections, 0U);
+    TEST_CHECK_EQ(stats.count, 8U);
+    TEST_CHECK_EQ(test_histogramSum(&stats), 8U);
+    TEST_CHECK_EQ(stats.histogram[0], 5U);
+    TEST_CHECK_EQ(stats.minCycles, 20U);
+}
+
+/******************************************************************************/
+/*                   Definition of exported functions                         */
+/******************************************************************************/
+
+int main(void)
+{
+    test_counter();
+    test_bins();
+    test_statistics();
+    test_saturation();
+    test_retry();
+
+    return TEST_RESULT("test_dwt");
+}
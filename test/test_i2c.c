@@ -0,0 +1,360 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host test of the I2C slave transfers                                     */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Drives HAL_i2c.c through the stand-in of the LPI2C slave driver and of   */
+/*   its eDMA channel (mock/mock_lpi2c.c, mock/mock_platform.c), the test     */
+/*   playing the master. Checks the number of bytes of a master read given    */
+/*   to the stop handler, whether or not eDMA has loaded STDR ahead of the    */
+/*   master, the flush of that byte, the delivery of a master write, the      */
+/*   address reported to the start handler and the repeated START flag.      */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+/* The module is included to reach its transfer state */
+#include "../src/HAL/I2C/HAL_i2c.c"
+#include "mock/mock_platform.c"
+#include "mock/mock_lpi2c.c"
+#include "test_common.h"
+
+/******************************************************************************/
+/*                   Definition of local symbolic constants                 */
+/******************************************************************************/
+/** \brief Largest transmit block used by the tests, in bytes. */
+#define TEST_MAX_BLOCK  32U
+
+/******************************************************************************/
+/*                   Definition of local variables                            */
+/******************************************************************************/
+/** \brief Block handed out by the transmit handler. */
+static uint8_t s_txBlock[TEST_MAX_BLOCK];
+
+/** \brief Length of the block handed out by the transmit handler. */
+static uint32_t s_txLength = 0U;
+
+/** \brief Bytes delivered by the receive handler. */
+static uint8_t s_received[HAL_I2C_RX_BLOCK_LEN];
+static uint32_t s_receivedCount = 0U;
+
+/** \brief Calls of the start and stop handlers and their last arguments. */
+static uint32_t s_starts = 0U;
+static uint8_t s_startAddress = 0xFFU;
+static uint32_t s_stops = 0U;
+static uint32_t s_stopBytes = 0U;
+static bool s_stopRepeated = false;
+
+/******************************************************************************/
+/*                   Definition of local functions                            */
+/******************************************************************************/
+
+/** \brief Start handler: records the address index. */
+static void test_start(uint8_t address)
+{
+    s_starts++;
+    s_startAddress = address;
+}
+
+/** \brief Receive handler: records the byte. */
+static void test_rx(uint8_t data)
+{
+    if (s_receivedCount < HAL_I2C_RX_BLOCK_LEN)
+    {
+        s_received[s_receivedCount] = data;
+    }
+    s_receivedCount++;
+}
+
+/** \brief Transmit handler: hands out s_txBlock. */
+static uint32_t test_tx(const uint8_t **block)
+{
+    *block = s_txBlock;
+    return s_txLength;
+}
+
+/** \brief Stop handler: records the byte count and the repeated START flag. */
+static void test_stop(uint32_t bytesRead, bool repeatedStart)
+{
+    s_stops++;
+    s_stopBytes = bytesRead;
+    s_stopRepeated = repeatedStart;
+}
+
+/**
+ * \brief Resets the stand-ins and the handler records and initializes the
+ *        module.
+ */
+static void test_reset(void)
+{
+    static const HAL_I2C_Callbacks_t callbacks = { test_start, test_rx, test_tx, test_stop };
+    uint32_t i;
+
+    mock_lpi2cReset();
+    s_callbacks = (HAL_I2C_Callbacks_t){ NULL, NULL, NULL, NULL };
+    HAL_I2C_Init(&callbacks);
+    for (i = 0U; i < TEST_MAX_BLOCK; i++)
+    {
+        s_txBlock[i] = (uint8_t)(0xA0U + i);
+    }
+    s_txLength = 0U;
+    s_receivedCount = 0U;
+    s_starts = 0U;
+    s_startAddress = 0xFFU;
+    s_stops = 0U;
+    s_stopBytes = 0xFFFFFFFFU;
+    s_stopRepeated = true;
+}
+
+/**
+ * \brief Runs a master read of bytes from a block of length and returns the
+ *        count given to the stop handler.
+ */
+static uint32_t test_read(uint32_t length, uint32_t bytes, bool stdrLoaded)
+{
+    s_txLength = length;
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS, true);
+    mock_lpi2cMasterRead(bytes, stdrLoaded);
+    mock_lpi2c0.SCR &= ~LPI2C_SCR_RTF_MASK;
+    mock_lpi2cStop();
+    return s_stopBytes;
+}
+
+/**
+ * \brief A master read reports the bytes the master actually clocked out of
+ *        the block, whether the transfer ends with STDR loaded or empty, short
+ *        of the block, on its last byte or past it on the pad byte.
+ */
+static void test_readCount(void)
+{
+    static const uint32_t lengths[] = { 1U, 2U, 4U, TEST_MAX_BLOCK };
+    uint32_t expected;
+    uint32_t bytes;
+    uint32_t i;
+    uint8_t loaded;
+
+    test_reset();
+    for (i = 0U; i < (sizeof(lengths) / sizeof(lengths[0])); i++)
+    {
+        for (bytes = 0U; bytes <= ((2U * lengths[i]) + 1U); bytes++)
+        {
+            for (loaded = 0U; loaded < 2U; loaded++)
+            {
+                expected = (bytes < lengths[i]) ? bytes : lengths[i];
+                if (test_read(lengths[i], bytes, loaded != 0U) != expected)
+                {
+                    printf("block %u, %u bytes read, STDR %s:\n", lengths[i], bytes,
+                           (loaded != 0U) ? "loaded" : "empty");
+                }
+                TEST_CHECK_EQ(s_stopBytes, expected);
+                TEST_CHECK(!s_stopRepeated);
+                TEST_CHECK(mock_lpi2cTransmitting);
+                /* The byte left in STDR is flushed */
+                TEST_CHECK((mock_lpi2c0.SCR & LPI2C_SCR_RTF_MASK) != 0U);
+            }
+        }
+    }
+    TEST_CHECK_EQ(s_receivedCount, 0U);
+}
+
+/**
+ * \brief Past the block, eDMA is pointed at the pad byte, without an address
+ *        increment or adjustment.
+ */
+static void test_readPad(void)
+{
+    test_reset();
+    s_txLength = 4U;
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS, true);
+    TEST_CHECK(s_mockSlave->txBuff == s_txBlock);
+    TEST_CHECK_EQ(s_mockSlave->txSize, 4U);
+    mock_lpi2cMasterRead(3U, true);
+    TEST_CHECK_EQ(mock_edmaMajorLoops, 1U);
+    TEST_CHECK_EQ(mock_edmaSrcAddr, (uint32_t)(uintptr_t)&s_txPad);
+    TEST_CHECK_EQ(mock_edmaSrcOffset, 0);
+    TEST_CHECK_EQ(mock_edmaSrcLastAdjust, 0);
+    mock_lpi2cStop();
+    TEST_CHECK_EQ(s_stopBytes, 3U);
+}
+
+/**
+ * \brief A read with no block, or an empty one, sends the pad byte and
+ *        reports no byte read.
+ */
+static void test_readEmpty(void)
+{
+    test_reset();
+    s_txLength = 0U;
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS, true);
+    TEST_CHECK(s_mockSlave->txBuff == &s_txPad);
+    TEST_CHECK_EQ(s_mockSlave->txSize, 1U);
+    mock_lpi2cMasterRead(5U, true);
+    mock_lpi2cStop();
+    TEST_CHECK_EQ(s_stops, 1U);
+    TEST_CHECK_EQ(s_stopBytes, 0U);
+
+    s_callbacks.txCallback = NULL;
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS, true);
+    TEST_CHECK(s_mockSlave->txBuff == &s_txPad);
+    mock_lpi2cMasterRead(1U, false);
+    mock_lpi2cStop();
+    TEST_CHECK_EQ(s_stops, 2U);
+    TEST_CHECK_EQ(s_stopBytes, 0U);
+}
+
+/**
+ * \brief A master write delivers its bytes in order, up to the reception
+ *        block, and reports no byte read; it does not flush STDR and is not
+ *        turned into a transmit transfer by the buffer of the previous read.
+ */
+static void test_write(void)
+{
+    uint8_t data[HAL_I2C_RX_BLOCK_LEN + 3U];
+    uint32_t i;
+
+    for (i = 0U; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)(0x30U + i);
+    }
+
+    test_reset();
+    (void)test_read(4U, 2U, true);
+    mock_lpi2c0.SCR &= ~LPI2C_SCR_RTF_MASK;
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS, false);
+    TEST_CHECK(!mock_lpi2cTransmitting);
+    TEST_CHECK_EQ(s_mockSlave->txSize, 0U);
+    TEST_CHECK(s_mockSlave->rxBuff == s_rxBlock);
+    mock_lpi2cMasterWrite(data, 3U);
+    mock_lpi2cStop();
+    TEST_CHECK_EQ(s_receivedCount, 3U);
+    TEST_CHECK_EQ(s_received[0], 0x30U);
+    TEST_CHECK_EQ(s_received[2], 0x32U);
+    TEST_CHECK_EQ(s_stopBytes, 0U);
+    TEST_CHECK_EQ(mock_lpi2c0.SCR & LPI2C_SCR_RTF_MASK, 0U);
+
+    /* A write past the block fills it and drops the rest */
+    s_receivedCount = 0U;
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS, false);
+    mock_lpi2cMasterWrite(data, sizeof(data));
+    TEST_CHECK_EQ(mock_edmaDestAddr, (uint32_t)(uintptr_t)&s_rxDiscard);
+    TEST_CHECK_EQ(mock_edmaDestOffset, 0);
+    mock_lpi2cStop();
+    TEST_CHECK_EQ(s_receivedCount, HAL_I2C_RX_BLOCK_LEN);
+    TEST_CHECK_EQ(s_received[HAL_I2C_RX_BLOCK_LEN - 1U], data[HAL_I2C_RX_BLOCK_LEN - 1U]);
+
+    /* An empty write delivers nothing */
+    s_receivedCount = 0U;
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS, false);
+    mock_lpi2cStop();
+    TEST_CHECK_EQ(s_receivedCount, 0U);
+    TEST_CHECK_EQ(s_stops, 4U);
+}
+
+/**
+ * \brief The start handler gets the index of the address the master used.
+ */
+static void test_address(void)
+{
+    test_reset();
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS, false);
+    TEST_CHECK_EQ(s_starts, 1U);
+    TEST_CHECK_EQ(s_startAddress, HAL_I2C_ADDRESS_PRIMARY);
+    mock_lpi2cStop();
+
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS_SECONDARY, true);
+    TEST_CHECK_EQ(s_starts, 2U);
+    TEST_CHECK_EQ(s_startAddress, HAL_I2C_ADDRESS_SECONDARY);
+    mock_lpi2cStop();
+
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS_SECONDARY, false);
+    TEST_CHECK_EQ(s_startAddress, HAL_I2C_ADDRESS_SECONDARY);
+    mock_lpi2cStop();
+
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS, true);
+    TEST_CHECK_EQ(s_startAddress, HAL_I2C_ADDRESS_PRIMARY);
+    mock_lpi2cStop();
+    TEST_CHECK_EQ(s_stops, 4U);
+}
+
+/**
+ * \brief A transfer ended by a repeated START is flagged, the transfer ended
+ *        by the STOP after it is not, across the wrap of the driver count.
+ */
+static void test_repeatedStart(void)
+{
+    static const uint8_t regAddress = 0x05U;
+    uint32_t i;
+
+    test_reset();
+
+    /* Combined transfer: register address write, Sr, read */
+    s_txLength = 4U;
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS, false);
+    mock_lpi2cMasterWrite(&regAddress, 1U);
+    mock_lpi2cRepeatedStart();
+    TEST_CHECK_EQ(s_stops, 1U);
+    TEST_CHECK(s_stopRepeated);
+    TEST_CHECK_EQ(s_stopBytes, 0U);
+    TEST_CHECK_EQ(s_receivedCount, 1U);
+    TEST_CHECK_EQ(s_received[0], regAddress);
+
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS, true);
+    TEST_CHECK(mock_lpi2cTransmitting);
+    mock_lpi2cMasterRead(2U, true);
+    mock_lpi2cStop();
+    TEST_CHECK_EQ(s_stops, 2U);
+    TEST_CHECK(!s_stopRepeated);
+    TEST_CHECK_EQ(s_stopBytes, 2U);
+
+    /* Read, Sr, write: the flag does not depend on the direction */
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS, true);
+    mock_lpi2cMasterRead(1U, true);
+    mock_lpi2cRepeatedStart();
+    TEST_CHECK(s_stopRepeated);
+    TEST_CHECK_EQ(s_stopBytes, 1U);
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS, false);
+    mock_lpi2cStop();
+    TEST_CHECK(!s_stopRepeated);
+
+    /* The driver count is 8-bit and never reset while listening */
+    for (i = 0U; i < 300U; i++)
+    {
+        mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS, false);
+        mock_lpi2cRepeatedStart();
+        TEST_CHECK(s_stopRepeated);
+        mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS, true);
+        mock_lpi2cStop();
+        TEST_CHECK(!s_stopRepeated);
+    }
+    TEST_CHECK_EQ(s_slaveState.repeatedStarts, (uint8_t)(2U + 300U));
+
+    /* Several repeated STARTs in a row are each flagged */
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS, false);
+    mock_lpi2cRepeatedStart();
+    TEST_CHECK(s_stopRepeated);
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS_SECONDARY, true);
+    mock_lpi2cRepeatedStart();
+    TEST_CHECK(s_stopRepeated);
+    mock_lpi2cAddress(HAL_I2C_SLAVE_ADDRESS, false);
+    mock_lpi2cStop();
+    TEST_CHECK(!s_stopRepeated);
+}
+
+/******************************************************************************/
+/*                   Definition of exported functions                         */
+/******************************************************************************/
+
+int main(void)
+{
+    test_readCount();
+    test_readPad();
+    test_readEmpty();
+    test_write();
+    test_address();
+    test_repeatedStart();
+
+    return TEST_RESULT("test_i2c");
+}
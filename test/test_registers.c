@@ -0,0 +1,589 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host test of the register map IC protocol with PEC                      */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Plays IC transactions into registers.c the way the LPI2C slave HAL     */
+/*   does (start, bytes written, read block, end on STOP or repeated START)   */
+/*   and checks the SMBus PEC: the CRC-8 table, writes with a valid,          */
+/*   corrupted or missing PEC, and combined reads whose PEC covers the index  */
+/*   written before the repeated START. A stress test interleaves frame       */
+/*   publication with reads in flight and checks their coherence.             */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+/* The module is included to reach its PEC table and transaction state */
+#include "../src/CONF/registers.c"
+#include "test_common.h"
+
+/******************************************************************************/
+/*                   Definition of local symbolic constants                 */
+/******************************************************************************/
+/** \brief Address bytes of the register map and status bank, write and read. */
+#define TEST_MAP_WRITE    ((uint8_t)(REG_BANK_MAP_ADDRESS << 1U))
+#define TEST_MAP_READ     ((uint8_t)((REG_BANK_MAP_ADDRESS << 1U) | 1U))
+#define TEST_STATUS_READ  ((uint8_t)((REG_BANK_STATUS_ADDRESS << 1U) | 1U))
+
+/** \brief Largest frame built by the tests, in bytes. */
+#define TEST_FRAME_MAX    (READ_BLOCK_MAX + 8U)
+
+/** \brief Number of steps of the interleaving stress test. */
+#define TEST_STRESS_STEPS 200000U
+
+/******************************************************************************/
+/*                   Definition of local variables                            */
+/******************************************************************************/
+/** \brief State of the pseudo-random schedule of the stress test. */
+static uint32_t s_random = 1U;
+
+/******************************************************************************/
+/*                   Definition of local functions                            */
+/******************************************************************************/
+
+/**
+ * \brief Bitwise CRC-8 (polynomial 0x07, initial value 0), the reference.
+ *
+ * \param[in] crc    CRC of the bytes before data.
+ * \param[in] data   Bytes to add.
+ * \param[in] length Number of bytes.
+ *
+ * \return The updated CRC.
+ */
+static uint8_t test_crc8(uint8_t crc, const uint8_t *data, uint32_t length)
+{
+    uint32_t i;
+    uint8_t bit;
+
+    for (i = 0U; i < length; i++)
+    {
+        crc ^= data[i];
+        for (bit = 0U; bit < 8U; bit++)
+        {
+            crc = (uint8_t)(((uint32_t)crc << 1U) ^ (((crc & 0x80U) != 0U) ? 0x07U : 0x00U));
+        }
+    }
+    return crc;
+}
+
+/**
+ * \brief Plays a master write to the register map.
+ *
+ * \param[in] bytes         Bytes after the address byte.
+ * \param[in] length        Number of bytes.
+ * \param[in] repeatedStart true if the write ends with a repeated START.
+ *
+ * \return void.
+ */
+static void test_write(const uint8_t *bytes, uint32_t length, bool repeatedStart)
+{
+    uint32_t i;
+
+    registers_startTransaction(REG_BANK_MAP);
+    for (i = 0U; i < length; i++)
+    {
+        registers_processByte(bytes[i]);
+    }
+    registers_endTransaction(0U, repeatedStart);
+}
+
+/**
+ * \brief Plays a master write ending with the PEC of the frame, and STOP.
+ *
+ * \param[in] bytes  Bytes after the address byte, without the PEC.
+ * \param[in] length Number of bytes.
+ *
+ * \return void.
+ */
+static void test_writePec(const uint8_t *bytes, uint32_t length)
+{
+    uint8_t frame[TEST_FRAME_MAX];
+    uint8_t address = TEST_MAP_WRITE;
+
+    memcpy(frame, bytes, length);
+    frame[length] = test_crc8(test_crc8(0U, &address, 1U), bytes, length);
+    test_write(frame, length + 1U, false);
+}
+
+/**
+ * \brief Plays a master read, ending with STOP.
+ *
+ * \param[in]  bank      REG_BANK_MAP or REG_BANK_STATUS.
+ * \param[in]  bytesRead Number of bytes the master clocks out.
+ * \param[out] data      Bytes read (bytesRead bytes, 0 past the block).
+ *
+ * \return The length of the block served.
+ */
+static uint32_t test_read(uint8_t bank, uint32_t bytesRead, uint8_t *data)
+{
+    const uint8_t *block;
+    uint32_t length;
+    uint32_t i;
+
+    registers_startTransaction(bank);
+    length = registers_readBlock(&block);
+    for (i = 0U; i < bytesRead; i++)
+    {
+        data[i] = (i < length) ? block[i] : 0U;
+    }
+    registers_endTransaction((bytesRead < length) ? bytesRead : length, false);
+    return length;
+}
+
+/**
+ * \brief Initializes the map and enables PEC from the next transaction.
+ *
+ * \return void.
+ */
+static void test_enablePec(void)
+{
+    static const uint8_t enable[] = { REG_PEC, REG_PEC_ON };
+
+    registers_init();
+    test_write(enable, sizeof(enable), false);
+    TEST_CHECK_EQ(registers_read(REG_PEC), REG_PEC_ON);
+}
+
+/**
+ * \brief Plays a combined read: index write, repeated START, read of the
+ *        fixed length and its PEC, STOP; checks the PEC.
+ *
+ * \param[in]  index  Register the read starts at.
+ * \param[in]  length Expected data length.
+ * \param[out] data   Data bytes read.
+ *
+ * \return void.
+ */
+static void test_combinedRead(uint8_t index, uint32_t length, uint8_t *data)
+{
+    uint8_t frame[TEST_FRAME_MAX];
+    uint8_t read[TEST_FRAME_MAX];
+    uint32_t served;
+
+    test_write(&index, 1U, true);
+    served = test_read(REG_BANK_MAP, length + 1U, read);
+    TEST_CHECK_EQ(served, length + 1U);
+
+    frame[0] = TEST_MAP_WRITE;
+    frame[1] = index;
+    frame[2] = TEST_MAP_READ;
+    memcpy(&frame[3], read, length);
+    TEST_CHECK_EQ(read[length], test_crc8(0U, frame, length + 3U));
+    memcpy(data, read, length);
+}
+
+/**
+ * \brief The table is the CRC-8 of every byte value, and matches the check
+ *        value of the catalogue (CRC-8/SMBUS of "123456789" is 0xF4).
+ */
+static void test_table(void)
+{
+    static const uint8_t check[] = "123456789";
+    uint8_t crc = 0U;
+    uint8_t byte;
+    uint32_t i;
+
+    for (i = 0U; i < 256U; i++)
+    {
+        byte = (uint8_t)i;
+        TEST_CHECK_EQ(g_crc8Table[i], test_crc8(0U, &byte, 1U));
+    }
+    for (i = 0U; i < (sizeof(check) - 1U); i++)
+    {
+        crc = g_crc8Table[crc ^ check[i]];
+    }
+    TEST_CHECK_EQ(crc, 0xF4U);
+    TEST_CHECK_EQ(test_crc8(0U, check, sizeof(check) - 1U), 0xF4U);
+}
+
+/**
+ * \brief A write with the right PEC is committed; the same frame with any
+ *        single bit flipped, or without its PEC, is rejected and counted.
+ */
+static void test_writes(void)
+{
+    static const uint8_t pairs[] = { REG_SPICFG, 0x5AU, REG_ALARMCFG, 0x03U };
+    uint8_t frame[sizeof(pairs) + 1U];
+    uint8_t address = TEST_MAP_WRITE;
+    uint8_t errors = 0U;
+    uint32_t i;
+    uint8_t bit;
+
+    test_enablePec();
+    test_writePec(pairs, sizeof(pairs));
+    TEST_CHECK_EQ(registers_read(REG_SPICFG), 0x5AU);
+    TEST_CHECK_EQ(registers_read(REG_ALARMCFG), 0x03U);
+    TEST_CHECK_EQ(registers_read(REG_PEC_ERRORS), 0U);
+
+    memcpy(frame, pairs, sizeof(pairs));
+    frame[sizeof(pairs)] = test_crc8(test_crc8(0U, &address, 1U), pairs, sizeof(pairs));
+    for (i = 0U; i < sizeof(frame); i++)
+    {
+        for (bit = 0U; bit < 8U; bit++)
+        {
+            registers_write(REG_SPICFG, 0x11U);
+            registers_write(REG_ALARMCFG, 0x00U);
+            g_currentRegIndex = REG_GPIO;
+            frame[i] ^= (uint8_t)(1U << bit);
+            test_write(frame, sizeof(frame), false);
+            frame[i] ^= (uint8_t)(1U << bit);
+            errors++;
+
+            TEST_CHECK_EQ(registers_read(REG_SPICFG), 0x11U);
+            TEST_CHECK_EQ(registers_read(REG_ALARMCFG), 0x00U);
+            TEST_CHECK_EQ(g_currentRegIndex, REG_GPIO);
+            TEST_CHECK_EQ(registers_read(REG_PEC_ERRORS), errors);
+        }
+    }
+
+    /* Without its PEC, the last data byte is taken as the PEC and fails */
+    test_write(pairs, sizeof(pairs), false);
+    errors++;
+    TEST_CHECK_EQ(registers_read(REG_SPICFG), 0x11U);
+    TEST_CHECK_EQ(registers_read(REG_PEC_ERRORS), errors);
+
+    /* An index-only write with its PEC sets the index */
+    frame[0] = REG_ADC1;
+    test_writePec(frame, 1U);
+    TEST_CHECK_EQ(g_currentRegIndex, REG_ADC1);
+    TEST_CHECK_EQ(registers_read(REG_PEC_ERRORS), errors);
+}
+
+/**
+ * \brief Combined reads: the index write carries no PEC, the read has the
+ *        fixed SMBus length of its first register and one PEC that covers
+ *        the index, and the index advances by the data bytes only.
+ */
+static void test_combinedReads(void)
+{
+    uint8_t data[TEST_FRAME_MAX];
+    uint8_t index;
+
+    test_enablePec();
+    registers_updateADC(0U, 0x0ABCU, 12U);
+    registers_write(REG_SPICFG, 0xA5U);
+    registers_publish();
+
+    /* Read Byte */
+    test_combinedRead(REG_SPICFG, 1U, data);
+    TEST_CHECK_EQ(data[0], 0xA5U);
+    TEST_CHECK_EQ(g_currentRegIndex, REG_SPICFG + 1U);
+
+    /* Read Word from the high byte of a 16-bit value */
+    test_combinedRead(REG_ADC0_H, 2U, data);
+    TEST_CHECK_EQ(data[0], registers_read(REG_ADC0_H));
+    TEST_CHECK_EQ(data[1], registers_read(REG_ADC0_L));
+    TEST_CHECK_EQ(g_currentRegIndex, REG_ADC0_H + 2U);
+
+    /* Block read of the timing diagnostics window */
+    test_combinedRead(REG_PROF_WINDOW, REG_PROF_WINDOW_LEN, data);
+    TEST_CHECK_EQ(g_currentRegIndex, NUM_REGISTERS);
+
+    /* Every register can start a read and gets a valid PEC */
+    for (index = 0U; index < NUM_REGISTERS; index++)
+    {
+        if (index != REG_EDGE_FIFO)
+        {
+            test_combinedRead(index, registers_pecReadLength(index), data);
+        }
+    }
+    TEST_CHECK_EQ(registers_read(REG_PEC_ERRORS), 0U);
+}
+
+/**
+ * \brief Data written before a repeated START cannot be checked: it is
+ *        rejected and counted, but the index is used and the read PEC covers
+ *        every byte of the transfer.
+ */
+static void test_dataBeforeRepeatedStart(void)
+{
+    uint8_t write[] = { REG_SPICFG, 0x77U, REG_SPICFG };
+    uint8_t frame[8];
+    uint8_t read[2];
+
+    test_enablePec();
+    test_write(write, sizeof(write), true);
+    TEST_CHECK_EQ(registers_read(REG_SPICFG), 0U);
+    TEST_CHECK_EQ(registers_read(REG_PEC_ERRORS), 1U);
+    TEST_CHECK_EQ(g_currentRegIndex, REG_SPICFG);
+
+    (void)test_read(REG_BANK_MAP, sizeof(read), read);
+    frame[0] = TEST_MAP_WRITE;
+    memcpy(&frame[1], write, sizeof(write));
+    frame[4] = TEST_MAP_READ;
+    frame[5] = read[0];
+    TEST_CHECK_EQ(read[1], test_crc8(0U, frame, 6U));
+}
+
+/**
+ * \brief A read not preceded by a write, or from the status bank, has a PEC
+ *        from its own address byte; a corrupted byte on the bus is detected.
+ */
+static void test_plainReads(void)
+{
+    uint8_t frame[TEST_FRAME_MAX];
+    uint8_t read[TEST_FRAME_MAX];
+    uint32_t length;
+    uint8_t index = REG_SPICFG;
+
+    test_enablePec();
+    registers_write(REG_SPICFG, 0x3CU);
+    registers_publish();
+
+    /* Index set by a write ended by STOP, then a separate read */
+    test_writePec(&index, 1U);
+    length = test_read(REG_BANK_MAP, 2U, read);
+    TEST_CHECK_EQ(length, 2U);
+    TEST_CHECK_EQ(read[0], 0x3CU);
+    frame[0] = TEST_MAP_READ;
+    frame[1] = read[0];
+    TEST_CHECK_EQ(read[1], test_crc8(0U, frame, 2U));
+    frame[1] ^= 0x01U;
+    TEST_CHECK(read[1] != test_crc8(0U, frame, 2U));
+
+    /* Status bank: 8 bytes and a PEC, without the map index */
+    length = test_read(REG_BANK_STATUS, REG_STATUS_LEN + 1U, read);
+    TEST_CHECK_EQ(length, REG_STATUS_LEN + 1U);
+    frame[0] = TEST_STATUS_READ;
+    memcpy(&frame[1], read, REG_STATUS_LEN);
+    TEST_CHECK_EQ(read[REG_STATUS_LEN], test_crc8(0U, frame, REG_STATUS_LEN + 1U));
+    TEST_CHECK_EQ(g_currentRegIndex, REG_SPICFG + 1U);
+
+    /* Edge records: the whole edge block and a PEC */
+    registers_pushEdge(2U, true, 0x12345678U);
+    index = REG_EDGE_FIFO;
+    test_write(&index, 1U, true);
+    length = test_read(REG_BANK_MAP, sizeof(g_edgeBlock) + 1U, read);
+    TEST_CHECK_EQ(length, sizeof(g_edgeBlock) + 1U);
+    frame[0] = TEST_MAP_WRITE;
+    frame[1] = REG_EDGE_FIFO;
+    frame[2] = TEST_MAP_READ;
+    memcpy(&frame[3], read, sizeof(g_edgeBlock));
+    TEST_CHECK_EQ(read[sizeof(g_edgeBlock)], test_crc8(0U, frame, sizeof(g_edgeBlock) + 3U));
+    TEST_CHECK_EQ(registers_read(REG_EDGE_COUNT), 0U);
+}
+
+/**
+ * \brief Without PEC, a read serves the map up to its end and writes have no
+ *        trailing byte.
+ */
+static void test_pecOff(void)
+{
+    static const uint8_t pair[] = { REG_SPICFG, 0x42U };
+    uint8_t read[4];
+    uint8_t index = REG_SPICFG;
+
+    registers_init();
+    test_write(pair, sizeof(pair), false);
+    TEST_CHECK_EQ(registers_read(REG_SPICFG), 0x42U);
+    registers_publish();
+
+    test_write(&index, 1U, true);
+    TEST_CHECK_EQ(test_read(REG_BANK_MAP, sizeof(read), read), NUM_REGISTERS - REG_SPICFG);
+    TEST_CHECK_EQ(read[0], 0x42U);
+    TEST_CHECK_EQ(g_currentRegIndex, REG_SPICFG + sizeof(read));
+    TEST_CHECK_EQ(registers_read(REG_PEC_ERRORS), 0U);
+}
+
+/**
+ * \brief Next value of the pseudo-random schedule (LCG of Numerical Recipes).
+ *
+ * \return 16 pseudo-random bits.
+ */
+static uint32_t test_random(void)
+{
+    s_random = (s_random * 1664525U) + 1013904223U;
+    return s_random >> 16U;
+}
+
+/**
+ * \brief Runs one step of the acquisition cycle of the main loop.
+ *
+ * \details Frame n holds n in REG_ADC0_H/L (12 bits), its low byte in
+ *          REG_GPIO and n ^ 0xA5A in REG_ADC1_H/L, updated one call at a time
+ *          as the main loop does, and is then published.
+ *
+ * \param[in] step Step of the cycle, 0 to 3.
+ * \param[in] n    Sequence number of the frame being built.
+ *
+ * \return void.
+ */
+static void test_acquisitionStep(uint32_t step, uint16_t n)
+{
+    switch (step)
+    {
+        case 0U:
+            registers_updateGPIO((uint8_t)n);
+            break;
+        case 1U:
+            registers_updateADC(0U, (uint16_t)(n & 0xFFFU), 12U);
+            break;
+        case 2U:
+            registers_updateADC(1U, (uint16_t)((n ^ 0xA5AU) & 0xFFFU), 12U);
+            break;
+        default:
+            registers_publish();
+            break;
+    }
+}
+
+/**
+ * \brief Checks that the bytes of one read come from the frame published
+ *        last when the read started.
+ *
+ * \param[in] gpio   REG_GPIO read.
+ * \param[in] adc    REG_ADC0_H, REG_ADC0_L, REG_ADC1_H, REG_ADC1_L read.
+ * \param[in] n      Sequence number of the frame published last.
+ *
+ * \return true if the read is one coherent frame.
+ */
+static bool test_coherent(uint8_t gpio, const uint8_t *adc, uint16_t n)
+{
+    uint16_t adc0 = (uint16_t)(((uint16_t)adc[0] << 8U) | adc[1]);
+    uint16_t adc1 = (uint16_t)(((uint16_t)adc[2] << 8U) | adc[3]);
+
+    return (adc0 == (n & 0xFFFU)) && (gpio == (uint8_t)n) && (adc1 == ((n ^ 0xA5AU) & 0xFFFU));
+}
+
+/**
+ * \brief Publishes frames while reads are in flight: every read returns the
+ *        single frame published last when it started, whatever the main loop
+ *        does while its bytes are clocked out.
+ *
+ * \details A pseudo-random schedule interleaves the calls of the acquisition
+ *          cycle with the steps of reads of the map (index write, repeated
+ *          START, whole-map read) and of the status bank: the address match,
+ *          each byte clocked out and the STOP.
+ */
+static void test_interleaving(void)
+{
+    static const uint8_t index = REG_GPIO;
+    uint8_t data[NUM_REGISTERS];
+    const uint8_t *block = NULL;
+    uint32_t length = 0U;
+    uint32_t clocked = 0U;
+    uint32_t reads = 0U;
+    uint32_t incoherent = 0U;
+    uint32_t published = 0U;
+    uint32_t step = 0U;
+    uint32_t i;
+    uint16_t building = 1U;
+    uint16_t front = 0U;
+    uint16_t latched = 0U;
+    uint8_t bank = REG_BANK_MAP;
+    bool reading = false;
+
+    registers_init();
+    for (step = 0U; step < 4U; step++)
+    {
+        test_acquisitionStep(step, 0U);
+    }
+    step = 0U;
+    s_random = 1U;
+    for (i = 0U; i < TEST_STRESS_STEPS; i++)
+    {
+        if ((test_random() & 1U) == 0U)
+        {
+            /* Main loop */
+            test_acquisitionStep(step, building);
+            if (step == 3U)
+            {
+                front = building;
+                building++;
+                published++;
+            }
+            step = (step + 1U) & 3U;
+        }
+        else if (!reading)
+        {
+            /* Address match of a read */
+            bank = ((test_random() & 1U) == 0U) ? REG_BANK_MAP : REG_BANK_STATUS;
+            if (bank == REG_BANK_MAP)
+            {
+                test_write(&index, 1U, true);
+            }
+            registers_startTransaction(bank);
+            length = registers_readBlock(&block);
+            latched = front;
+            clocked = 0U;
+            reading = true;
+        }
+        else if (clocked < length)
+        {
+            /* One byte clocked out by the eDMA */
+            data[clocked] = block[clocked];
+            clocked++;
+        }
+        else
+        {
+            /* STOP */
+            registers_endTransaction(clocked, false);
+            if (bank == REG_BANK_MAP)
+            {
+                incoherent += test_coherent(data[REG_GPIO], &data[REG_ADC0_H], latched) ? 0U : 1U;
+                TEST_CHECK_EQ(data[REG_ADC0], (uint8_t)((latched & 0xFFFU) >> 4U));
+            }
+            else
+            {
+                incoherent += test_coherent(data[1], &data[4], latched) ? 0U : 1U;
+            }
+            reads++;
+            reading = false;
+        }
+    }
+
+    TEST_CHECK_EQ(incoherent, 0U);
+    TEST_CHECK(reads > 1000U);
+    TEST_CHECK(published > 1000U);
+}
+
+/**
+ * \brief One committed transaction is one configuration update, however many
+ *        configuration registers it writes.
+ */
+static void test_configUpdates(void)
+{
+    static const uint8_t chain[] = {
+        REG_SPICFG, 0x01U, REG_SPICFG1, 0x02U, REG_SPICFG1 + 1, 0x03U,
+        REG_SPICFG1 + 2, 0x04U, REG_SPICFG1 + 3, 0x05U, REG_SPICFG1 + 4, 0x06U,
+        REG_SPICFG1 + 5, 0x07U, REG_SPICFG7, 0x08U, REG_SPICHAIN, REG_SPICHAIN_MAX
+    };
+    static const uint8_t alias[] = { REG_SPICFG_SET, 0x80U };
+    static const uint8_t other[] = { REG_ALARMCFG, 0x01U };
+    uint8_t config[REG_SPICHAIN_MAX];
+
+    registers_init();
+    test_write(chain, sizeof(chain), false);
+    TEST_CHECK_EQ(registers_getConfigWrites(), 9U);
+    TEST_CHECK_EQ(registers_getConfigUpdates(), 1U);
+    TEST_CHECK_EQ(registers_getChainConfig(config), REG_SPICHAIN_MAX);
+    TEST_CHECK_EQ(config[7], 0x08U);
+
+    test_write(alias, sizeof(alias), false);
+    TEST_CHECK_EQ(registers_getConfigUpdates(), 2U);
+    test_write(other, sizeof(other), false);
+    TEST_CHECK_EQ(registers_getConfigUpdates(), 2U);
+    registers_setConfig(0x00U);
+    TEST_CHECK_EQ(registers_getConfigUpdates(), 3U);
+}
+
+/******************************************************************************/
+/*                   Definition of exported functions                         */
+/******************************************************************************/
+
+int main(void)
+{
+    test_table();
+    test_writes();
+    test_combinedReads();
+    test_dataBeforeRepeatedStart();
+    test_plainReads();
+    test_pecOff();
+    test_configUpdates();
+    test_interleaving();
+
+    return TEST_RESULT("test_registers");
+}
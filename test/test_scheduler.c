@@ -0,0 +1,284 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host test of the cooperative scheduler                                   */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Drives scheduler.c with a virtual clock: the main loop of the test       */
+/*   calls scheduler_tick() in place of the timer interrupt, and the task     */
+/*   bodies call it to consume execution time. Checks releases, phases,       */
+/*   priority order, lateness, deadline overruns, skipped releases and the    */
+/*   wrap-around of the tick counter.                                         */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+/* The module is included to reach its tick counter for the wrap-around test */
+#include "../src/SCH/scheduler.c"
+#include <string.h>
+#include "test_common.h"
+
+/******************************************************************************/
+/*                   Definition of local symbolic constants                 */
+/******************************************************************************/
+/** \brief Largest number of runs recorded per task. */
+#define TEST_MAX_RUNS 64U
+
+/******************************************************************************/
+/*                   Definition of local variables                            */
+/******************************************************************************/
+/** \brief Tick at which each run of task A and task B started. */
+static uint32_t s_startsA[TEST_MAX_RUNS];
+static uint32_t s_startsB[TEST_MAX_RUNS];
+
+/** \brief Number of runs of task A and task B. */
+static uint32_t s_runsA = 0U;
+static uint32_t s_runsB = 0U;
+
+/** \brief Ticks consumed by each run of task A and task B. */
+static uint32_t s_costA = 0U;
+static uint32_t s_costB = 0U;
+
+/** \brief Task that ran last ('A' or 'B'). */
+static char s_lastRun = ' ';
+
+/******************************************************************************/
+/*                   Definition of local functions                            */
+/******************************************************************************/
+
+/**
+ * \brief Consumes execution time on the virtual clock.
+ *
+ * \param[in] ticks Number of ticks the task body takes.
+ *
+ * \return void.
+ */
+static void test_consume(uint32_t ticks)
+{
+    uint32_t i;
+
+    for (i = 0U; i < ticks; i++)
+    {
+        scheduler_tick();
+    }
+}
+
+/** \brief Body of task A: records its start and consumes s_costA ticks. */
+static void test_taskA(void)
+{
+    if (s_runsA < TEST_MAX_RUNS)
+    {
+        s_startsA[s_runsA] = scheduler_getTicks();
+    }
+    s_runsA++;
+    s_lastRun = 'A';
+    test_consume(s_costA);
+}
+
+/** \brief Body of task B: records its start and consumes s_costB ticks. */
+static void test_taskB(void)
+{
+    if (s_runsB < TEST_MAX_RUNS)
+    {
+        s_startsB[s_runsB] = scheduler_getTicks();
+    }
+    s_runsB++;
+    s_lastRun = 'B';
+    test_consume(s_costB);
+}
+
+/**
+ * \brief Resets the virtual clock and the run records.
+ *
+ * \param[in] now Tick to restart the virtual clock from.
+ *
+ * \return void.
+ */
+static void test_reset(uint32_t now)
+{
+    g_ticks = now;
+    s_runsA = 0U;
+    s_runsB = 0U;
+    s_costA = 0U;
+    s_costB = 0U;
+    memset(s_startsA, 0, sizeof(s_startsA));
+    memset(s_startsB, 0, sizeof(s_startsB));
+}
+
+/**
+ * \brief Runs the main loop until the virtual clock reaches a tick.
+ *
+ * \details One timer tick per loop pass when no task is due, as when the core
+ *          sleeps until the next interrupt.
+ *
+ * \param[in] end Tick at which to stop.
+ *
+ * \return void.
+ */
+static void test_runUntil(uint32_t end)
+{
+    while (!scheduler_reached(scheduler_getTicks(), end))
+    {
+        if (!scheduler_runPending())
+        {
+            scheduler_tick();
+        }
+    }
+}
+
+/**
+ * \brief Releases follow the period and phase, without drift.
+ */
+static void test_periods(void)
+{
+    scheduler_task_t tasks[2] = {
+        { test_taskA, 10U, 0U, 10U, 0U, 0U, 0U },
+        { test_taskB,  5U, 2U,  5U, 0U, 0U, 0U }
+    };
+    uint32_t i;
+
+    test_reset(0U);
+    s_costA = 1U;
+    s_costB = 1U;
+    scheduler_init(tasks, 2U);
+    test_runUntil(100U);
+
+    TEST_CHECK_EQ(s_runsA, 10U);
+    TEST_CHECK_EQ(s_runsB, 20U);
+    for (i = 0U; i < s_runsA; i++)
+    {
+        TEST_CHECK_EQ(s_startsA[i], 10U * i);
+    }
+    for (i = 0U; i < s_runsB; i++)
+    {
+        TEST_CHECK_EQ(s_startsB[i], 2U + (5U * i));
+    }
+    TEST_CHECK_EQ(scheduler_getOverruns(), 0U);
+}
+
+/**
+ * \brief Tasks due at the same tick run in table order, and the lower
+ *        priority one records the delay as lateness.
+ */
+static void test_priority(void)
+{
+    scheduler_task_t tasks[2] = {
+        { test_taskA, 20U, 0U, 20U, 0U, 0U, 0U },
+        { test_taskB, 20U, 0U, 20U, 0U, 0U, 0U }
+    };
+
+    test_reset(0U);
+    s_costA = 3U;
+    scheduler_init(tasks, 2U);
+    TEST_CHECK(scheduler_hasPending());
+    TEST_CHECK(scheduler_runPending());
+
+    TEST_CHECK_EQ(s_runsA, 1U);
+    TEST_CHECK_EQ(s_runsB, 1U);
+    TEST_CHECK_EQ(s_startsA[0], 0U);
+    TEST_CHECK_EQ(s_startsB[0], 3U);
+    TEST_CHECK(s_lastRun == 'B');
+    TEST_CHECK_EQ(tasks[0].maxLateness, 0U);
+    TEST_CHECK_EQ(tasks[1].maxLateness, 3U);
+    TEST_CHECK(!scheduler_hasPending());
+    TEST_CHECK(!scheduler_runPending());
+}
+
+/**
+ * \brief A job completing after its deadline counts one overrun; the next
+ *        release keeps the original phase.
+ */
+static void test_deadline(void)
+{
+    scheduler_task_t tasks[1] = {
+        { test_taskA, 10U, 0U, 4U, 0U, 0U, 0U }
+    };
+
+    test_reset(0U);
+    s_costA = 6U;
+    scheduler_init(tasks, 1U);
+    TEST_CHECK(scheduler_runPending());
+    TEST_CHECK_EQ(tasks[0].overruns, 1U);
+    TEST_CHECK_EQ(tasks[0].nextRelease, 10U);
+
+    s_costA = 4U;
+    test_runUntil(30U);
+    TEST_CHECK_EQ(s_runsA, 3U);
+    TEST_CHECK_EQ(s_startsA[1], 10U);
+    TEST_CHECK_EQ(s_startsA[2], 20U);
+    TEST_CHECK_EQ(tasks[0].overruns, 1U);
+    TEST_CHECK_EQ(scheduler_getOverruns(), 1U);
+}
+
+/**
+ * \brief A job running past whole periods skips the releases a full period
+ *        late, each counted as an overrun, runs the last one late and resumes
+ *        on its phase.
+ */
+static void test_skipped(void)
+{
+    scheduler_task_t tasks[1] = {
+        { test_taskA, 10U, 3U, 10U, 0U, 0U, 0U }
+    };
+
+    test_reset(0U);
+    s_costA = 25U;
+    scheduler_init(tasks, 1U);
+    test_runUntil(4U);
+
+    /* Released at 3, done at 28: late, 13 is skipped, 23 runs late */
+    TEST_CHECK_EQ(s_runsA, 1U);
+    TEST_CHECK_EQ(scheduler_getTicks(), 28U);
+    TEST_CHECK_EQ(tasks[0].overruns, 2U);
+    TEST_CHECK_EQ(tasks[0].nextRelease, 23U);
+
+    s_costA = 1U;
+    test_runUntil(60U);
+    TEST_CHECK_EQ(s_runsA, 5U);
+    TEST_CHECK_EQ(s_startsA[1], 28U);
+    TEST_CHECK_EQ(s_startsA[2], 33U);
+    TEST_CHECK_EQ(s_startsA[4], 53U);
+    TEST_CHECK_EQ(tasks[0].maxLateness, 5U);
+    TEST_CHECK_EQ(scheduler_getOverruns(), 2U);
+}
+
+/**
+ * \brief Releases and lateness stay correct across the 2^32 tick wrap-around.
+ */
+static void test_wrap(void)
+{
+    scheduler_task_t tasks[1] = {
+        { test_taskA, 10U, 0U, 10U, 0U, 0U, 0U }
+    };
+    uint32_t i;
+
+    test_reset(0xFFFFFFF0U);
+    s_costA = 1U;
+    scheduler_init(tasks, 1U);
+    test_runUntil(0x00000020U);
+
+    TEST_CHECK_EQ(s_runsA, 5U);
+    for (i = 0U; i < s_runsA; i++)
+    {
+        TEST_CHECK_EQ(s_startsA[i], (uint32_t)(0xFFFFFFF0U + (10U * i)));
+    }
+    TEST_CHECK_EQ(tasks[0].maxLateness, 0U);
+    TEST_CHECK_EQ(scheduler_getOverruns(), 0U);
+}
+
+/******************************************************************************/
+/*                   Definition of exported functions                         */
+/******************************************************************************/
+
+int main(void)
+{
+    test_periods();
+    test_priority();
+    test_deadline();
+    test_skipped();
+    test_wrap();
+
+    return TEST_RESULT("test_scheduler");
+}
@@ -0,0 +1,245 @@
+/******************************************************************************/
+/*                                                                            */
+/*   Host test of the asynchronous SPI transfers                              */
+/*                                                                            */
+/*   Author:  Pablo Prez Fernndez                                           */
+/*   Date:    30/03/2025                                                      */
+/*                                                                            */
+/*   Drives HAL_SPI_TransmitAsync() and HAL_SPI_WriteChainAsync() against     */
+/*   the stand-in of the LPSPI master driver (mock/mock_lpspi.c), the test    */
+/*   ending each transfer in place of the LPSPI interrupt. Checks the         */
+/*   argument checks, the reversed byte order of the daisy chain, the         */
+/*   rejection of a transfer while one is in progress and the completion      */
+/*   callback, consumed exactly once with the result of the transfer.         */
+/*                                                                            */
+/*   This software is provided free of charge.                                */
+/*                                                                            */
+/******************************************************************************/
+
+/* The module is included to reach its private transfer buffer */
+#include "../src/HAL/SPI/HAL_spi.c"
+#include "mock/mock_platform.c"
+#include "mock/mock_lpspi.c"
+#include "test_common.h"
+
+/******************************************************************************/
+/*                   Definition of local variables                            */
+/******************************************************************************/
+/** \brief Calls of each completion callback and the last result passed. */
+static uint32_t s_callsA = 0U;
+static uint32_t s_callsB = 0U;
+static bool s_successA = false;
+static bool s_successB = false;
+
+/******************************************************************************/
+/*                   Definition of local functions                            */
+/******************************************************************************/
+
+/** \brief Completion callback A: counts the calls and records the result. */
+static void test_doneA(bool success)
+{
+    s_callsA++;
+    s_successA = success;
+}
+
+/** \brief Completion callback B: counts the calls and records the result. */
+static void test_doneB(bool success)
+{
+    s_callsB++;
+    s_successB = success;
+}
+
+/**
+ * \brief Resets the driver stand-in and the callback records.
+ */
+static void test_reset(void)
+{
+    mock_lpspiReset();
+    HAL_SPI_Init();
+    s_asyncCallback = NULL;
+    s_callsA = 0U;
+    s_callsB = 0U;
+    s_successA = false;
+    s_successB = false;
+}
+
+/**
+ * \brief Invalid arguments are rejected without starting a transfer.
+ */
+static void test_arguments(void)
+{
+    uint8_t data[HAL_SPI_ASYNC_MAX_LEN + 1U] = { 0U };
+
+    test_reset();
+    TEST_CHECK(!HAL_SPI_TransmitAsync(NULL, 1U, test_doneA));
+    TEST_CHECK(!HAL_SPI_TransmitAsync(data, 0U, test_doneA));
+    TEST_CHECK(!HAL_SPI_TransmitAsync(data, HAL_SPI_ASYNC_MAX_LEN + 1U, test_doneA));
+    TEST_CHECK(!HAL_SPI_WriteChainAsync(NULL, 1U, test_doneA));
+    TEST_CHECK(!HAL_SPI_WriteChainAsync(data, 0U, test_doneA));
+    TEST_CHECK(!HAL_SPI_WriteChainAsync(data, HAL_SPI_CHAIN_MAX_DEVICES + 1U, test_doneA));
+    TEST_CHECK_EQ(mock_lpspiTransfers, 0U);
+    TEST_CHECK(s_asyncCallback == NULL);
+
+    TEST_CHECK(HAL_SPI_TransmitAsync(data, HAL_SPI_ASYNC_MAX_LEN, NULL));
+    TEST_CHECK_EQ(mock_lpspiSentLength, HAL_SPI_ASYNC_MAX_LEN);
+    mock_lpspiEndTransfer(true);
+    TEST_CHECK_EQ(s_callsA, 0U);
+}
+
+/**
+ * \brief The transfer is sent from the private buffer, so the caller may
+ *        reuse its own as soon as the function returns.
+ */
+static void test_privateCopy(void)
+{
+    uint8_t data[3] = { 0xA1U, 0xB2U, 0xC3U };
+
+    test_reset();
+    TEST_CHECK(HAL_SPI_TransmitAsync(data, 3U, test_doneA));
+    data[0] = 0U;
+    TEST_CHECK(mock_lpspiSendBuffer == s_asyncTxBuffer);
+    TEST_CHECK_EQ(mock_lpspiSentLength, 3U);
+    TEST_CHECK_EQ(s_asyncTxBuffer[0], 0xA1U);
+    TEST_CHECK_EQ(s_asyncTxBuffer[1], 0xB2U);
+    TEST_CHECK_EQ(s_asyncTxBuffer[2], 0xC3U);
+    mock_lpspiEndTransfer(true);
+}
+
+/**
+ * \brief The configuration of the last device is shifted out first.
+ */
+static void test_chainOrder(void)
+{
+    uint8_t config[HAL_SPI_CHAIN_MAX_DEVICES];
+    uint8_t device;
+
+    for (device = 0U; device < HAL_SPI_CHAIN_MAX_DEVICES; device++)
+    {
+        config[device] = (uint8_t)(0x10U + device);
+    }
+
+    test_reset();
+    TEST_CHECK(HAL_SPI_WriteChainAsync(config, 1U, test_doneA));
+    TEST_CHECK_EQ(mock_lpspiSentLength, 1U);
+    TEST_CHECK_EQ(mock_lpspiSent[0], 0x10U);
+    mock_lpspiEndTransfer(true);
+
+    TEST_CHECK(HAL_SPI_WriteChainAsync(config, 3U, test_doneA));
+    TEST_CHECK_EQ(mock_lpspiSentLength, 3U);
+    TEST_CHECK_EQ(mock_lpspiSent[0], 0x12U);
+    TEST_CHECK_EQ(mock_lpspiSent[1], 0x11U);
+    TEST_CHECK_EQ(mock_lpspiSent[2], 0x10U);
+    mock_lpspiEndTransfer(true);
+
+    TEST_CHECK(HAL_SPI_WriteChainAsync(config, HAL_SPI_CHAIN_MAX_DEVICES, test_doneA));
+    TEST_CHECK_EQ(mock_lpspiSentLength, HAL_SPI_CHAIN_MAX_DEVICES);
+    for (device = 0U; device < HAL_SPI_CHAIN_MAX_DEVICES; device++)
+    {
+        TEST_CHECK_EQ(mock_lpspiSent[device], config[HAL_SPI_CHAIN_MAX_DEVICES - 1U - device]);
+    }
+    mock_lpspiEndTransfer(true);
+    TEST_CHECK_EQ(mock_lpspiTransfers, 3U);
+    TEST_CHECK_EQ(s_callsA, 3U);
+}
+
+/**
+ * \brief A transfer requested while another is in progress is rejected and
+ *        leaves the one in progress, and its callback, untouched.
+ */
+static void test_busy(void)
+{
+    uint8_t first[2] = { 0x01U, 0x02U };
+    uint8_t second[2] = { 0x03U, 0x04U };
+
+    test_reset();
+    TEST_CHECK(!HAL_SPI_IsBusy());
+    TEST_CHECK(HAL_SPI_WriteChainAsync(first, 2U, test_doneA));
+    TEST_CHECK(HAL_SPI_IsBusy());
+
+    TEST_CHECK(!HAL_SPI_TransmitAsync(second, 2U, test_doneB));
+    TEST_CHECK(!HAL_SPI_WriteChainAsync(second, 2U, test_doneB));
+    TEST_CHECK(!HAL_SPI_Transfer(second, NULL, 2U));
+    TEST_CHECK_EQ(mock_lpspiTransfers, 1U);
+    TEST_CHECK_EQ(s_asyncTxBuffer[0], 0x02U);
+    TEST_CHECK_EQ(s_asyncTxBuffer[1], 0x01U);
+    TEST_CHECK(s_asyncCallback == test_doneA);
+
+    mock_lpspiEndTransfer(true);
+    TEST_CHECK(!HAL_SPI_IsBusy());
+    TEST_CHECK_EQ(s_callsA, 1U);
+    TEST_CHECK_EQ(s_callsB, 0U);
+
+    /* Once the bus is free the next request is accepted */
+    TEST_CHECK(HAL_SPI_WriteChainAsync(second, 2U, test_doneB));
+    mock_lpspiEndTransfer(true);
+    TEST_CHECK_EQ(s_callsB, 1U);
+}
+
+/**
+ * \brief The callback is consumed by the end of its transfer: called once,
+ *        with the result of the transfer, and never by a later transfer.
+ */
+static void test_callback(void)
+{
+    uint8_t data[2] = { 0x55U, 0xAAU };
+
+    test_reset();
+    TEST_CHECK(HAL_SPI_TransmitAsync(data, 2U, test_doneA));
+    TEST_CHECK_EQ(s_callsA, 0U);
+    mock_lpspiEndTransfer(true);
+    TEST_CHECK_EQ(s_callsA, 1U);
+    TEST_CHECK(s_successA);
+    TEST_CHECK(s_asyncCallback == NULL);
+
+    /* A blocking transfer ends through the same driver callback */
+    HAL_SPI_Transmit(0x5AU);
+    TEST_CHECK_EQ(mock_lpspiSent[0], 0x5AU);
+    TEST_CHECK_EQ(s_callsA, 1U);
+
+    /* A failed transfer reports false, once */
+    TEST_CHECK(HAL_SPI_WriteChainAsync(data, 2U, test_doneB));
+    mock_lpspiEndTransfer(false);
+    TEST_CHECK_EQ(s_callsB, 1U);
+    TEST_CHECK(!s_successB);
+    mock_lpspiEndTransfer(false);
+    TEST_CHECK_EQ(s_callsB, 1U);
+    TEST_CHECK_EQ(s_callsA, 1U);
+}
+
+/**
+ * \brief A transfer the driver refuses to start returns false and drops its
+ *        callback, which the next transfer does not call.
+ */
+static void test_startFailure(void)
+{
+    uint8_t data[2] = { 0x0FU, 0xF0U };
+
+    test_reset();
+    mock_lpspiStartStatus = STATUS_ERROR;
+    TEST_CHECK(!HAL_SPI_WriteChainAsync(data, 2U, test_doneA));
+    TEST_CHECK(s_asyncCallback == NULL);
+    TEST_CHECK(!HAL_SPI_IsBusy());
+
+    mock_lpspiStartStatus = STATUS_SUCCESS;
+    TEST_CHECK(HAL_SPI_TransmitAsync(data, 2U, test_doneB));
+    mock_lpspiEndTransfer(true);
+    TEST_CHECK_EQ(s_callsA, 0U);
+    TEST_CHECK_EQ(s_callsB, 1U);
+    TEST_CHECK(s_successB);
+}
+
+/******************************************************************************/
+/*                   Definition of exported functions                         */
+/******************************************************************************/
+
+int main(void)
+{
+    test_arguments();
+    test_privateCopy();
+    test_chainOrder();
+    test_busy();
+    test_callback();
+    test_startFailure();
+
+    return TEST_RESULT("test_spi");
+}